@@ -0,0 +1,121 @@
+/*
+ * PolynomialSplineEvaluationBenchmark.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Compares the inner product of the coefficients with the time vector, Horner's and Estrin's scheme
+ *  for evaluating the position, velocity and acceleration of polynomial splines of order 1 to 7.
+ */
+
+// curves
+#include "curves/polynomial_splines_traits.hpp"
+
+// stl
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr unsigned int kNumSplines = 1024;
+constexpr unsigned int kNumRepetitions = 2000;
+
+template<typename Rep>
+using CoefficientList = std::vector<typename Rep::SplineCoefficients>;
+
+template<typename Rep, unsigned int k>
+struct InnerProduct {
+  static double evaluate(const typename Rep::SplineCoefficients& coefficients, double tk) {
+    const typename Rep::TimeVectorType timeVector = Rep::template dktau<k>(tk);
+    return std::inner_product(coefficients.begin(), coefficients.end(), timeVector.begin(), 0.0);
+  }
+};
+
+template<typename Rep, unsigned int k>
+struct Horner {
+  static double evaluate(const typename Rep::SplineCoefficients& coefficients, double tk) {
+    return Rep::template evaluateHorner<k>(coefficients, tk);
+  }
+};
+
+template<typename Rep, unsigned int k>
+struct Estrin {
+  static double evaluate(const typename Rep::SplineCoefficients& coefficients, double tk) {
+    return Rep::template evaluateEstrin<k>(coefficients, tk);
+  }
+};
+
+/*! Nanoseconds per evaluation.
+ *
+ * Independent evaluations measure the throughput. With chained evaluations each time depends on the previous
+ * value, which measures the latency of one evaluation.
+ */
+template<typename Kernel, typename Rep>
+double run(const CoefficientList<Rep>& coefficients, const std::vector<double>& times, bool chained,
+           double* checksum) {
+  double sum = 0.0;
+  double value = 0.0;
+  const double dependency = chained ? 1e-300 : 0.0;
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned int repetition = 0; repetition < kNumRepetitions; ++repetition) {
+    for (unsigned int i = 0; i < kNumSplines; ++i) {
+      value = Kernel::evaluate(coefficients[i], times[i] + (chained ? dependency * value : 0.0));
+      sum += value;
+    }
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  *checksum = sum;
+  return std::chrono::duration<double, std::nano>(stop - start).count() / (double(kNumRepetitions) * kNumSplines);
+}
+
+template<int splineOrder, unsigned int k>
+void benchmarkDerivative(const char* name, bool chained) {
+  using Rep = curves::spline_traits::spline_rep<double, splineOrder>;
+  std::default_random_engine randomEngine(splineOrder);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  CoefficientList<Rep> coefficients(kNumSplines);
+  std::vector<double> times(kNumSplines);
+  for (unsigned int i = 0; i < kNumSplines; ++i) {
+    for (auto& coefficient : coefficients[i]) {
+      coefficient = distribution(randomEngine);
+    }
+    times[i] = 0.5 * (distribution(randomEngine) + 1.0);
+  }
+
+  double innerProductSum, hornerSum, estrinSum;
+  const double innerProduct = run<InnerProduct<Rep, k>, Rep>(coefficients, times, chained, &innerProductSum);
+  const double horner = run<Horner<Rep, k>, Rep>(coefficients, times, chained, &hornerSum);
+  const double estrin = run<Estrin<Rep, k>, Rep>(coefficients, times, chained, &estrinSum);
+  std::printf("%5d %-13s %14.2f %8.2f %8.2f   (checksums %.6g %.6g %.6g)\n", splineOrder, name,
+              innerProduct, horner, estrin, innerProductSum, hornerSum, estrinSum);
+}
+
+template<int splineOrder>
+void benchmarkOrder(bool chained) {
+  benchmarkDerivative<splineOrder, 0>("position", chained);
+  benchmarkDerivative<splineOrder, 1>("velocity", chained);
+  benchmarkDerivative<splineOrder, 2>("acceleration", chained);
+}
+
+void benchmarkOrders(bool chained) {
+  std::printf("%s evaluations\n", chained ? "Chained" : "Independent");
+  std::printf("order derivative    inner product   Horner   Estrin   [ns per evaluation]\n");
+  benchmarkOrder<1>(chained);
+  benchmarkOrder<2>(chained);
+  benchmarkOrder<3>(chained);
+  benchmarkOrder<4>(chained);
+  benchmarkOrder<5>(chained);
+  benchmarkOrder<6>(chained);
+  benchmarkOrder<7>(chained);
+}
+
+} // namespace
+
+int main() {
+  benchmarkOrders(false);
+  benchmarkOrders(true);
+  return 0;
+}
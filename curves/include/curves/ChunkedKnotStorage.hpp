@@ -0,0 +1,145 @@
+/*
+ * ChunkedKnotStorage.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include "curves/Curve.hpp"
+
+namespace curves {
+
+/// \brief Append-only knot storage with one writer and wait-free readers.
+///
+/// Knots live in fixed-size chunks that are never moved or modified once published, so
+/// readers only need to load the published size (acquire) and may then access all knots
+/// below it without locking. The chunks are indexed through a two-level table that is
+/// grown in place, which bounds the capacity to kMaxCapacity = kMaxTables * kTableSize *
+/// kChunkSize knots (2^24). A smaller capacity can be passed to the constructor. A full
+/// storage rejects further knots, push_back() must only be called from a single writer thread.
+template <typename Coefficient_>
+class ChunkedKnotStorage {
+ public:
+  typedef Coefficient_ Coefficient;
+
+  struct Knot {
+    Time time;
+    Coefficient coefficient;
+  };
+
+  static constexpr std::size_t kChunkBits = 8;
+  static constexpr std::size_t kChunkSize = std::size_t(1) << kChunkBits;
+  static constexpr std::size_t kTableBits = 8;
+  static constexpr std::size_t kTableSize = std::size_t(1) << kTableBits;
+  static constexpr std::size_t kMaxTables = 256;
+  static constexpr std::size_t kMaxCapacity = kMaxTables * kTableSize * kChunkSize;
+
+  /// The capacity is clamped to kMaxCapacity.
+  explicit ChunkedKnotStorage(std::size_t capacity = kMaxCapacity)
+      : capacity_(capacity < kMaxCapacity ? capacity : std::size_t(kMaxCapacity)),
+        size_(0) {
+    for (std::size_t i = 0; i < kMaxTables; ++i) {
+      tables_[i].store(NULL, std::memory_order_relaxed);
+    }
+  }
+
+  ~ChunkedKnotStorage() {
+    for (std::size_t i = 0; i < kMaxTables; ++i) {
+      Table* table = tables_[i].load(std::memory_order_relaxed);
+      if (table == NULL) {
+        break;
+      }
+      for (std::size_t j = 0; j < kTableSize; ++j) {
+        delete table->chunks[j].load(std::memory_order_relaxed);
+      }
+      delete table;
+    }
+  }
+
+  ChunkedKnotStorage(const ChunkedKnotStorage&) = delete;
+  ChunkedKnotStorage& operator=(const ChunkedKnotStorage&) = delete;
+
+  /// Number of published knots. All knots below this index can be read without locking.
+  std::size_t size() const {
+    return size_.load(std::memory_order_acquire);
+  }
+
+  std::size_t capacity() const {
+    return capacity_;
+  }
+
+  /// Access a published knot, i must be smaller than a previously loaded size().
+  const Knot& operator[](std::size_t i) const {
+    const Table* table = tables_[i >> (kChunkBits + kTableBits)].load(std::memory_order_acquire);
+    const Chunk* chunk = table->chunks[(i >> kChunkBits) & (kTableSize - 1)].load(std::memory_order_acquire);
+    return chunk->knots[i & (kChunkSize - 1)];
+  }
+
+  /// Index of the first of the first n knots with a time larger than time.
+  std::size_t upperBound(Time time, std::size_t n) const {
+    std::size_t first = 0;
+    std::size_t count = n;
+    while (count > 0) {
+      const std::size_t step = count / 2;
+      const std::size_t middle = first + step;
+      if (!(time < (*this)[middle].time)) {
+        first = middle + 1;
+        count -= step + 1;
+      } else {
+        count = step;
+      }
+    }
+    return first;
+  }
+
+  /// Append and publish a knot (writer thread only). Returns false if the storage is full.
+  bool push_back(Time time, const Coefficient& coefficient) {
+    const std::size_t i = size_.load(std::memory_order_relaxed);
+    if (i >= capacity_) {
+      return false;
+    }
+    const std::size_t tableIndex = i >> (kChunkBits + kTableBits);
+    Table* table = tables_[tableIndex].load(std::memory_order_relaxed);
+    if (table == NULL) {
+      table = new Table();
+      for (std::size_t j = 0; j < kTableSize; ++j) {
+        table->chunks[j].store(NULL, std::memory_order_relaxed);
+      }
+      tables_[tableIndex].store(table, std::memory_order_release);
+    }
+    const std::size_t chunkIndex = (i >> kChunkBits) & (kTableSize - 1);
+    Chunk* chunk = table->chunks[chunkIndex].load(std::memory_order_relaxed);
+    if (chunk == NULL) {
+      chunk = new Chunk();
+      table->chunks[chunkIndex].store(chunk, std::memory_order_release);
+    }
+    Knot& knot = chunk->knots[i & (kChunkSize - 1)];
+    knot.time = time;
+    knot.coefficient = coefficient;
+    size_.store(i + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  struct Chunk {
+    Knot knots[kChunkSize];
+  };
+
+  struct Table {
+    std::atomic<Chunk*> chunks[kTableSize];
+  };
+
+  std::atomic<Table*> tables_[kMaxTables];
+  const std::size_t capacity_;
+  std::atomic<std::size_t> size_;
+};
+
+template <typename Coefficient_>
+constexpr std::size_t ChunkedKnotStorage<Coefficient_>::kMaxCapacity;
+
+} // namespace curves
@@ -0,0 +1,71 @@
+/*
+ * CoefficientExpression.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#pragma once
+
+// stl
+#include <functional>
+#include <vector>
+
+// boost
+#include <boost/unordered_map.hpp>
+
+// glog
+#include <glog/logging.h>
+
+// curves
+#include "curves/Curve.hpp"
+
+namespace curves {
+
+/// \brief Lightweight expression of a curve value in terms of curve coefficients.
+///
+/// It stores the keys of the coefficients the value depends on and how to combine
+/// them, so the value can be recomputed for updated coefficients without going
+/// through the curve. It does not provide Jacobians.
+///
+/// SlerpSE3Curve, CubicHermiteSE3Curve and the discrete SE3 curves provide getValueExpression.
+/// It is not part of SE3Curve as the coefficient types of the curves differ.
+template <typename Value, typename Coefficient = Value>
+class CoefficientExpression {
+ public:
+  typedef boost::unordered_map<Key, Coefficient> CoefficientMap;
+  typedef std::function<Value(const std::vector<Coefficient>&)> Function;
+
+  /// \brief Leaf expression, the value of the coefficient with this key.
+  explicit CoefficientExpression(Key key)
+      : keys_(1, key),
+        function_([](const std::vector<Coefficient>& coefficients) { return Value(coefficients[0]); }) {}
+
+  /// \brief Value computed by function from the coefficients with these keys, in this order.
+  CoefficientExpression(const std::vector<Key>& keys, const Function& function)
+      : keys_(keys),
+        function_(function) {}
+
+  /// \brief Keys of the coefficients the value depends on.
+  const std::vector<Key>& keys() const {
+    return keys_;
+  }
+
+  /// \brief Evaluate the expression, it is an error if a coefficient is missing.
+  Value value(const CoefficientMap& coefficients) const {
+    std::vector<Coefficient> arguments;
+    arguments.reserve(keys_.size());
+    for (size_t i = 0; i < keys_.size(); ++i) {
+      typename CoefficientMap::const_iterator it = coefficients.find(keys_[i]);
+      CHECK(it != coefficients.end()) << "No coefficient with key " << keys_[i];
+      arguments.push_back(it->second);
+    }
+    return function_(arguments);
+  }
+
+ private:
+  std::vector<Key> keys_;
+  Function function_;
+};
+
+} // namespace curves
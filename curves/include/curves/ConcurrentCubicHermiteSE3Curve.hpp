@@ -0,0 +1,115 @@
+/*
+ * ConcurrentCubicHermiteSE3Curve.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#pragma once
+
+// stl
+#include <memory>
+#include <vector>
+
+// kindr
+#include <kindr/Core>
+
+// curves
+#include "curves/ChunkedKnotStorage.hpp"
+#include "curves/HermiteSE3Coefficient.hpp"
+#include "curves/SE3Config.hpp"
+
+namespace curves {
+
+/// \brief Cubic Hermite SE3 curve that one writer thread can extend while any number of
+///        reader threads evaluate it.
+///
+/// The tangents are the Catmull-Rom slopes used by CubicHermiteSE3Curve::fitCurve, so a
+/// knot is only complete once its successor is known. The writer therefore keeps the last
+/// knot pending and publishes a knot together with the interval ending at it. Readers never
+/// lock or retry: they load the published knot count once and only see complete intervals.
+/// Published knots are immutable and stay alive as long as the curve or a snapshot uses them.
+/// The curve holds at most KnotStorage::kMaxCapacity (2^24) knots, or the smaller capacity
+/// given to the constructor. Knots beyond it are rejected and extend() returns false.
+class ConcurrentCubicHermiteSE3Curve {
+ public:
+  typedef SE3Config::ValueType ValueType;
+  typedef SE3Config::DerivativeType DerivativeType;
+  typedef HermiteSE3Coefficient Coefficient;
+  typedef ChunkedKnotStorage<Coefficient> KnotStorage;
+
+  /// \brief Immutable view of the knots published when the snapshot was taken.
+  ///        Shares the knot chunks with the live curve and keeps them alive.
+  class Snapshot {
+   public:
+    Time getMinTime() const;
+    Time getMaxTime() const;
+    bool isEmpty() const;
+    int size() const;
+    bool evaluate(ValueType& value, Time time) const;
+    bool evaluateDerivative(DerivativeType& derivative, Time time, unsigned int derivativeOrder) const;
+
+   private:
+    friend class ConcurrentCubicHermiteSE3Curve;
+    Snapshot(const std::shared_ptr<const KnotStorage>& knots, size_t size);
+
+    std::shared_ptr<const KnotStorage> knots_;
+    size_t size_;
+  };
+  typedef std::shared_ptr<const Snapshot> SnapshotPtr;
+
+  explicit ConcurrentCubicHermiteSE3Curve(size_t capacity = KnotStorage::kMaxCapacity);
+  ~ConcurrentCubicHermiteSE3Curve();
+
+  /// \brief Append knots (writer thread only). Times must be strictly increasing and larger
+  ///        than all previously appended times. The first knot gets initialDerivative,
+  ///        the last appended knot stays pending until the next extend or finalize.
+  ///        Returns false and drops the remaining knots if the curve is full.
+  bool extend(const std::vector<Time>& times,
+              const std::vector<ValueType>& values,
+              const DerivativeType& initialDerivative = DerivativeType());
+
+  /// \brief Publish the pending knot with the given derivative (writer thread only).
+  ///        Returns false if the curve is full.
+  bool finalize(const DerivativeType& finalDerivative = DerivativeType());
+
+  /// The first published time of the curve.
+  Time getMinTime() const;
+
+  /// The last published time of the curve.
+  Time getMaxTime() const;
+
+  bool isEmpty() const;
+
+  /// Number of published knots.
+  int size() const;
+
+  /// Maximum number of published knots.
+  size_t capacity() const;
+
+  /// Evaluate the curve in the published time range (wait-free).
+  bool evaluate(ValueType& value, Time time) const;
+
+  /// Evaluate the first derivative in the published time range (wait-free).
+  bool evaluateDerivative(DerivativeType& derivative, Time time, unsigned int derivativeOrder) const;
+
+  /// \brief Freeze the published part of the curve in O(1), safe to call from any thread.
+  ///        The pending knot is not part of the snapshot.
+  SnapshotPtr snapshot() const;
+
+ private:
+  bool publish(Time time, const ValueType& value, const DerivativeType& derivative);
+
+  std::shared_ptr<KnotStorage> knots_;
+
+  // Writer state, only touched by the writer thread.
+  bool hasPending_;
+  Time pendingTime_;
+  ValueType pendingValue_;
+  bool hasPrevious_;
+  Time previousTime_;
+  ValueType previousValue_;
+  DerivativeType initialDerivative_;
+};
+
+} // namespace curves
@@ -24,11 +24,11 @@ struct HermiteE3Knot {
                 const Velocity& velocity) : position_(position), velocity_(velocity){}
   virtual ~HermiteE3Knot(){}
 
-  Position getPosition() const {
+  const Position& getPosition() const {
     return position_;
   }
 
-  Velocity getVelocity() const {
+  const Velocity& getVelocity() const {
     return velocity_;
   }
 
@@ -87,6 +87,9 @@ class CubicHermiteE3Curve  {
   // return number of coefficients curve is composed of
   int size() const;
 
+  /// Get the knot times and coefficients in time order.
+  void getKnots(std::vector<Time>* outTimes, std::vector<Coefficient>* outCoefficients) const;
+
   /// \brief calculate the slope between 2 coefficients
   DerivativeType calculateSlope(const Time& timeA,
                                 const Time& timeB,
@@ -96,6 +99,10 @@ class CubicHermiteE3Curve  {
   /// Extend the curve so that it can be evaluated at these times.
   /// Try to make the curve fit to the values.
   /// Note: Assumes that extend times strictly increase the curve time
+  ///
+  /// Each value is appended as a new knot in O(1) amortized time. Only the Catmull-Rom tangent
+  /// of the previous last knot is updated, the new last knot keeps the final derivative of the
+  /// curve. Extending an empty curve one value at a time gives the same knots as fitCurve.
   virtual void extend(const std::vector<Time>& times,
                       const std::vector<ValueType>& values,
                       std::vector<Key>* outKeys = NULL);
@@ -131,8 +138,14 @@ class CubicHermiteE3Curve  {
   // clear the curve
   virtual void clear();
 
+  /// \brief Keep at most this many knots when extending, the oldest knots are removed
+  ///        first. 0 (the default) keeps all knots.
+  void setMaxNumberOfCoefficients(size_t maxNumberOfCoefficients);
+
  private:
   LocalSupport2CoefficientManager<Coefficient> manager_;
+
+  size_t maxNumberOfCoefficients_;
 };
 
 } // namespace curves
@@ -10,6 +10,8 @@
 
 #include <kindr/Core>
 
+#include "curves/CoefficientExpression.hpp"
+#include "curves/HermiteSE3Coefficient.hpp"
 #include "curves/LocalSupport2CoefficientManager.hpp"
 #include "curves/SamplingPolicy.hpp"
 #include "curves/SE3CompositionCurve.hpp"
@@ -20,8 +22,8 @@ namespace kindr {
 
 template <typename Scalar>
 struct HermiteTransformation {
-  typedef kindr::HomTransformQuatD Transform;
-  typedef kindr::TwistGlobalD Twist;
+  typedef kindr::HomTransformQuat<Scalar> Transform;
+  typedef kindr::TwistGlobal<Scalar> Twist;
 
  public:
   HermiteTransformation();
@@ -67,7 +69,7 @@ namespace curves {
 
 typedef SE3Curve::ValueType ValueType;
 typedef SE3Curve::DerivativeType DerivativeType;
-typedef kindr::HermiteTransformation<double> Coefficient;
+typedef HermiteSE3Coefficient Coefficient;
 typedef LocalSupport2CoefficientManager<Coefficient>::TimeToKeyCoefficientMap TimeToKeyCoefficientMap;
 typedef LocalSupport2CoefficientManager<Coefficient>::CoefficientIter CoefficientIter;
 
@@ -100,7 +102,8 @@ class CubicHermiteSE3Curve : public SE3Curve {
 
   friend class SamplingPolicy;
  public:
-  typedef kindr::HermiteTransformation<double> Coefficient;
+  typedef HermiteSE3Coefficient Coefficient;
+  typedef Eigen::Matrix<double, 6, Coefficient::kSize> CoefficientJacobian;
 
   CubicHermiteSE3Curve();
   virtual ~CubicHermiteSE3Curve();
@@ -156,6 +159,18 @@ class CubicHermiteSE3Curve : public SE3Curve {
   /// Evaluate the ambient space of the curve.
   virtual bool evaluate(ValueType& value, Time time) const;
 
+  /// \brief Evaluate the curve and the Jacobians of the pose with respect to the two coefficients
+  ///        bracketing time. The rows are the position (0,1,2) and a global rotation perturbation
+  ///        (3,4,5), the columns follow the Coefficient layout. keyA and keyB return the keys of
+  ///        these coefficients.
+  bool evaluate(ValueType& value, Time time,
+                CoefficientJacobian* jacobianA, CoefficientJacobian* jacobianB,
+                Key* keyA = NULL, Key* keyB = NULL) const;
+
+  /// \brief Get an expression of the value at this time in terms of the two coefficients
+  ///        bracketing it.
+  CoefficientExpression<ValueType, Coefficient> getValueExpression(const Time& time) const;
+
   /// Evaluate the curve derivatives.
   virtual bool evaluateDerivative(DerivativeType& derivative, Time time, unsigned int derivativeOrder) const;
 
@@ -224,6 +239,10 @@ class CubicHermiteSE3Curve : public SE3Curve {
 
   void saveCurveAtTimes(const std::string& filename, std::vector<Time> times) const;
 
+  /// \brief Save the knot times and coefficients in the binary curve format, which can be
+  ///        evaluated in place with MappedCubicHermiteSE3Curve (see HermiteSE3CurveFile.hpp).
+  bool saveCurveBinary(const std::string& filename) const;
+
   void saveCorrectionCurveAtTimes(const std::string& /*filename*/, std::vector<Time> /*times*/) const {}
 
   void getCurveTimes(std::vector<Time>* outTimes) const;
@@ -235,6 +254,8 @@ class CubicHermiteSE3Curve : public SE3Curve {
   ///        correction curve coefficients to identity transformations.
   void foldInCorrections() {}
 
+  using SE3Curve::foldInCorrections;
+
   /// \brief Add coefficients to the correction curve at given times.
   void setCorrectionTimes(const std::vector<Time>& /*times*/) {}
 
@@ -396,6 +417,6 @@ namespace kindr {
 
 typedef curves::SE3Curve::ValueType ValueType;
 typedef curves::SE3Curve::DerivativeType DerivativeType;
-typedef kindr::HermiteTransformation<double> Coefficient;
+typedef curves::HermiteSE3Coefficient Coefficient;
 
 }
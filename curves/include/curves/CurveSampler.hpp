@@ -0,0 +1,308 @@
+/*
+ * CurveSampler.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#pragma once
+
+// stl
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// boost
+#include <boost/thread.hpp>
+
+// eigen
+#include <Eigen/Core>
+
+// glog
+#include <glog/logging.h>
+
+// kindr
+#include <kindr/Core>
+
+// curves
+#include "curves/Curve.hpp"
+#include "curves/helpers.hpp"
+
+namespace curves {
+
+/// \brief Flattens curve values into doubles for the file sinks.
+template <typename ValueType>
+struct CurveSampleTraits;
+
+template <>
+struct CurveSampleTraits<double> {
+  static constexpr size_t kDimension = 1;
+  static void flatten(const double& value, double* out) { out[0] = value; }
+};
+
+template <int N>
+struct CurveSampleTraits<Eigen::Matrix<double, N, 1> > {
+  static_assert(N > 0, "CurveSampleTraits needs a fixed size vector");
+  static constexpr size_t kDimension = N;
+  static void flatten(const Eigen::Matrix<double, N, 1>& value, double* out) {
+    Eigen::Map<Eigen::Matrix<double, N, 1> > map(out);
+    map = value;
+  }
+};
+
+/// Poses are written as px py pz qw qx qy qz, like saveCurveAtTimes.
+template <>
+struct CurveSampleTraits<kindr::HomTransformQuatD> {
+  static constexpr size_t kDimension = 7;
+  static void flatten(const kindr::HomTransformQuatD& value, double* out) {
+    out[0] = value.getPosition().x();
+    out[1] = value.getPosition().y();
+    out[2] = value.getPosition().z();
+    out[3] = value.getRotation().w();
+    out[4] = value.getRotation().x();
+    out[5] = value.getRotation().y();
+    out[6] = value.getRotation().z();
+  }
+};
+
+/// \brief Receives the samples of a CurveSampler chunk by chunk, in time order.
+template <typename ValueType>
+class CurveSampleSink {
+ public:
+  virtual ~CurveSampleSink() {}
+
+  /// Consume n samples. Return false to stop sampling.
+  virtual bool consume(const Time* times, const ValueType* values, size_t n) = 0;
+
+  /// Called once after the last chunk.
+  virtual bool finish() { return true; }
+};
+
+/// \brief Forwards every chunk to a callback.
+template <typename ValueType>
+class CallbackCurveSampleSink : public CurveSampleSink<ValueType> {
+ public:
+  typedef std::function<bool(const Time*, const ValueType*, size_t)> Callback;
+
+  explicit CallbackCurveSampleSink(const Callback& callback) : callback_(callback) {}
+
+  virtual bool consume(const Time* times, const ValueType* values, size_t n) {
+    return callback_(times, values, n);
+  }
+
+ private:
+  Callback callback_;
+};
+
+/// \brief Base of the file sinks, flattens each chunk into a reused row-major buffer.
+template <typename ValueType>
+class FileCurveSampleSink : public CurveSampleSink<ValueType> {
+ public:
+  typedef CurveSampleTraits<ValueType> Traits;
+
+  explicit FileCurveSampleSink(const std::string& fileName, const char* mode)
+      : file_(fopen(fileName.c_str(), mode)) {
+    if (file_ == NULL) {
+      std::cerr << "Could not open file " << fileName << " to write samples." << std::endl;
+    }
+  }
+
+  virtual ~FileCurveSampleSink() {
+    finish();
+  }
+
+  bool isOpen() const { return file_ != NULL; }
+
+  virtual bool finish() {
+    if (file_ == NULL) {
+      return false;
+    }
+    const bool success = (fclose(file_) == 0);
+    file_ = NULL;
+    return success;
+  }
+
+ protected:
+  const double* flatten(const ValueType* values, size_t n) {
+    flattened_.resize(n * Traits::kDimension);
+    for (size_t i = 0; i < n; ++i) {
+      Traits::flatten(values[i], flattened_.data() + i * Traits::kDimension);
+    }
+    return flattened_.data();
+  }
+
+  FILE* file_;
+
+ private:
+  std::vector<double> flattened_;
+};
+
+/// \brief Writes rows "time,value0,value1,..." as produced by writeTimeVectorCSV.
+template <typename ValueType>
+class CsvCurveSampleSink : public FileCurveSampleSink<ValueType> {
+ public:
+  typedef FileCurveSampleSink<ValueType> Base;
+
+  explicit CsvCurveSampleSink(const std::string& fileName, int precision = 0, unsigned numThreads = 0)
+      : Base(fileName, "wb"), precision_(precision), numThreads_(numThreads) {}
+
+  virtual bool consume(const Time* times, const ValueType* values, size_t n) {
+    if (this->file_ == NULL) {
+      return false;
+    }
+    writeTimeVectorCSV(this->file_, times, this->flatten(values, n), n, Base::Traits::kDimension,
+                       precision_, numThreads_);
+    return true;
+  }
+
+ private:
+  int precision_;
+  unsigned numThreads_;
+};
+
+/// \brief Writes rows of native (little-endian on x86/ARM) doubles [time, value0, value1, ...]
+///        without a header, readable with fread or numpy.fromfile.
+template <typename ValueType>
+class BinaryCurveSampleSink : public FileCurveSampleSink<ValueType> {
+ public:
+  typedef FileCurveSampleSink<ValueType> Base;
+
+  explicit BinaryCurveSampleSink(const std::string& fileName) : Base(fileName, "wb") {}
+
+  virtual bool consume(const Time* times, const ValueType* values, size_t n) {
+    if (this->file_ == NULL) {
+      return false;
+    }
+    const size_t dimension = Base::Traits::kDimension;
+    const double* flattened = this->flatten(values, n);
+    rows_.resize(n * (dimension + 1));
+    for (size_t i = 0; i < n; ++i) {
+      rows_[i * (dimension + 1)] = times[i];
+      std::copy(flattened + i * dimension, flattened + (i + 1) * dimension, rows_.begin() + i * (dimension + 1) + 1);
+    }
+    return fwrite(rows_.data(), sizeof(double), rows_.size(), this->file_) == rows_.size();
+  }
+
+ private:
+  std::vector<double> rows_;
+};
+
+/// \brief Evaluates a curve at a fixed rate or at given times and streams the samples into a
+///        sink in chunks of bounded size, so memory does not grow with the number of samples.
+///
+/// Each chunk is evaluated on numThreads threads (0: one per core). The threads are started once
+/// per sampling call and evaluate one contiguous range of every chunk. This requires that the
+/// curve's const evaluate() can be called concurrently, use one thread otherwise.
+template <typename Curve_>
+class CurveSampler {
+ public:
+  typedef typename Curve_::ValueType ValueType;
+  typedef CurveSampleSink<ValueType> Sink;
+  typedef std::vector<ValueType, Eigen::aligned_allocator<ValueType> > ValueVector;
+
+  CurveSampler(const Curve_& curve, size_t chunkSize = 4096, unsigned numThreads = 0)
+      : curve_(curve),
+        chunkSize_(std::max<size_t>(chunkSize, 1)),
+        numThreads_(numThreads == 0 ? std::max(1u, boost::thread::hardware_concurrency()) : numThreads) {}
+
+  /// \brief Sample at minTime + i / rateHz for all i up to maxTime. The times are computed from
+  ///        the index, so they do not accumulate rounding errors.
+  bool sampleAtRate(double rateHz, Sink* sink) const {
+    if (!(rateHz > 0.0)) {
+      std::cerr << "CurveSampler::sampleAtRate: rate has to be positive." << std::endl;
+      return false;
+    }
+    const Time minTime = curve_.getMinTime();
+    const Time maxTime = curve_.getMaxTime();
+    // Tolerate rounding when the duration is a multiple of the period.
+    const size_t nSamples = static_cast<size_t>(std::floor((maxTime - minTime) * rateHz + 1e-9)) + 1;
+    return sample(nSamples, [=](size_t i) { return std::min(maxTime, minTime + double(i) / rateHz); }, sink);
+  }
+
+  /// Sample at the given times.
+  bool sampleAtTimes(const std::vector<Time>& times, Sink* sink) const {
+    return sampleAtTimes(times.data(), times.size(), sink);
+  }
+
+  bool sampleAtTimes(const Time* times, size_t nSamples, Sink* sink) const {
+    return sample(nSamples, [=](size_t i) { return times[i]; }, sink);
+  }
+
+ private:
+  template <typename TimeAt>
+  bool sample(size_t nSamples, const TimeAt& timeAt, Sink* sink) const {
+    CHECK_NOTNULL(sink);
+    std::vector<Time> times;
+    ValueVector values(std::min(chunkSize_, nSamples));
+    const size_t nThreads = std::max<size_t>(1, std::min<size_t>(numThreads_, nSamples));
+    std::vector<char> success(nThreads, 1);
+    size_t n = 0;
+    bool stop = false;
+
+    // Evaluate the t-th contiguous range of the current chunk.
+    auto evaluateShare = [&](size_t t) {
+      const size_t perThread = (n + nThreads - 1) / nThreads;
+      const size_t begin = std::min(n, t * perThread);
+      const size_t end = std::min(n, begin + perThread);
+      success[t] = evaluateRange(times, begin, end, &values);
+    };
+
+    // The calling thread takes the last range. The barrier hands every chunk to the workers
+    // and waits until all ranges are evaluated, it also orders the accesses to n, times and stop.
+    boost::barrier barrier(nThreads);
+    boost::thread_group workers;
+    for (size_t t = 0; t + 1 < nThreads; ++t) {
+      workers.create_thread([&barrier, &stop, &evaluateShare, t]() {
+        while (true) {
+          barrier.wait();
+          if (stop) {
+            return;
+          }
+          evaluateShare(t);
+          barrier.wait();
+        }
+      });
+    }
+
+    bool ok = true;
+    for (size_t cursor = 0; cursor < nSamples && ok; cursor += chunkSize_) {
+      n = std::min(chunkSize_, nSamples - cursor);
+      times.resize(n);
+      for (size_t i = 0; i < n; ++i) {
+        times[i] = timeAt(cursor + i);
+      }
+      barrier.wait();
+      evaluateShare(nThreads - 1);
+      barrier.wait();
+      ok = std::find(success.begin(), success.end(), 0) == success.end() &&
+           sink->consume(times.data(), values.data(), n);
+    }
+    stop = true;
+    barrier.wait();
+    workers.join_all();
+
+    const bool finished = sink->finish();
+    return ok && finished;
+  }
+
+  bool evaluateRange(const std::vector<Time>& times, size_t begin, size_t end,
+                     ValueVector* values) const {
+    for (size_t i = begin; i < end; ++i) {
+      if (!curve_.evaluate((*values)[i], times[i])) {
+        std::cerr << "CurveSampler: could not evaluate at time " << times[i] << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const Curve_& curve_;
+  size_t chunkSize_;
+  unsigned numThreads_;
+};
+
+} // namespace curves
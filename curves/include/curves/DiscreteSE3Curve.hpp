@@ -8,9 +8,10 @@
 #define CURVES_DISCRETE_SE3_CURVE_HPP
 
 #include "SE3Curve.hpp"
+#include "CoefficientExpression.hpp"
 #include "LocalSupport2CoefficientManager.hpp"
+#include "kindr/Core"
 #include "SE3CompositionCurve.hpp"
-#include "gtsam/nonlinear/NonlinearFactorGraph.h"
 #include "SamplingPolicy.hpp"
 #include "CubicHermiteSE3Curve.hpp"
 
@@ -21,6 +22,8 @@ class DiscreteSE3Curve : public SE3Curve {
   friend class SE3CompositionCurve<DiscreteSE3Curve, DiscreteSE3Curve>;
   friend class SamplingPolicy;
  public:
+  typedef SE3Curve::ValueType ValueType;
+  typedef SE3Curve::DerivativeType DerivativeType;
   typedef ValueType Coefficient;
   typedef LocalSupport2CoefficientManager<Coefficient>::TimeToKeyCoefficientMap TimeToKeyCoefficientMap;
   typedef LocalSupport2CoefficientManager<Coefficient>::CoefficientIter CoefficientIter;
@@ -63,7 +66,13 @@ class DiscreteSE3Curve : public SE3Curve {
                 const std::vector<ValueType>& values);
 
   /// Evaluate the ambient space of the curve.
-  virtual ValueType evaluate(Time time) const;
+  virtual bool evaluate(ValueType& value, Time time) const;
+
+  /// \brief Evaluate the curve at several times.
+  bool evaluate(const std::vector<Time>& times, std::vector<ValueType>* values) const;
+
+  /// \brief Get an expression of the value at this time in terms of the curve coefficients.
+  CoefficientExpression<ValueType> getValueExpression(const Time& time) const;
 
   /// Evaluate the curve derivatives.
   /// linear 1st derivative has following behaviour:
@@ -72,12 +81,7 @@ class DiscreteSE3Curve : public SE3Curve {
   /// - time is on coefficient (not last coefficient) --> take slope between coefficient and next coefficients
   /// - time is on last coefficient --> take slope between last-1 and last coefficient
   /// derivatives of order >1 equal 0
-  virtual DerivativeType evaluateDerivative(Time time, unsigned derivativeOrder) const;
-
-  /// \brief Get an evaluator at this time
-  virtual gtsam::Expression<ValueType> getValueExpression(const Time& time) const;
-
-  virtual gtsam::Expression<DerivativeType> getDerivativeExpression(const Time& time, unsigned derivativeOrder) const;
+  virtual bool evaluateDerivative(DerivativeType& derivative, Time time, unsigned derivativeOrder) const;
 
   virtual void setTimeRange(Time minTime, Time maxTime);
 
@@ -125,15 +129,6 @@ class DiscreteSE3Curve : public SE3Curve {
   ///        and the angular velocity (3,4,5).
   virtual Vector6d evaluateDerivativeB(unsigned derivativeOrder, Time time);
 
-  /// Initialize a GTSAM values structure with the desired keys
-  virtual void initializeGTSAMValues(gtsam::KeySet keys, gtsam::Values* values) const;
-
-  /// Initialize a GTSAM values structure for all keys
-  virtual void initializeGTSAMValues(gtsam::Values* values) const;
-
-  // updates the relevant curve coefficients from the GTSAM values structure
-  virtual void updateFromGTSAMValues(const gtsam::Values& values);
-
   // set minimum sampling period
   void setMinSamplingPeriod(Time time);
 
@@ -143,13 +138,10 @@ class DiscreteSE3Curve : public SE3Curve {
 
   virtual void clear();
 
-  /// \brief Add factors to constrain the variables active at this time.
-  void addPriorFactors(gtsam::NonlinearFactorGraph* graph, Time priorTime) const;
-
   /// \brief Perform a rigid transformation on the left side of the curve
   void transformCurve(const ValueType T);
 
-  virtual Time getTimeAtKey(gtsam::Key key) const;
+  virtual Time getTimeAtKey(Key key) const;
 
   void saveCurveTimesAndValues(const std::string& filename) const;
 
@@ -169,6 +161,8 @@ class DiscreteSE3Curve : public SE3Curve {
   ///        correction curve coefficients to identity transformations.
   void foldInCorrections() {}
 
+  using SE3Curve::foldInCorrections;
+
   /// \brief Add coefficients to the correction curve at given times.
   void setCorrectionTimes(const std::vector<Time>& /*times*/) {}
 
@@ -206,9 +200,9 @@ class DiscreteSE3Curve : public SE3Curve {
   SamplingPolicy discretePolicy_;
 };
 
-typedef kindr::minimal::QuatTransformationTemplate<double> SE3;
+typedef kindr::HomogeneousTransformationPosition3RotationQuaternionD SE3;
 typedef SE3::Rotation SO3;
-typedef kindr::minimal::AngleAxisTemplate<double> AngleAxis;
+typedef kindr::AngleAxisPD AngleAxis;
 
 // extend policy for slerp curves
 template<>
@@ -0,0 +1,148 @@
+/*
+ * HermiteSE3Coefficient.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+// eigen
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+// kindr
+#include <kindr/Core>
+
+// curves
+#include "curves/cubic_hermite_kernels.hpp"
+
+namespace curves {
+
+/// Plain-old-data Hermite coefficient (pose and twist at a knot) for SE3 curves.
+/// The 13 doubles are stored contiguously as
+///   [ px py pz | qw qx qy qz | vx vy vz | wx wy wz ],
+/// so arrays of coefficients can be memcpy'd, mmap'd and vector-loaded directly.
+struct alignas(16) HermiteSE3Coefficient {
+  typedef kindr::HomTransformQuatD Transform;
+  typedef kindr::TwistGlobalD Twist;
+  typedef Eigen::Map<const Eigen::Vector3d> ConstVector3Map;
+  typedef Eigen::Map<Eigen::Vector3d> Vector3Map;
+  typedef Eigen::Map<const Eigen::Vector4d> ConstVector4Map;
+  typedef Eigen::Map<Eigen::Vector4d> Vector4Map;
+
+  static constexpr std::size_t kPositionOffset = 0;
+  static constexpr std::size_t kQuaternionOffset = 3;
+  static constexpr std::size_t kLinearVelocityOffset = 7;
+  static constexpr std::size_t kAngularVelocityOffset = 10;
+  static constexpr std::size_t kSize = 13;
+
+  /// Identity pose with zero twist.
+  HermiteSE3Coefficient() {
+    for (std::size_t i = 0; i < kSize; ++i) {
+      data_[i] = 0.0;
+    }
+    data_[kQuaternionOffset] = 1.0;
+  }
+
+  HermiteSE3Coefficient(const Transform& transform, const Twist& derivatives) {
+    setTransformation(transform);
+    setTransformationDerivative(derivatives);
+  }
+
+  const double* data() const { return data_; }
+  double* data() { return data_; }
+
+  ConstVector3Map getPosition() const { return ConstVector3Map(data_ + kPositionOffset); }
+  Vector3Map getPosition() { return Vector3Map(data_ + kPositionOffset); }
+
+  /// Quaternion stored as (w, x, y, z).
+  ConstVector4Map getQuaternion() const { return ConstVector4Map(data_ + kQuaternionOffset); }
+  Vector4Map getQuaternion() { return Vector4Map(data_ + kQuaternionOffset); }
+
+  ConstVector3Map getLinearVelocity() const { return ConstVector3Map(data_ + kLinearVelocityOffset); }
+  Vector3Map getLinearVelocity() { return Vector3Map(data_ + kLinearVelocityOffset); }
+
+  ConstVector3Map getAngularVelocity() const { return ConstVector3Map(data_ + kAngularVelocityOffset); }
+  Vector3Map getAngularVelocity() { return Vector3Map(data_ + kAngularVelocityOffset); }
+
+  Eigen::Quaterniond getEigenQuaternion() const {
+    return Eigen::Quaterniond(data_[kQuaternionOffset], data_[kQuaternionOffset + 1],
+                              data_[kQuaternionOffset + 2], data_[kQuaternionOffset + 3]);
+  }
+
+  /// Builds the kindr pose from the stored data.
+  Transform getTransformation() const {
+    return Transform(Transform::Position(getPosition()),
+                     Transform::Rotation(data_[kQuaternionOffset], data_[kQuaternionOffset + 1],
+                                         data_[kQuaternionOffset + 2], data_[kQuaternionOffset + 3]));
+  }
+
+  /// Builds the kindr twist from the stored data.
+  Twist getTransformationDerivative() const {
+    return Twist(Eigen::Vector3d(getLinearVelocity()), Eigen::Vector3d(getAngularVelocity()));
+  }
+
+  void setTransformation(const Transform& transformation) {
+    getPosition() = transformation.getPosition().vector();
+    data_[kQuaternionOffset] = transformation.getRotation().w();
+    data_[kQuaternionOffset + 1] = transformation.getRotation().x();
+    data_[kQuaternionOffset + 2] = transformation.getRotation().y();
+    data_[kQuaternionOffset + 3] = transformation.getRotation().z();
+  }
+
+  void setTransformationDerivative(const Twist& transformationDerivative) {
+    getLinearVelocity() = transformationDerivative.getTranslationalVelocity().vector();
+    getAngularVelocity() = transformationDerivative.getRotationalVelocity().vector();
+  }
+
+  /// Pose on the cubic Hermite interval from a to b of duration dt at the normalized time alpha.
+  static Transform interpolate(const HermiteSE3Coefficient& a, const HermiteSE3Coefficient& b,
+                               double dt, double alpha) {
+    const Eigen::Vector3d translation = hermite_kernels::evaluatePosition<double>(
+        a.getPosition(), a.getLinearVelocity(), b.getPosition(), b.getLinearVelocity(), dt, alpha);
+    const Eigen::Quaterniond rotation = hermite_kernels::evaluateRotation<double>(
+        a.getEigenQuaternion(), a.getAngularVelocity(), b.getEigenQuaternion(), b.getAngularVelocity(), dt, alpha);
+    return Transform(Transform::Position(translation),
+                     Transform::Rotation(rotation.w(), rotation.x(), rotation.y(), rotation.z()));
+  }
+
+  /// Twist on the cubic Hermite interval from a to b, the angular velocity is global.
+  static Twist interpolateDerivative(const HermiteSE3Coefficient& a, const HermiteSE3Coefficient& b,
+                                     double dt, double alpha) {
+    const Eigen::Vector3d velocity_m_s = hermite_kernels::evaluateLinearVelocity<double>(
+        a.getPosition(), a.getLinearVelocity(), b.getPosition(), b.getLinearVelocity(), dt, alpha);
+    const Eigen::Vector3d angularVelocity_rad_s = hermite_kernels::evaluateAngularVelocity<double>(
+        a.getEigenQuaternion(), a.getAngularVelocity(), b.getEigenQuaternion(), b.getAngularVelocity(), dt, alpha);
+    return Twist(velocity_m_s, angularVelocity_rad_s);
+  }
+
+  bool operator==(const HermiteSE3Coefficient& other) const {
+    for (std::size_t i = 0; i < kSize; ++i) {
+      if (data_[i] != other.data_[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool operator!=(const HermiteSE3Coefficient& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  double data_[kSize];
+};
+
+static_assert(std::is_trivially_copyable<HermiteSE3Coefficient>::value,
+              "HermiteSE3Coefficient must be trivially copyable");
+static_assert(std::is_standard_layout<HermiteSE3Coefficient>::value,
+              "HermiteSE3Coefficient must have standard layout");
+static_assert(alignof(HermiteSE3Coefficient) == 16, "HermiteSE3Coefficient must be 16-byte aligned");
+static_assert(sizeof(HermiteSE3Coefficient) == 16 * ((HermiteSE3Coefficient::kSize * sizeof(double) + 15) / 16),
+              "HermiteSE3Coefficient must not carry anything but its 13 doubles and tail padding");
+
+} // namespace curves
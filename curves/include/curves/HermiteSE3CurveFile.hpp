@@ -0,0 +1,97 @@
+/*
+ * HermiteSE3CurveFile.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// curves
+#include "curves/Curve.hpp"
+#include "curves/HermiteSE3Coefficient.hpp"
+#include "curves/SE3Config.hpp"
+
+namespace curves {
+
+/// \brief Header of the binary Hermite SE3 curve file (version 1, little-endian).
+///
+/// File layout:
+///   [0, 64)                      this header
+///   [timesOffset, +8 n)          knot times as double
+///   [coefficientsOffset, +s n)   coefficients, each record is s = coefficientStride bytes
+///                                holding the 13 doubles of HermiteSE3Coefficient followed
+///                                by zero padding
+/// Both arrays start at 64 byte aligned offsets so a mapped file can be used in place.
+struct HermiteSE3CurveFileHeader {
+  static constexpr char kMagic[8] = {'C', 'U', 'R', 'V', 'H', 'S', 'E', '3'};
+  static constexpr uint32_t kVersion = 1;
+  static constexpr uint64_t kAlignment = 64;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t headerSize;
+  uint64_t numKnots;
+  uint64_t timesOffset;
+  uint64_t coefficientsOffset;
+  uint32_t coefficientStride;
+  uint32_t coefficientSize;
+  uint64_t reserved[2];
+};
+
+static_assert(sizeof(HermiteSE3CurveFileHeader) == 64, "HermiteSE3CurveFileHeader must be 64 bytes");
+
+/// \brief Write times and coefficients in the binary Hermite SE3 curve format.
+///        Returns false if the file could not be written.
+bool writeHermiteSE3CurveFile(const std::string& filename,
+                              const std::vector<Time>& times,
+                              const std::vector<HermiteSE3Coefficient>& coefficients);
+
+/// \brief Read-only cubic Hermite SE3 curve that evaluates straight from a memory-mapped
+///        binary curve file. Nothing is deserialized, pages are loaded on first access.
+class MappedCubicHermiteSE3Curve {
+ public:
+  typedef SE3Config::ValueType ValueType;
+  typedef SE3Config::DerivativeType DerivativeType;
+  typedef HermiteSE3Coefficient Coefficient;
+
+  MappedCubicHermiteSE3Curve();
+  ~MappedCubicHermiteSE3Curve();
+
+  MappedCubicHermiteSE3Curve(const MappedCubicHermiteSE3Curve&) = delete;
+  MappedCubicHermiteSE3Curve& operator=(const MappedCubicHermiteSE3Curve&) = delete;
+
+  /// Map a curve file, returns false if it cannot be opened or is not a valid curve file.
+  bool load(const std::string& filename);
+
+  /// Unmap the file.
+  void clear();
+
+  Time getMinTime() const;
+  Time getMaxTime() const;
+  bool isEmpty() const;
+  int size() const;
+
+  const Time* times() const { return times_; }
+  const Coefficient& getCoefficient(size_t i) const;
+
+  bool evaluate(ValueType& value, Time time) const;
+  bool evaluateDerivative(DerivativeType& derivative, Time time, unsigned int derivativeOrder) const;
+
+ private:
+  bool getIndicesAt(Time time, size_t* a, size_t* b) const;
+
+  void* mapping_;
+  size_t mappingSize_;
+  const Time* times_;
+  const char* coefficients_;
+  size_t coefficientStride_;
+  size_t size_;
+};
+
+} // namespace curves
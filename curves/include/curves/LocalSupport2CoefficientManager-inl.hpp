@@ -93,14 +93,14 @@ void LocalSupport2CoefficientManager<Coefficient>::getTimesInWindow(std::vector<
   CHECK_NOTNULL(outTimes);
 
   outTimes->clear();
-  CoefficientIter it = --(timeToCoefficient_.end());
-
-  do {
-    if (it->first >= begTime) {
-      outTimes->push_back(it->first);
-    }
+  CoefficientIter it = timeToCoefficient_.end();
+  while (it != timeToCoefficient_.begin()) {
     --it;
-  } while (it->first >= begTime && it != timeToCoefficient_.begin());
+    if (it->first < begTime) {
+      break;
+    }
+    outTimes->push_back(it->first);
+  }
 
   std::reverse(outTimes->begin(),outTimes->end());
 }
@@ -168,7 +168,7 @@ void LocalSupport2CoefficientManager<Coefficient>::addCoefficientAtEnd(Time time
   Key key = KeyGenerator::getNextKey();
 
   // Insert the coefficient with a hint that it goes at the end
-  CoefficientIter it = timeToCoefficient_.insert(--(timeToCoefficient_.end()),
+  CoefficientIter it = timeToCoefficient_.insert(timeToCoefficient_.end(),
                                                  std::pair<Time, KeyCoefficient>(time, KeyCoefficient(key, coefficient)));
 
   keyToCoefficient_.insert(keyToCoefficient_.end(), std::pair<Key, CoefficientIter>(key,it));
@@ -177,6 +177,13 @@ void LocalSupport2CoefficientManager<Coefficient>::addCoefficientAtEnd(Time time
   }
 }
 
+template <class Coefficient>
+void LocalSupport2CoefficientManager<Coefficient>::removeCoefficientAtBegin() {
+  CHECK(!timeToCoefficient_.empty()) << "No coefficient to remove.";
+  keyToCoefficient_.erase(timeToCoefficient_.begin()->second.key);
+  timeToCoefficient_.erase(timeToCoefficient_.begin());
+}
+
 template <class Coefficient>
 void LocalSupport2CoefficientManager<Coefficient>::modifyCoefficient(typename TimeToKeyCoefficientMap::iterator it,
                                                                      Time time, const Coefficient& coefficient) {
@@ -221,8 +228,7 @@ bool LocalSupport2CoefficientManager<Coefficient>::hasCoefficientAtTime(Time tim
 /// \brief return true if there is a coefficient with this key
 template <class Coefficient>
 bool LocalSupport2CoefficientManager<Coefficient>::hasCoefficientWithKey(Key key) const {
-  CoefficientIter it = keyToCoefficient_.find(key);
-  return it != keyToCoefficient_.end();
+  return keyToCoefficient_.find(key) != keyToCoefficient_.end();
 }
 
 /// \brief set the coefficient associated with this key
@@ -305,10 +311,10 @@ void LocalSupport2CoefficientManager<Coefficient>::getCoefficientsInRange(
     it--;
     // iterate through coefficients
     for (; it != timeToCoefficient_.end() && it->first < endTime; ++it) {
-      (*outCoefficients)[it->second->key] = it->second->coefficient;
+      (*outCoefficients)[it->second.key] = it->second.coefficient;
     }
     if (it != timeToCoefficient_.end()) {
-      (*outCoefficients)[it->second->key] = it->second->coefficient;
+      (*outCoefficients)[it->second.key] = it->second.coefficient;
     }
   }
 }
@@ -320,7 +326,7 @@ void LocalSupport2CoefficientManager<Coefficient>::getCoefficients(CoefficientMa
   CoefficientIter it;
   it = timeToCoefficient_.begin();
   for( ; it != timeToCoefficient_.end(); ++it) {
-    (*outCoefficients)[it->second->key] = it->second->coefficient;
+    (*outCoefficients)[it->second.key] = it->second.coefficient;
   }
 }
 
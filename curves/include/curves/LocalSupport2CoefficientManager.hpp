@@ -94,6 +94,9 @@ class LocalSupport2CoefficientManager {
   /// \brief Efficient function for adding a coefficient at the end of the map
   void addCoefficientAtEnd(Time time, const Coefficient& coefficient, std::vector<Key>* outKeys = NULL);
 
+  /// \brief Efficient function for removing the coefficient at the beginning of the map
+  void removeCoefficientAtBegin();
+
   /// \brief Modify a coefficient by specifying a new time and value
   void modifyCoefficient(typename TimeToKeyCoefficientMap::iterator it, Time time, const Coefficient& coefficient);
 
@@ -0,0 +1,88 @@
+/*
+ * PackedCubicHermiteE3Curve.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#pragma once
+
+// stl
+#include <vector>
+
+// eigen
+#include <Eigen/Core>
+
+// curves
+#include "curves/CubicHermiteE3Curve.hpp"
+#include "curves/Curve.hpp"
+
+namespace curves {
+
+/// \brief Cubic Hermite curve in R³ with the knots stored as a structure of arrays.
+///
+/// Times, positions and velocities live in contiguous arrays (one column per coordinate),
+/// so intervals are found by binary search or a forward cursor instead of map lookups. The
+/// batch functions evaluate position, velocity and acceleration of many sorted samples from
+/// one basis evaluation, with the arithmetic vectorized across samples.
+class PackedCubicHermiteE3Curve {
+ public:
+  typedef Eigen::Vector3d ValueType;
+  typedef Eigen::Vector3d DerivativeType;
+  typedef Eigen::Vector3d Acceleration;
+  /// One row per knot or sample, one column per coordinate.
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 3> SampleMatrix;
+
+  PackedCubicHermiteE3Curve();
+
+  /// Copy the knots of a map-based curve.
+  explicit PackedCubicHermiteE3Curve(const CubicHermiteE3Curve& curve);
+
+  /// \brief Fit with Catmull-Rom tangents, like CubicHermiteE3Curve::fitCurveWithDerivatives.
+  void fitCurveWithDerivatives(const std::vector<Time>& times,
+                               const std::vector<ValueType>& values,
+                               const DerivativeType& initialDerivative = DerivativeType::Zero(),
+                               const DerivativeType& finalDerivative = DerivativeType::Zero());
+
+  void fitCurve(const std::vector<Time>& times, const std::vector<ValueType>& values);
+
+  /// Set the knots directly, times must be strictly increasing.
+  void setKnots(const std::vector<Time>& times,
+                const std::vector<ValueType>& positions,
+                const std::vector<DerivativeType>& velocities);
+
+  Time getMinTime() const;
+  Time getMaxTime() const;
+  bool isEmpty() const;
+  int size() const;
+
+  const std::vector<Time>& getTimes() const { return times_; }
+  const SampleMatrix& getPositions() const { return positions_; }
+  const SampleMatrix& getVelocities() const { return velocities_; }
+
+  bool evaluate(ValueType& value, Time time) const;
+  bool evaluateDerivative(DerivativeType& derivative, Time time, unsigned int derivativeOrder) const;
+  bool evaluateLinearAcceleration(Acceleration& linearAcceleration, Time time) const;
+
+  /// \brief Evaluate at all times, which should be sorted ascending (unsorted times are
+  ///        supported but need a binary search each). Outputs that are NULL are skipped.
+  ///        Returns false if a time is outside the curve.
+  bool evaluate(const std::vector<Time>& times, SampleMatrix* positions,
+                SampleMatrix* velocities = NULL, SampleMatrix* accelerations = NULL) const;
+
+  bool evaluateDerivative(const std::vector<Time>& times, SampleMatrix* velocities) const;
+
+  bool evaluateLinearAcceleration(const std::vector<Time>& times, SampleMatrix* accelerations) const;
+
+  void clear();
+
+ private:
+  /// Index of the interval [i, i+1] containing time, starting the search at hint.
+  bool findInterval(Time time, size_t hint, size_t* interval) const;
+
+  std::vector<Time> times_;
+  SampleMatrix positions_;
+  SampleMatrix velocities_;
+};
+
+} // namespace curves
@@ -13,9 +13,6 @@
 // curves
 #include "curves/polynomial_splines_traits.hpp"
 
-// stl
-#include <numeric>
-
 namespace curves {
 
 /*!
@@ -31,45 +28,49 @@ namespace curves {
  *
  *  where the vector tau (referred to as time vector in the comments) is define as
  *    tau = [t^n ... t^2 t 1]^T
+ *
+ *  Scalar_ is the type of the coefficients, times and evaluated values (e.g. double, float).
+ *
+ *  The class has no virtual functions and holds only the coefficients followed by the duration, so it is
+ *  trivially copyable and standard layout, and a list of splines is a dense array of n+2 scalars per spline.
  */
-template <int splineOrder_>
+template <int splineOrder_, typename Scalar_ = double>
 class PolynomialSpline {
  public:
 
   static constexpr unsigned int splineOrder = splineOrder_;
   static constexpr unsigned int coefficientCount = splineOrder + 1;
 
-  using SplineImplementation = spline_traits::spline_rep<double, splineOrder>;
+  using Scalar = Scalar_;
+  using SplineImplementation = spline_traits::spline_rep<Scalar_, splineOrder>;
   using SplineCoefficients = typename SplineImplementation::SplineCoefficients;
-  using EigenTimeVectorType = Eigen::Matrix<double, 1, coefficientCount>;
-  using EigenCoefficientVectorType = Eigen::Matrix<double, coefficientCount, 1>;
+  using EigenTimeVectorType = Eigen::Matrix<Scalar_, 1, coefficientCount>;
+  using EigenCoefficientVectorType = Eigen::Matrix<Scalar_, coefficientCount, 1>;
 
   PolynomialSpline() :
-    duration_(0.0),
-    didEvaluateCoeffs_(false),
-    coefficients_()
+    coefficients_(),
+    duration_(0.0)
   {
 
   }
 
   template<typename SplineCoeff_>
-  PolynomialSpline(SplineCoeff_&& coefficients, double duration) :
-    duration_(duration),
-    didEvaluateCoeffs_(true),
-    coefficients_(std::forward<SplineCoeff_>(coefficients))
+  PolynomialSpline(SplineCoeff_&& coefficients, Scalar_ duration) :
+    coefficients_(std::forward<SplineCoeff_>(coefficients)),
+    duration_(duration)
   {
 
   }
 
-  explicit PolynomialSpline(const SplineOptions& options) : duration_(options.tf_) {
+  explicit PolynomialSpline(const SplineOptions& options) : duration_(Scalar_(options.tf_)) {
     computeCoefficients(options);
   }
 
-  explicit PolynomialSpline(SplineOptions&& options) : duration_(options.tf_) {
+  explicit PolynomialSpline(SplineOptions&& options) : duration_(Scalar_(options.tf_)) {
     computeCoefficients(std::move(options));
   }
 
-  virtual ~PolynomialSpline() = default;
+  ~PolynomialSpline() = default;
 
   PolynomialSpline(PolynomialSpline &&) = default;
   PolynomialSpline& operator=(PolynomialSpline &&) = default;
@@ -90,45 +91,48 @@ class PolynomialSpline {
   //! Compute the coefficients of the spline.
   template<typename SplineOptionsType_>
   bool computeCoefficients(SplineOptionsType_&& options) {
-    duration_ = options.tf_;
+    duration_ = Scalar_(options.tf_);
     return SplineImplementation::compute(std::forward<SplineOptionsType_>(options), coefficients_);
   }
 
   //! Set the coefficients and the duration of the spline.
-  void setCoefficientsAndDuration(const SplineCoefficients& coefficients, double duration) {
+  void setCoefficientsAndDuration(const SplineCoefficients& coefficients, Scalar_ duration) {
     coefficients_ = coefficients;
     duration_ = duration;
   }
 
   //! Get the spline evaluated at time tk.
-  constexpr double getPositionAtTime(double tk) const {
-    return std::inner_product(coefficients_.begin(), coefficients_.end(),
-                              SplineImplementation::tau(tk).begin(), 0.0);
+  inline Scalar_ getPositionAtTime(Scalar_ tk) const {
+    return SplineImplementation::template evaluate<0>(coefficients_, tk);
   }
 
   //! Get the first derivative of the spline evaluated at time tk.
-  constexpr double getVelocityAtTime(double tk) const {
-    return std::inner_product(coefficients_.begin(), coefficients_.end(),
-                              SplineImplementation::dtau(tk).begin(), 0.0);
+  inline Scalar_ getVelocityAtTime(Scalar_ tk) const {
+    return SplineImplementation::template evaluate<1>(coefficients_, tk);
   }
 
   //! Get the second derivative of the spline evaluated at time tk.
-  constexpr double getAccelerationAtTime(double tk) const {
-    return std::inner_product(coefficients_.begin(), coefficients_.end(),
-                              SplineImplementation::ddtau(tk).begin(), 0.0);
+  inline Scalar_ getAccelerationAtTime(Scalar_ tk) const {
+    return SplineImplementation::template evaluate<2>(coefficients_, tk);
+  }
+
+  //! Get the k-th derivative of the spline evaluated at time tk, zero for k above the spline order.
+  template<unsigned int derivativeOrder>
+  inline Scalar_ getDerivativeAtTime(Scalar_ tk) const {
+    return SplineImplementation::template evaluate<derivativeOrder>(coefficients_, tk);
   }
 
 
 
 
   //! Get the time vector evaluated at time tk.
-  static inline void getTimeVector(Eigen::Ref<EigenTimeVectorType> timeVec, const double tk) {
+  static inline void getTimeVector(Eigen::Ref<EigenTimeVectorType> timeVec, const Scalar_ tk) {
     timeVec = Eigen::Map<EigenTimeVectorType>(SplineImplementation::tau(tk).data());
   }
 
   //! Get the time vector evaluated at time tk.
   template<typename Derived>
-  static inline void getTimeVector(Eigen::MatrixBase<Derived> const & timeVec, const double tk) {
+  static inline void getTimeVector(Eigen::MatrixBase<Derived> const & timeVec, const Scalar_ tk) {
     assert(timeVec.rows() == EigenTimeVectorType::RowsAtCompileTime &&
            timeVec.cols() == EigenTimeVectorType::ColsAtCompileTime);
     // https://eigen.tuxfamily.org/dox/TopicFunctionTakingEigenTypes.html
@@ -138,7 +142,7 @@ class PolynomialSpline {
 
   //! Get the time vector evaluated at time tk and add it to the input vector.
   template<typename Derived>
-  static inline void addTimeVector(Eigen::MatrixBase<Derived> const & timeVec, const double tk) {
+  static inline void addTimeVector(Eigen::MatrixBase<Derived> const & timeVec, const Scalar_ tk) {
     assert(timeVec.rows() == EigenTimeVectorType::RowsAtCompileTime &&
            timeVec.cols() == EigenTimeVectorType::ColsAtCompileTime);
     // https://eigen.tuxfamily.org/dox/TopicFunctionTakingEigenTypes.html
@@ -150,13 +154,13 @@ class PolynomialSpline {
 
 
   //! Get the first derivative of the time vector evaluated at time tk.
-  static inline void getDTimeVector(Eigen::Ref<EigenTimeVectorType> dtimeVec, const double tk) {
+  static inline void getDTimeVector(Eigen::Ref<EigenTimeVectorType> dtimeVec, const Scalar_ tk) {
     dtimeVec = Eigen::Map<EigenTimeVectorType>(SplineImplementation::dtau(tk).data());
   }
 
   //! Get the first derivative of the time vector evaluated at time tk.
   template<typename Derived>
-  static inline void getDiffTimeVector(Eigen::MatrixBase<Derived> const & dtimeVec, const double tk) {
+  static inline void getDiffTimeVector(Eigen::MatrixBase<Derived> const & dtimeVec, const Scalar_ tk) {
     assert(dtimeVec.rows() == EigenTimeVectorType::RowsAtCompileTime &&
            dtimeVec.cols() == EigenTimeVectorType::ColsAtCompileTime);
     // https://eigen.tuxfamily.org/dox/TopicFunctionTakingEigenTypes.html
@@ -166,7 +170,7 @@ class PolynomialSpline {
 
   //! Get the first derivative of the time vector evaluated at time tk and add it to the input vector.
   template<typename Derived>
-  static inline void addDiffTimeVector(Eigen::MatrixBase<Derived> const & dtimeVec, const double tk) {
+  static inline void addDiffTimeVector(Eigen::MatrixBase<Derived> const & dtimeVec, const Scalar_ tk) {
     assert(dtimeVec.rows() == EigenTimeVectorType::RowsAtCompileTime &&
            dtimeVec.cols() == EigenTimeVectorType::ColsAtCompileTime);
     // https://eigen.tuxfamily.org/dox/TopicFunctionTakingEigenTypes.html
@@ -177,23 +181,23 @@ class PolynomialSpline {
 
 
   //! Get the second derivative of the time vector evaluated at time tk.
-  static inline void getDDTimeVector(Eigen::Ref<EigenTimeVectorType> ddtimeVec, const double tk) {
+  static inline void getDDTimeVector(Eigen::Ref<EigenTimeVectorType> ddtimeVec, const Scalar_ tk) {
     ddtimeVec = Eigen::Map<EigenTimeVectorType>(SplineImplementation::ddtau(tk).data());
   }
 
   //! Get the second derivative of the time vector evaluated at time tk.
   template<typename Derived>
-  static inline void getDDiffTimeVector(Eigen::MatrixBase<Derived> const & ddtimeVec, const double tk) {
+  static inline void getDDiffTimeVector(Eigen::MatrixBase<Derived> const & ddtimeVec, const Scalar_ tk) {
     assert(ddtimeVec.rows() == EigenTimeVectorType::RowsAtCompileTime &&
            ddtimeVec.cols() == EigenTimeVectorType::ColsAtCompileTime);
     // https://eigen.tuxfamily.org/dox/TopicFunctionTakingEigenTypes.html
     const_cast<Eigen::MatrixBase<Derived>&>(ddtimeVec) =
-        Eigen::Map<const EigenTimeVectorType>((SplineImplementation::dtau(tk)).data());
+        Eigen::Map<const EigenTimeVectorType>((SplineImplementation::ddtau(tk)).data());
   }
 
   //! Get the second derivative of the time vector evaluated at time tk and add it to the input vector.
   template<typename Derived>
-  static inline void addDDiffTimeVector(Eigen::MatrixBase<Derived> const & ddtimeVec, const double tk) {
+  static inline void addDDiffTimeVector(Eigen::MatrixBase<Derived> const & ddtimeVec, const Scalar_ tk) {
     assert(ddtimeVec.rows() == EigenTimeVectorType::RowsAtCompileTime &&
            ddtimeVec.cols() == EigenTimeVectorType::ColsAtCompileTime);
     // https://eigen.tuxfamily.org/dox/TopicFunctionTakingEigenTypes.html
@@ -205,7 +209,7 @@ class PolynomialSpline {
 
   //! Get the time vector evaluated at zero.
   static inline void getTimeVectorAtZero(Eigen::Ref<EigenTimeVectorType> timeVec) {
-    timeVec = Eigen::Map<const EigenTimeVectorType>((SplineImplementation::tauZero).data());
+    timeVec = Eigen::Map<const EigenTimeVectorType>(SplineImplementation::tauZero().data());
   }
 
   //! Get the time vector evaluated at zero.
@@ -216,7 +220,7 @@ class PolynomialSpline {
            timeVec.cols() == EigenTimeVectorType::ColsAtCompileTime);
     // https://eigen.tuxfamily.org/dox/TopicFunctionTakingEigenTypes.html
     const_cast<Eigen::MatrixBase<Derived>&>(timeVec) =
-        Eigen::Map<const EigenTimeVectorType>((SplineImplementation::tauZero).data());
+        Eigen::Map<const EigenTimeVectorType>(SplineImplementation::tauZero().data());
   }
 
   //! Get the time vector evaluated at zero.
@@ -227,7 +231,7 @@ class PolynomialSpline {
            timeVec.cols() == EigenTimeVectorType::ColsAtCompileTime);
     // https://eigen.tuxfamily.org/dox/TopicFunctionTakingEigenTypes.html
     const_cast<Eigen::MatrixBase<Derived>&>(timeVec) +=
-        Eigen::Map<const EigenTimeVectorType>((SplineImplementation::tauZero).data());
+        Eigen::Map<const EigenTimeVectorType>(SplineImplementation::tauZero().data());
   }
 
 
@@ -235,7 +239,7 @@ class PolynomialSpline {
 
   //! Get the first derivative of the time vector evaluated at zero.
   static inline void getDTimeVectorAtZero(Eigen::Ref<EigenTimeVectorType> dtimeVec) {
-    dtimeVec = Eigen::Map<const EigenTimeVectorType>((SplineImplementation::dtauZero).data());
+    dtimeVec = Eigen::Map<const EigenTimeVectorType>(SplineImplementation::dtauZero().data());
   }
 
   //! Get the time vector evaluated at zero.
@@ -246,7 +250,7 @@ class PolynomialSpline {
            dtimeVec.cols() == EigenTimeVectorType::ColsAtCompileTime);
     // https://eigen.tuxfamily.org/dox/TopicFunctionTakingEigenTypes.html
     const_cast<Eigen::MatrixBase<Derived>&>(dtimeVec) =
-        Eigen::Map<const EigenTimeVectorType>((SplineImplementation::dtauZero).data());
+        Eigen::Map<const EigenTimeVectorType>(SplineImplementation::dtauZero().data());
   }
 
   //! Get the time vector evaluated at zero.
@@ -257,13 +261,13 @@ class PolynomialSpline {
            dtimeVec.cols() == EigenTimeVectorType::ColsAtCompileTime);
     // https://eigen.tuxfamily.org/dox/TopicFunctionTakingEigenTypes.html
     const_cast<Eigen::MatrixBase<Derived>&>(dtimeVec) +=
-        Eigen::Map<const EigenTimeVectorType>((SplineImplementation::dtauZero).data());
+        Eigen::Map<const EigenTimeVectorType>(SplineImplementation::dtauZero().data());
   }
 
 
   //! Get the second derivative of the time vector evaluated at zero.
   static inline void getDDTimeVectorAtZero(Eigen::Ref<EigenTimeVectorType> ddtimeVec) {
-    ddtimeVec = Eigen::Map<const EigenTimeVectorType>((SplineImplementation::ddtauZero).data());
+    ddtimeVec = Eigen::Map<const EigenTimeVectorType>(SplineImplementation::ddtauZero().data());
   }
 
   //! Get the time vector evaluated at zero.
@@ -274,7 +278,7 @@ class PolynomialSpline {
            ddtimeVec.cols() == EigenTimeVectorType::ColsAtCompileTime);
     // https://eigen.tuxfamily.org/dox/TopicFunctionTakingEigenTypes.html
     const_cast<Eigen::MatrixBase<Derived>&>(ddtimeVec) =
-        Eigen::Map<const EigenTimeVectorType>((SplineImplementation::ddtauZero).data());
+        Eigen::Map<const EigenTimeVectorType>(SplineImplementation::ddtauZero().data());
   }
 
   //! Get the time vector evaluated at zero.
@@ -285,26 +289,36 @@ class PolynomialSpline {
            ddtimeVec.cols() == EigenTimeVectorType::ColsAtCompileTime);
     // https://eigen.tuxfamily.org/dox/TopicFunctionTakingEigenTypes.html
     const_cast<Eigen::MatrixBase<Derived>&>(ddtimeVec) +=
-        Eigen::Map<const EigenTimeVectorType>((SplineImplementation::ddtauZero).data());
+        Eigen::Map<const EigenTimeVectorType>(SplineImplementation::ddtauZero().data());
   }
 
   //! Get the duration of the spline in seconds.
-  double getSplineDuration() const {
+  Scalar_ getSplineDuration() const {
     return duration_;
   }
 
  protected:
-  //! The duration of the spline in seconds.
-  double duration_;
-
-  //! True if the coefficents were computed at least once.
-  bool didEvaluateCoeffs_;
-
   /*
    * s(t) = an*t^n + ... + a1*t + a0
    * splineCoeff_ = [an ... a1 a0]
    */
   SplineCoefficients coefficients_;
+
+  //! The duration of the spline in seconds.
+  Scalar_ duration_;
 };
 
+// Explicitly instantiated in PolynomialSpline.cpp.
+extern template class PolynomialSpline<1, float>;
+extern template class PolynomialSpline<2, float>;
+extern template class PolynomialSpline<3, float>;
+extern template class PolynomialSpline<4, float>;
+extern template class PolynomialSpline<5, float>;
+extern template class PolynomialSpline<1, double>;
+extern template class PolynomialSpline<2, double>;
+extern template class PolynomialSpline<3, double>;
+extern template class PolynomialSpline<4, double>;
+extern template class PolynomialSpline<5, double>;
+extern template class PolynomialSpline<7, double>;
+
 } /* namespace */
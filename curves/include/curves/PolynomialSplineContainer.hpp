@@ -13,41 +13,53 @@
 #include <Eigen/Dense>
 
 // std
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <initializer_list>
 #include <iostream>
 #include <memory>
 #include <limits>
+#include <vector>
 
 // boost
 #include <boost/math/special_functions/pow.hpp>
+#include <boost/thread.hpp>
 
 namespace curves {
 
-template <int splineOrder_>
+template <int splineOrder_, typename Scalar_ = double>
 class PolynomialSplineContainer {
  public:
-  using SplineType = PolynomialSpline<splineOrder_>;
-  using SplineList = std::vector<SplineType>;
+  using Scalar = Scalar_;
+  using SplineType = PolynomialSpline<splineOrder_, Scalar_>;
+  using SplineList = std::vector<SplineType, Eigen::aligned_allocator<SplineType>>;
+  using VectorX = Eigen::Matrix<Scalar_, Eigen::Dynamic, 1>;
+  using MatrixX = Eigen::Matrix<Scalar_, Eigen::Dynamic, Eigen::Dynamic>;
 
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
   PolynomialSplineContainer();
   virtual ~PolynomialSplineContainer() = default;
 
-  //! Get a pointer to the spline with a given index.
+  //! Get a pointer to the spline with a given index, nullptr if the deferred solve fails.
   SplineType* getSpline(int splineIndex);
 
   //! Get a reference to the spline with a given index.
   const SplineList& getSplines() const;
 
   //! Update the spline internal time by dt [seconds].
-  bool advance(double dt);
+  bool advance(Scalar_ dt);
 
-  //! Jump to a specific point in time domain.
-  void setContainerTime(double t);
+  //! Jump to a specific point in time domain, false if the deferred solve fails.
+  bool setContainerTime(Scalar_ t);
 
   //! Add a spline to the container.
   template<typename SplineType_>
   bool addSpline(SplineType_&& spline) {
+    if (!finalize()) {
+      return false;
+    }
     containerDuration_ += spline.getSplineDuration();
     splines_.emplace_back(std::forward<SplineType_>(spline));
     return true;
@@ -63,80 +75,217 @@ class PolynomialSplineContainer {
   bool resetTime();
 
   //! Get total trajectory duration.
-  double getContainerDuration() const;
+  Scalar_ getContainerDuration() const;
 
   //! Get currently active time point.
-  double getContainerTime() const;
+  Scalar_ getContainerTime() const;
 
   //! True if splines are empty.
   bool isEmpty() const;
 
   //! Get the position evaluated at the internal time.
-  double getPosition() const;
+  Scalar_ getPosition() const;
 
   //! Get the velocity evaluated at the internal time.
-  double getVelocity() const;
+  Scalar_ getVelocity() const;
 
   //! Get the acceleration evaluated at the internal time.
-  double getAcceleration() const;
+  Scalar_ getAcceleration() const;
 
   /*! Get the index of the spline active at time t [seconds].
    *  Update timeOffset with the duration of the container at the beginning of the active spline.
    */
-  int getActiveSplineIndexAtTime(double t, double& timeOffset) const;
+  int getActiveSplineIndexAtTime(Scalar_ t, Scalar_& timeOffset) const;
 
   //! Return spline index at current time validity.
   int getActiveSplineIndex() const;
 
   //! Get position at time t[seconds];
-  double getPositionAtTime(double t) const;
+  Scalar_ getPositionAtTime(Scalar_ t) const;
 
   //! Get velocity at time t[seconds];
-  double getVelocityAtTime(double t) const;
+  Scalar_ getVelocityAtTime(Scalar_ t) const;
 
   //! Get acceleration at time t[seconds];
-  double getAccelerationAtTime(double t) const;
+  Scalar_ getAccelerationAtTime(Scalar_ t) const;
 
   //! Get position at the end of the spline.
-  double getEndPosition() const;
+  Scalar_ getEndPosition() const;
 
   //! Get velocity at the end of the spline.
-  double getEndVelocity() const;
+  Scalar_ getEndVelocity() const;
 
   //! Get acceleration at the end of the spline.
-  double getEndAcceleration() const;
+  Scalar_ getEndAcceleration() const;
 
   /*!
    * Minimize spline coefficients s.t. position, velocity and acceleration constraints are satisfied
    * (i.e., s.t. the spline conjunction is smooth up the second derivative).
    */
   bool setData(
-      const std::vector<double>& knotDurations,
-      const std::vector<double>& knotPositions,
-      double initialVelocity, double initialAcceleration,
-      double finalVelocity, double finalAcceleration);
+      const std::vector<Scalar_>& knotDurations,
+      const std::vector<Scalar_>& knotPositions,
+      Scalar_ initialVelocity, Scalar_ initialAcceleration,
+      Scalar_ finalVelocity, Scalar_ finalAcceleration);
 
   /*!
    * Minimize spline coefficients s.t. position and velocity constraints are satisfied
    * (i.e., s.t. the spline conjunction is smooth up the first derivative).
    */
   bool setData(
-      const std::vector<double>& knotDurations,
-      const std::vector<double>& knotPositions,
-      double initialVelocity, double finalVelocity);
+      const std::vector<Scalar_>& knotDurations,
+      const std::vector<Scalar_>& knotPositions,
+      Scalar_ initialVelocity, Scalar_ finalVelocity);
+
+  /*!
+   * Minimize spline coefficients of several containers sharing the same knot durations, one per
+   * column of knotPositions (one row per knot), with the constraints of the setData above.
+   * The equality constraint matrix only depends on the knot durations, therefore it is built and
+   * factorized once and all containers are solved as one multi-column right-hand side.
+   */
+  static bool setData(
+      const std::vector<Scalar_>& knotDurations,
+      const MatrixX& knotPositions,
+      const VectorX& initialVelocities, const VectorX& initialAccelerations,
+      const VectorX& finalVelocities, const VectorX& finalAccelerations,
+      std::vector<PolynomialSplineContainer>* containers);
 
   /*!
    * Find linear part of the spline coefficients (a0, a1) s.t. position constraints are satisfied.
    * If the spline order is larger than 1, the remaining spline coefficients are set to zero.
    */
   virtual bool setData(
-      const std::vector<double>& knotDurations,
-      const std::vector<double>& knotPositions);
+      const std::vector<Scalar_>& knotDurations,
+      const std::vector<Scalar_>& knotPositions);
+
+  /*!
+   * Local construction, each spline only depends on the two knots it connects. Cubic Hermite
+   * splines s.t. positions and velocities are matched at the knots (spline order >= 3).
+   */
+  bool setDataHermite(
+      const std::vector<Scalar_>& knotDurations,
+      const std::vector<Scalar_>& knotPositions,
+      const std::vector<Scalar_>& knotVelocities);
+
+  /*!
+   * Local construction, quintic Hermite splines s.t. positions, velocities and accelerations are
+   * matched at the knots (spline order >= 5).
+   */
+  bool setDataHermite(
+      const std::vector<Scalar_>& knotDurations,
+      const std::vector<Scalar_>& knotPositions,
+      const std::vector<Scalar_>& knotVelocities,
+      const std::vector<Scalar_>& knotAccelerations);
+
+  /*!
+   * Local construction, shape preserving cubic Hermite splines (PCHIP) with velocities estimated
+   * by Fritsch-Carlson from the neighboring knots. The curve is monotonic where the knots are.
+   */
+  bool setDataPchip(
+      const std::vector<Scalar_>& knotDurations,
+      const std::vector<Scalar_>& knotPositions);
+
+  /*!
+   * Local construction, cubic Hermite splines with the velocities estimated by Akima from the
+   * slopes of the two neighboring splines on each side. Avoids overshoots at outliers.
+   */
+  bool setDataAkima(
+      const std::vector<Scalar_>& knotDurations,
+      const std::vector<Scalar_>& knotPositions);
+
+  /*!
+   * Minimum-derivative trajectory through the knot positions, minimizes the integral of the squared
+   * derivativeOrder-th derivative (3: minimum jerk, 4: minimum snap). The spline order has to be at
+   * least 2*derivativeOrder-1. The first derivatives at the first and the last knot, up to
+   * derivativeOrder-1, can be given by initialDerivatives and finalDerivatives. The remaining ones
+   * are free and get the natural boundary conditions, e.g. zero acceleration at a free end for
+   * minimum acceleration (natural cubic splines). Pass zeros for a start or stop at rest.
+   * The optimal splines are Hermite splines with continuous derivatives up to 2*derivativeOrder-2,
+   * the unknown knot derivatives are found with a block tridiagonal solve of the optimality
+   * conditions in O(n).
+   */
+  bool setDataMinimumDerivative(
+      const std::vector<Scalar_>& knotDurations,
+      const std::vector<Scalar_>& knotPositions,
+      unsigned int derivativeOrder,
+      const std::vector<Scalar_>& initialDerivatives = std::vector<Scalar_>(),
+      const std::vector<Scalar_>& finalDerivatives = std::vector<Scalar_>());
+
+  /*!
+   * Periodic cubic splines through the knots with continuous position, velocity and acceleration,
+   * also across the wrap-around from the last to the first knot (spline order >= 3). The last knot
+   * closes the period, its position has to be equal to the first one. The second derivatives at the
+   * knots are found with a cyclic tridiagonal solve in O(n). The container is evaluated with the
+   * time wrapped into the period and advance() loops it. If the fit fails after the knots were
+   * accepted, the container is left empty and not periodic.
+   */
+  bool setDataPeriodic(
+      const std::vector<Scalar_>& knotDurations,
+      const std::vector<Scalar_>& knotPositions);
+
+  /*!
+   * Natural cubic smoothing splines (spline order >= 3) which minimize
+   *    sum((knotPositions_i - s(t_i))^2) + smoothingParameter * integral(s''(t)^2)
+   * for noisy knot positions, solved with the Reinsch algorithm in O(n). A smoothing parameter
+   * of zero interpolates the knots, large values approach the least-squares line.
+   */
+  bool setDataSmoothing(
+      const std::vector<Scalar_>& knotDurations,
+      const std::vector<Scalar_>& knotPositions,
+      Scalar_ smoothingParameter);
 
-  static constexpr double undefinedValue = std::numeric_limits<double>::quiet_NaN();
+  /*!
+   * Natural cubic smoothing splines with the smoothing parameter which minimizes the generalized
+   * cross-validation score, each score is evaluated in O(n).
+   * @param smoothingParameter if not null, set to the selected smoothing parameter.
+   */
+  bool setDataSmoothingGcv(
+      const std::vector<Scalar_>& knotDurations,
+      const std::vector<Scalar_>& knotPositions,
+      Scalar_* smoothingParameter = nullptr);
+
+  //! True if the container was set with setDataPeriodic.
+  bool isPeriodic() const;
+
+  static constexpr Scalar_ undefinedValue = std::numeric_limits<Scalar_>::quiet_NaN();
 
   bool checkContainer() const;
 
+  /*!
+   * Number of setData calls which reused the stored factorization of the equality matrix.
+   * It is reused while the spline durations (differences of the knot durations, compared exactly)
+   * and the boundary conditions stay the same, the solve is then a back-substitution with the
+   * new knot positions.
+   */
+  unsigned int getFactorizationCacheHits() const;
+
+  //! Number of setData calls which had to factorize the equality matrix.
+  unsigned int getFactorizationCacheMisses() const;
+
+  //! Drop the stored factorization and reset the counters.
+  void clearFactorizationCache();
+
+  /*!
+   * Defer the solve of setData. The setData overloads of a single container then only record the knots
+   * and boundary conditions, after checking the knots. The coefficients are solved by finalize(), which
+   * returns the errors of the solve, or on the first evaluation. The non-const advance(),
+   * setContainerTime(), getSpline() and addSpline() return the errors of the solve, the const
+   * accessors log them and read an empty container. As the first read solves in place, a container
+   * with a pending solve must only be read by one thread, call finalize() before sharing it.
+   * Recording again replaces the pending data, so candidates which are never evaluated are never solved.
+   * The other setData modes and reset() drop pending data.
+   */
+  void setDeferredSolve(bool deferSolve);
+
+  //! True if setData only records its inputs.
+  bool isSolveDeferred() const;
+
+  //! True if setData inputs were recorded and not solved yet.
+  bool hasPendingSolve() const;
+
+  //! Solve the recorded setData inputs, if any.
+  bool finalize();
+
  protected:
   /*!
    * aijh:
@@ -155,49 +304,172 @@ class PolynomialSplineContainer {
     return getCoeffIndex(splineIdx, 0);
   }
 
+  //! Rows of the equality matrix, one per condition, in the order of addConstraintTargetValues.
   void addInitialConditions(
-      const Eigen::VectorXd& initialConditions,
+      const MatrixX& initialConditions,
       unsigned int& constraintIdx);
 
   void addFinalConditions(
-      const Eigen::VectorXd& finalConditions,
+      const MatrixX& finalConditions,
       unsigned int& constraintIdx,
-      const double lastSplineDuration,
+      const Scalar_ lastSplineDuration,
       const unsigned int lastSplineId);
 
   void addJunctionsConditions(
-      const std::vector<double>& splineDurations,
-      const std::vector<double>& knotPositions,
+      const std::vector<Scalar_>& splineDurations,
       unsigned int& constraintIdx,
       const unsigned int num_junctions);
 
+  //! Target values of the equality constraints. Conditions have one row per derivative and
+  //! one column per right-hand side.
+  void addConstraintTargetValues(
+      const MatrixX& initialConditions,
+      const MatrixX& finalConditions,
+      const MatrixX& knotPositions,
+      const unsigned int num_junctions);
+
+  /*!
+   * Fill the equality constraints for the given conditions (one column per right-hand side) and
+   * solve them, factorizing the equality matrix only if it is not the cached one.
+   */
+  bool solveEqualityConstraints(
+      const std::vector<Scalar_>& splineDurations,
+      const MatrixX& knotPositions,
+      const MatrixX& initialConditions,
+      const MatrixX& finalConditions,
+      MatrixX& coeffs);
+
+  //! Splines from given knot derivatives, knotAccelerations is null for cubic Hermite splines.
+  bool setHermiteSplines(
+      const std::vector<Scalar_>& knotDurations,
+      const std::vector<Scalar_>& knotPositions,
+      const std::vector<Scalar_>& knotVelocities,
+      const std::vector<Scalar_>* knotAccelerations);
+
+  //! Sets the coefficients of the splines [beginSplineId, endSplineId), the durations are positive.
+  void setHermiteSplineRange(
+      unsigned int beginSplineId,
+      unsigned int endSplineId,
+      unsigned int hermiteOrder,
+      const std::vector<Scalar_>& knotDurations,
+      const std::vector<Scalar_>& knotPositions,
+      const std::vector<Scalar_>& knotVelocities,
+      const std::vector<Scalar_>* knotAccelerations);
+
+  //! Time t wrapped into [0, containerDuration_) for periodic containers.
+  Scalar_ getWrappedTime(Scalar_ t) const;
+
+  //! Add cubic splines with given positions and second derivatives at the knots.
+  bool addCubicSplines(
+      const VectorX& durations,
+      const VectorX& knotPositions,
+      const VectorX& knotAccelerations);
+
+  //! Check the smoothing spline inputs and get the spline durations.
+  static bool getSmoothingDurations(
+      const std::vector<Scalar_>& knotDurations,
+      const std::vector<Scalar_>& knotPositions,
+      VectorX& durations);
+
+  /*!
+   * Smoothed knot values and knot second derivatives of the smoothing spline.
+   * @param gcvScore if not null, set to the generalized cross-validation score.
+   */
+  static bool solveSmoothing(
+      const VectorX& durations,
+      const VectorX& knotPositions,
+      Scalar_ smoothingParameter,
+      VectorX& knotValues,
+      VectorX& knotAccelerations,
+      Scalar_* gcvScore);
+
+  /*!
+   * Solve the cyclic tridiagonal system lower(i)*x(i-1) + diagonal(i)*x(i) + upper(i)*x(i+1) = rhs(i),
+   * with x(-1) = x(n-1) and x(n) = x(0), by the Sherman-Morrison formula.
+   */
+  static bool solveCyclicTridiagonal(
+      const VectorX& lower, const VectorX& diagonal, const VectorX& upper,
+      const VectorX& rhs, VectorX& x);
+
   bool extractSplineCoefficients(
-      const Eigen::VectorXd& coeffs,
-      const std::vector<double>& splineDurations,
+      const VectorX& coeffs,
+      const std::vector<Scalar_>& splineDurations,
       const unsigned int num_splines);
 
+  //! Record the inputs of a deferred setData, boundaryConditions are {}, {v0, vT} or {v0, a0, vT, aT}.
+  //! Returns false for too few knots or non-positive durations.
+  bool recordPendingSolve(
+      const std::vector<Scalar_>& knotDurations,
+      const std::vector<Scalar_>& knotPositions,
+      std::initializer_list<Scalar_> boundaryConditions);
+
+  //! Solve the recorded setData inputs on the first read of the const accessors, logs a failed solve.
+  bool finalizeOnRead() const;
+
   //! Conjunction of smoothly interconnected splines.
   SplineList splines_;
 
   //! Helper variable.
-  double timeOffset_;
+  Scalar_ timeOffset_;
 
   //! Current time of spline conjunction.
-  double containerTime_;
+  Scalar_ containerTime_;
 
   //! Total duration of spline conjunction.
-  double containerDuration_;
+  Scalar_ containerDuration_;
 
   //! Spline index currently active.
   int activeSplineIdx_;
 
+  //! True if the splines form one period of a periodic curve.
+  bool isPeriodic_;
+
   //! Equality matrix of quadratic program (A in Ax=b).
-  Eigen::MatrixXd equalityConstraintJacobian_;
+  MatrixX equalityConstraintJacobian_;
+
+  //! Equality target values of quatratic program (b in Ax=b), one column per right-hand side.
+  MatrixX equalityConstraintTargetValues_;
+
+  //! Factorization of the equality matrix.
+  Eigen::ColPivHouseholderQR<MatrixX> equalityConstraintFactorization_;
+
+  //! Spline durations and number of boundary conditions the factorization belongs to.
+  std::vector<Scalar_> factorizedSplineDurations_;
+  int factorizedNumConditions_;
 
-  //! Equality target values of quatratic program (b in Ax=b).
-  Eigen::VectorXd equalityConstraintTargetValues_;
+  //! Factorization cache statistics.
+  unsigned int factorizationCacheHits_;
+  unsigned int factorizationCacheMisses_;
+
+  //! True if setData only records its inputs.
+  bool isSolveDeferred_;
+
+  //! True if the recorded setData inputs were not solved yet.
+  bool hasPendingSolve_;
+
+  //! Recorded setData inputs.
+  std::vector<Scalar_> pendingKnotDurations_;
+  std::vector<Scalar_> pendingKnotPositions_;
+  std::vector<Scalar_> pendingBoundaryConditions_;
 };
 
 } /* namespace */
 
 #include <curves/PolynomialSplineContainer.tpp>
+
+namespace curves {
+
+// Explicitly instantiated in PolynomialSplineContainer.cpp.
+extern template class PolynomialSplineContainer<1, float>;
+extern template class PolynomialSplineContainer<2, float>;
+extern template class PolynomialSplineContainer<3, float>;
+extern template class PolynomialSplineContainer<4, float>;
+extern template class PolynomialSplineContainer<5, float>;
+extern template class PolynomialSplineContainer<1, double>;
+extern template class PolynomialSplineContainer<2, double>;
+extern template class PolynomialSplineContainer<3, double>;
+extern template class PolynomialSplineContainer<4, double>;
+extern template class PolynomialSplineContainer<5, double>;
+extern template class PolynomialSplineContainer<7, double>;
+
+} /* namespace */
@@ -9,40 +9,64 @@
 namespace curves {
 
 
-template <int splineOrder_>
-PolynomialSplineContainer<splineOrder_>::PolynomialSplineContainer():
+template <int splineOrder_, typename Scalar_>
+PolynomialSplineContainer<splineOrder_, Scalar_>::PolynomialSplineContainer():
     timeOffset_(0.0),
     containerTime_(0.0),
     containerDuration_(0.0),
     activeSplineIdx_(0),
+    isPeriodic_(false),
     equalityConstraintJacobian_(),
-    equalityConstraintTargetValues_()
+    equalityConstraintTargetValues_(),
+    equalityConstraintFactorization_(),
+    factorizedSplineDurations_(),
+    factorizedNumConditions_(0),
+    factorizationCacheHits_(0u),
+    factorizationCacheMisses_(0u),
+    isSolveDeferred_(false),
+    hasPendingSolve_(false),
+    pendingKnotDurations_(),
+    pendingKnotPositions_(),
+    pendingBoundaryConditions_()
 {
   // Make sure that the container is correctly emptied.
   reset();
 }
 
-template <int splineOrder_>
-typename PolynomialSplineContainer<splineOrder_>::SplineType* PolynomialSplineContainer<splineOrder_>::getSpline(int splineIndex)
+template <int splineOrder_, typename Scalar_>
+typename PolynomialSplineContainer<splineOrder_, Scalar_>::SplineType* PolynomialSplineContainer<splineOrder_, Scalar_>::getSpline(int splineIndex)
 {
+  if (!finalize()) {
+    return nullptr;
+  }
   return &splines_.at(splineIndex);
 }
 
-template <int splineOrder_>
-const typename PolynomialSplineContainer<splineOrder_>::SplineList& PolynomialSplineContainer<splineOrder_>::getSplines() const {
+template <int splineOrder_, typename Scalar_>
+const typename PolynomialSplineContainer<splineOrder_, Scalar_>::SplineList& PolynomialSplineContainer<splineOrder_, Scalar_>::getSplines() const {
+  finalizeOnRead();
   return splines_;
 }
 
-template <int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::advance(double dt)
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::advance(Scalar_ dt)
 {
-  if (splines_.empty() || containerTime_ >= containerDuration_) {
+  if (!finalize()) {
+    return false;
+  }
+  if (splines_.empty() || (!isPeriodic_ && containerTime_ >= containerDuration_)) {
     return false;
   }
 
   // Advance in time.
   containerTime_ += dt;
 
+  // Periodic containers start the next period.
+  if (isPeriodic_ && containerTime_ >= containerDuration_) {
+    setContainerTime(getWrappedTime(containerTime_));
+    return true;
+  }
+
   // Check if spline index needs to be increased.
   if ((containerTime_ - timeOffset_ >= splines_[activeSplineIdx_].getSplineDuration())) {
     if (activeSplineIdx_ < (splines_.size() - 1)) {
@@ -55,73 +79,85 @@ bool PolynomialSplineContainer<splineOrder_>::advance(double dt)
   return true;
 }
 
-template <int splineOrder_>
-void PolynomialSplineContainer<splineOrder_>::setContainerTime(double t)
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setContainerTime(Scalar_ t)
 {
+  if (!finalize()) {
+    return false;
+  }
   containerTime_ = t;
   activeSplineIdx_ = getActiveSplineIndexAtTime(t, timeOffset_);
+  return true;
 }
 
-template <int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::reset()
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::reset()
 {
   splines_.clear();
   activeSplineIdx_ = 0;
-  containerDuration_ = 0.0;
+  containerDuration_ = Scalar_(0.0);
+  isPeriodic_ = false;
+  hasPendingSolve_ = false;
   resetTime();
   return true;
 }
 
-template <int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::resetTime()
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::resetTime()
 {
-  timeOffset_ = 0.0;
-  containerTime_ = 0.0;
+  timeOffset_ = Scalar_(0.0);
+  containerTime_ = Scalar_(0.0);
   activeSplineIdx_ = 0;
   return true;
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getContainerDuration() const
+template <int splineOrder_, typename Scalar_>
+Scalar_ PolynomialSplineContainer<splineOrder_, Scalar_>::getContainerDuration() const
 {
+  finalizeOnRead();
   return containerDuration_;
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getContainerTime() const
+template <int splineOrder_, typename Scalar_>
+Scalar_ PolynomialSplineContainer<splineOrder_, Scalar_>::getContainerTime() const
 {
   return containerTime_;
 }
 
-template <int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::isEmpty() const
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::isEmpty() const
 {
+  finalizeOnRead();
   return splines_.empty();
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getPosition() const
+template <int splineOrder_, typename Scalar_>
+Scalar_ PolynomialSplineContainer<splineOrder_, Scalar_>::getPosition() const
 {
-  if (splines_.empty()) { return 0.0; }
+  finalizeOnRead();
+  if (splines_.empty()) { return Scalar_(0.0); }
   return splines_[activeSplineIdx_].getPositionAtTime(containerTime_ - timeOffset_);
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getVelocity() const {
-  if (splines_.empty()) { return 0.0; }
+template <int splineOrder_, typename Scalar_>
+Scalar_ PolynomialSplineContainer<splineOrder_, Scalar_>::getVelocity() const {
+  finalizeOnRead();
+  if (splines_.empty()) { return Scalar_(0.0); }
   return splines_[activeSplineIdx_].getVelocityAtTime(containerTime_ - timeOffset_);
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getAcceleration() const
+template <int splineOrder_, typename Scalar_>
+Scalar_ PolynomialSplineContainer<splineOrder_, Scalar_>::getAcceleration() const
 {
-  if (splines_.empty()) { return 0.0; }
+  finalizeOnRead();
+  if (splines_.empty()) { return Scalar_(0.0); }
   return splines_[activeSplineIdx_].getAccelerationAtTime(containerTime_ - timeOffset_);
 }
 
-template <int splineOrder_>
-int PolynomialSplineContainer<splineOrder_>::getActiveSplineIndexAtTime(double t, double& timeOffset) const {
-  timeOffset = 0.0;
+template <int splineOrder_, typename Scalar_>
+int PolynomialSplineContainer<splineOrder_, Scalar_>::getActiveSplineIndexAtTime(Scalar_ t, Scalar_& timeOffset) const {
+  finalizeOnRead();
+  timeOffset = Scalar_(0.0);
   if (splines_.empty()) { return -1; }
 
   for (size_t i = 0; i < splines_.size(); ++i) {
@@ -136,89 +172,102 @@ int PolynomialSplineContainer<splineOrder_>::getActiveSplineIndexAtTime(double t
   return (splines_.size() - 1);
 }
 
-template <int splineOrder_>
-int PolynomialSplineContainer<splineOrder_>::getActiveSplineIndex() const {
+template <int splineOrder_, typename Scalar_>
+int PolynomialSplineContainer<splineOrder_, Scalar_>::getActiveSplineIndex() const {
   return activeSplineIdx_;
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getPositionAtTime(double t) const {
-  if (splines_.empty()) { return 0.0; }
-  double timeOffset = 0.0;
+template <int splineOrder_, typename Scalar_>
+Scalar_ PolynomialSplineContainer<splineOrder_, Scalar_>::getPositionAtTime(Scalar_ t) const {
+  finalizeOnRead();
+  if (splines_.empty()) { return Scalar_(0.0); }
+  t = getWrappedTime(t);
+  Scalar_ timeOffset = Scalar_(0.0);
   const int activeSplineIdx = getActiveSplineIndexAtTime(t, timeOffset);
 
   // Spline container is empty.
-  if (activeSplineIdx < 0) { return 0.0; }
+  if (activeSplineIdx < 0) { return Scalar_(0.0); }
 
   return splines_[activeSplineIdx].getPositionAtTime(t - timeOffset);
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getVelocityAtTime(double t) const
+template <int splineOrder_, typename Scalar_>
+Scalar_ PolynomialSplineContainer<splineOrder_, Scalar_>::getVelocityAtTime(Scalar_ t) const
 {
-  if (splines_.empty()) { return 0.0; }
-  double timeOffset = 0.0;
+  finalizeOnRead();
+  if (splines_.empty()) { return Scalar_(0.0); }
+  t = getWrappedTime(t);
+  Scalar_ timeOffset = Scalar_(0.0);
   const int activeSplineIdx = getActiveSplineIndexAtTime(t, timeOffset);
 
   // Spline container is empty.
-  if (activeSplineIdx < 0) { return 0.0; }
+  if (activeSplineIdx < 0) { return Scalar_(0.0); }
 
   return splines_[activeSplineIdx].getVelocityAtTime(t - timeOffset);
 }
 
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getAccelerationAtTime(double t) const
+template <int splineOrder_, typename Scalar_>
+Scalar_ PolynomialSplineContainer<splineOrder_, Scalar_>::getAccelerationAtTime(Scalar_ t) const
 {
-  if (splines_.empty()) { return 0.0; }
-  double timeOffset = 0.0;
+  finalizeOnRead();
+  if (splines_.empty()) { return Scalar_(0.0); }
+  t = getWrappedTime(t);
+  Scalar_ timeOffset = Scalar_(0.0);
   const int activeSplineIdx = getActiveSplineIndexAtTime(t, timeOffset);
 
   // Spline container is empty.
-  if (activeSplineIdx < 0) { return 0.0; }
+  if (activeSplineIdx < 0) { return Scalar_(0.0); }
 
   return splines_[activeSplineIdx].getAccelerationAtTime(t - timeOffset);
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getEndPosition() const {
+template <int splineOrder_, typename Scalar_>
+Scalar_ PolynomialSplineContainer<splineOrder_, Scalar_>::getEndPosition() const {
+  finalizeOnRead();
   if (splines_.empty()) {
     // Spline container is empty.
-    return 0.0;
+    return Scalar_(0.0);
   }
 
-  const double lastSplineDuration = splines_.back().getSplineDuration();
+  const Scalar_ lastSplineDuration = splines_.back().getSplineDuration();
   return splines_.back().getPositionAtTime(lastSplineDuration);
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getEndVelocity() const {
+template <int splineOrder_, typename Scalar_>
+Scalar_ PolynomialSplineContainer<splineOrder_, Scalar_>::getEndVelocity() const {
+  finalizeOnRead();
   if (splines_.empty()) {
     // Spline container is empty.
-    return 0.0;
+    return Scalar_(0.0);
   }
 
-  const double lastSplineDuration = splines_.back().getSplineDuration();
+  const Scalar_ lastSplineDuration = splines_.back().getSplineDuration();
   return splines_.back().getVelocityAtTime(lastSplineDuration);
 }
 
-template <int splineOrder_>
-double PolynomialSplineContainer<splineOrder_>::getEndAcceleration() const {
+template <int splineOrder_, typename Scalar_>
+Scalar_ PolynomialSplineContainer<splineOrder_, Scalar_>::getEndAcceleration() const {
+  finalizeOnRead();
   if (splines_.empty()) {
     // Spline container is empty.
-    return 0.0;
+    return Scalar_(0.0);
   }
 
-  const double lastSplineDuration = splines_.back().getSplineDuration();
+  const Scalar_ lastSplineDuration = splines_.back().getSplineDuration();
   return splines_.back().getAccelerationAtTime(lastSplineDuration);
 }
 
-template <int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::setData(
-    const std::vector<double>& knotDurations,
-    const std::vector<double>& knotPositions,
-    double initialVelocity, double initialAcceleration,
-    double finalVelocity, double finalAcceleration) {
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setData(
+    const std::vector<Scalar_>& knotDurations,
+    const std::vector<Scalar_>& knotPositions,
+    Scalar_ initialVelocity, Scalar_ initialAcceleration,
+    Scalar_ finalVelocity, Scalar_ finalAcceleration) {
+
+  if (isSolveDeferred_) {
+    return recordPendingSolve(knotDurations, knotPositions, {initialVelocity, initialAcceleration, finalVelocity, finalAcceleration});
+  }
 
   bool success = reset();
 
@@ -247,7 +296,7 @@ bool PolynomialSplineContainer<splineOrder_>::setData(
   }
 
   // Vector containing durations of splines.
-  std::vector<double> splineDurations(numSplines);
+  std::vector<Scalar_> splineDurations(numSplines);
   for (unsigned int splineId=0; splineId<numSplines; splineId++) {
     splineDurations[splineId] = knotDurations[splineId+1]-knotDurations[splineId];
 
@@ -257,45 +306,37 @@ bool PolynomialSplineContainer<splineOrder_>::setData(
     }
   }
 
-  // Initialize Equality matrices.
-  equalityConstraintJacobian_.setZero(num_constraints, solutionSpaceDimension);
-  equalityConstraintTargetValues_.setZero(num_constraints);
-  unsigned int constraintIdx = 0;
-
-
   // Initial conditions.
-  Eigen::VectorXd initialConditions(3);
+  MatrixX initialConditions(3, 1);
   initialConditions << knotPositions.front(), initialVelocity, initialAcceleration;
-  addInitialConditions(initialConditions, constraintIdx);
 
   // Final conditions.
-  Eigen::VectorXd finalConditions(3);
+  MatrixX finalConditions(3, 1);
   finalConditions << knotPositions.back(), finalVelocity, finalAcceleration;
-  addFinalConditions(finalConditions, constraintIdx, splineDurations.back(), num_junctions);
-
-  // Junction conditions.
-  addJunctionsConditions(splineDurations, knotPositions, constraintIdx, num_junctions);
 
-  if (num_constraints != constraintIdx) {
-    std::cout << "[PolynomialSplineContainer::setData] Wrong number of equality constraints!" << std::endl;
+  // Find spline coefficients.
+  MatrixX coeffs;
+  if (!solveEqualityConstraints(splineDurations, Eigen::Map<const VectorX>(knotPositions.data(), knotPositions.size()),
+                                initialConditions, finalConditions, coeffs)) {
     return false;
   }
 
-  // Find spline coefficients.
-  Eigen::VectorXd coeffs = equalityConstraintJacobian_.colPivHouseholderQr().solve(equalityConstraintTargetValues_);
-
   // Extract spline coefficients and add splines.
-  success &= extractSplineCoefficients(coeffs, splineDurations, numSplines);
+  success &= extractSplineCoefficients(coeffs.col(0), splineDurations, numSplines);
 
   return success;
 }
 
 
-template <int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::setData(
-    const std::vector<double>& knotDurations,
-    const std::vector<double>& knotPositions,
-    double initialVelocity, double finalVelocity) {
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setData(
+    const std::vector<Scalar_>& knotDurations,
+    const std::vector<Scalar_>& knotPositions,
+    Scalar_ initialVelocity, Scalar_ finalVelocity) {
+
+  if (isSolveDeferred_) {
+    return recordPendingSolve(knotDurations, knotPositions, {initialVelocity, finalVelocity});
+  }
 
   bool success = reset();
 
@@ -324,7 +365,7 @@ bool PolynomialSplineContainer<splineOrder_>::setData(
   }
 
   // Vector containing durations of splines.
-  std::vector<double> splineDurations(numSplines);
+  std::vector<Scalar_> splineDurations(numSplines);
   for (unsigned int splineId=0; splineId<numSplines; splineId++) {
     splineDurations[splineId] = knotDurations[splineId+1]-knotDurations[splineId];
 
@@ -334,44 +375,122 @@ bool PolynomialSplineContainer<splineOrder_>::setData(
     }
   }
 
-  // Initialize Equality matrices.
-  equalityConstraintJacobian_.setZero(num_constraints, solutionSpaceDimension);
-  equalityConstraintTargetValues_.setZero(num_constraints);
-  unsigned int constraintIdx = 0;
-
-
   // Initial conditions.
-  Eigen::VectorXd initialConditions(2);
+  MatrixX initialConditions(2, 1);
   initialConditions << knotPositions.front(), initialVelocity;
-  addInitialConditions(initialConditions, constraintIdx);
 
   // Final conditions.
-  Eigen::VectorXd finalConditions(2);
+  MatrixX finalConditions(2, 1);
   finalConditions << knotPositions.back(), finalVelocity;
-  addFinalConditions(finalConditions, constraintIdx, splineDurations.back(), num_junctions);
 
-  // Junction conditions.
-  addJunctionsConditions(splineDurations, knotPositions, constraintIdx, num_junctions);
+  // Find spline coefficients.
+  MatrixX coeffs;
+  if (!solveEqualityConstraints(splineDurations, Eigen::Map<const VectorX>(knotPositions.data(), knotPositions.size()),
+                                initialConditions, finalConditions, coeffs)) {
+    return false;
+  }
+
+  // Extract spline coefficients and add splines.
+  success &= extractSplineCoefficients(coeffs.col(0), splineDurations, numSplines);
+
+  return success;
+}
+
 
-  if (num_constraints != constraintIdx) {
-    std::cout << "[PolynomialSplineContainer::setData] Wrong number of equality constraints!" << std::endl;
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setData(
+    const std::vector<Scalar_>& knotDurations,
+    const MatrixX& knotPositions,
+    const VectorX& initialVelocities, const VectorX& initialAccelerations,
+    const VectorX& finalVelocities, const VectorX& finalAccelerations,
+    std::vector<PolynomialSplineContainer>* containers) {
+
+  const unsigned int numDims = knotPositions.cols();
+  containers->resize(numDims);
+  if (numDims == 0u) {
+    return true;
+  }
+  if (knotPositions.rows() != static_cast<int>(knotDurations.size())) {
+    std::cout << "[PolynomialSplineContainer::setData] Number of knot positions and durations differ!" << std::endl;
     return false;
   }
 
-  // Find spline coefficients.
-  Eigen::VectorXd coeffs = equalityConstraintJacobian_.colPivHouseholderQr().solve(equalityConstraintTargetValues_);
+  // Set up optimization parameters.
+  const unsigned int numSplines = knotDurations.size()-1;
+  constexpr auto num_coeffs_spline = SplineType::coefficientCount;
+  const unsigned int solutionSpaceDimension = numSplines*num_coeffs_spline;
+  const unsigned int num_junctions = numSplines-1;
+
+  if (knotDurations.size()<2u) {
+    std::cout << "[PolynomialSplineContainer::setData] Not enough knot points available!" << std::endl;
+    return false;
+  }
+
+  // Total number of constraints.
+  constexpr unsigned int num_initial_constraints = 3;   // pos, vel, accel
+  constexpr unsigned int num_final_constraints = 3;     // pos, vel, accel
+  constexpr unsigned int num_constraint_junction = 4;   // pos (2x), vel, accel
+  const unsigned int num_junction_constraints = num_junctions*num_constraint_junction;
+  const unsigned int num_constraints = num_junction_constraints + num_initial_constraints + num_final_constraints;
+
+  // The reduced problems drop constraints, solve them container by container.
+  if (num_constraints>solutionSpaceDimension) {
+    bool success = true;
+    for (unsigned int dim=0; dim<numDims; ++dim) {
+      const VectorX positions = knotPositions.col(dim);
+      success &= (*containers)[dim].setData(
+          knotDurations, std::vector<Scalar_>(positions.data(), positions.data() + positions.size()),
+          initialVelocities(dim), initialAccelerations(dim), finalVelocities(dim), finalAccelerations(dim));
+    }
+    return success;
+  }
+
+  // Vector containing durations of splines.
+  std::vector<Scalar_> splineDurations(numSplines);
+  for (unsigned int splineId=0; splineId<numSplines; splineId++) {
+    splineDurations[splineId] = knotDurations[splineId+1]-knotDurations[splineId];
+
+    if (splineDurations[splineId]<=0.0) {
+      std::cout << "[PolynomialSplineContainer::setData] Invalid spline duration at index" << splineId << ": " << splineDurations[splineId] << std::endl;
+      return false;
+    }
+  }
+
+  // Initial conditions.
+  MatrixX initialConditions(3, numDims);
+  initialConditions << knotPositions.row(0), initialVelocities.transpose(), initialAccelerations.transpose();
+
+  // Final conditions.
+  MatrixX finalConditions(3, numDims);
+  finalConditions << knotPositions.row(numSplines), finalVelocities.transpose(), finalAccelerations.transpose();
+
+  // Find spline coefficients of all containers, the first container holds the factorization.
+  MatrixX coeffs;
+  if (!containers->front().solveEqualityConstraints(splineDurations, knotPositions,
+                                                     initialConditions, finalConditions, coeffs)) {
+    return false;
+  }
 
   // Extract spline coefficients and add splines.
-  success &= extractSplineCoefficients(coeffs, splineDurations, numSplines);
+  bool success = true;
+  for (unsigned int dim=0; dim<numDims; ++dim) {
+    PolynomialSplineContainer& container = (*containers)[dim];
+    success &= container.reset();
+    success &= container.extractSplineCoefficients(coeffs.col(dim), splineDurations, numSplines);
+  }
 
   return success;
 }
 
 
-template <int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::setData(
-    const std::vector<double>& knotDurations,
-    const std::vector<double>& knotPositions) {
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setData(
+    const std::vector<Scalar_>& knotDurations,
+    const std::vector<Scalar_>& knotPositions) {
+
+  if (isSolveDeferred_) {
+    return recordPendingSolve(knotDurations, knotPositions, {});
+  }
 
   bool success = true;
   const int numSplines = knotDurations.size()-1;
@@ -382,14 +501,14 @@ bool PolynomialSplineContainer<splineOrder_>::setData(
     return false;
   }
 
-  std::fill(coefficients.begin(), coefficients.end(), 0.0);
+  std::fill(coefficients.begin(), coefficients.end(), Scalar_(0.0));
 
   success &= reset();
 
   this->reserveSplines(numSplines);
 
   for (int splineId = 0; splineId<numSplines; ++splineId) {
-    const double duration = knotDurations[splineId+1]-knotDurations[splineId];
+    const Scalar_ duration = knotDurations[splineId+1]-knotDurations[splineId];
 
     if (duration<=0.0) {
       return false;
@@ -404,70 +523,858 @@ bool PolynomialSplineContainer<splineOrder_>::setData(
 
 }
 
-template <int splineOrder_>
-void PolynomialSplineContainer<splineOrder_>::addInitialConditions(const Eigen::VectorXd& initialConditions,
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setDataHermite(
+    const std::vector<Scalar_>& knotDurations,
+    const std::vector<Scalar_>& knotPositions,
+    const std::vector<Scalar_>& knotVelocities) {
+  return setHermiteSplines(knotDurations, knotPositions, knotVelocities, nullptr);
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setDataHermite(
+    const std::vector<Scalar_>& knotDurations,
+    const std::vector<Scalar_>& knotPositions,
+    const std::vector<Scalar_>& knotVelocities,
+    const std::vector<Scalar_>& knotAccelerations) {
+  return setHermiteSplines(knotDurations, knotPositions, knotVelocities, &knotAccelerations);
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setDataPchip(
+    const std::vector<Scalar_>& knotDurations,
+    const std::vector<Scalar_>& knotPositions) {
+  const unsigned int numKnots = knotDurations.size();
+  if (numKnots<2u || knotPositions.size() != numKnots) {
+    std::cout << "[PolynomialSplineContainer::setDataPchip] Not enough knot points available!" << std::endl;
+    return false;
+  }
+
+  // Durations and slopes of the splines.
+  std::vector<Scalar_> durations(numKnots-1), slopes(numKnots-1);
+  for (unsigned int splineId=0; splineId<numKnots-1; ++splineId) {
+    durations[splineId] = knotDurations[splineId+1]-knotDurations[splineId];
+    slopes[splineId] = (knotPositions[splineId+1]-knotPositions[splineId]) / durations[splineId];
+  }
+
+  std::vector<Scalar_> knotVelocities(numKnots, slopes.front());
+  if (numKnots>2u) {
+    // Interior knots, weighted harmonic mean of the slopes if they have the same sign.
+    for (unsigned int knotId=1; knotId<numKnots-1; ++knotId) {
+      const Scalar_ slope0 = slopes[knotId-1];
+      const Scalar_ slope1 = slopes[knotId];
+      if (slope0*slope1 <= Scalar_(0.0)) {
+        knotVelocities[knotId] = Scalar_(0.0);
+      } else {
+        const Scalar_ weight0 = Scalar_(2.0)*durations[knotId] + durations[knotId-1];
+        const Scalar_ weight1 = durations[knotId] + Scalar_(2.0)*durations[knotId-1];
+        knotVelocities[knotId] = (weight0 + weight1) / (weight0/slope0 + weight1/slope1);
+      }
+    }
+
+    // End knots, one-sided three-point estimate limited to keep the shape.
+    auto endVelocity = [](Scalar_ duration0, Scalar_ duration1, Scalar_ slope0, Scalar_ slope1) {
+      const Scalar_ velocity = ((Scalar_(2.0)*duration0 + duration1)*slope0 - duration0*slope1) / (duration0 + duration1);
+      if (velocity*slope0 <= Scalar_(0.0)) {
+        return Scalar_(0.0);
+      }
+      if (slope0*slope1 < Scalar_(0.0) && std::abs(velocity) > std::abs(Scalar_(3.0)*slope0)) {
+        return Scalar_(3.0)*slope0;
+      }
+      return velocity;
+    };
+    knotVelocities.front() = endVelocity(durations[0], durations[1], slopes[0], slopes[1]);
+    knotVelocities.back() = endVelocity(durations[numKnots-2], durations[numKnots-3],
+                                        slopes[numKnots-2], slopes[numKnots-3]);
+  }
+
+  return setHermiteSplines(knotDurations, knotPositions, knotVelocities, nullptr);
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setDataAkima(
+    const std::vector<Scalar_>& knotDurations,
+    const std::vector<Scalar_>& knotPositions) {
+  const unsigned int numKnots = knotDurations.size();
+  if (numKnots<2u || knotPositions.size() != numKnots) {
+    std::cout << "[PolynomialSplineContainer::setDataAkima] Not enough knot points available!" << std::endl;
+    return false;
+  }
+
+  // Slopes of the splines, extended by two linearly extrapolated slopes on each side.
+  const unsigned int numSplines = numKnots-1;
+  std::vector<Scalar_> slopes(numSplines+4);
+  for (unsigned int splineId=0; splineId<numSplines; ++splineId) {
+    slopes[splineId+2] = (knotPositions[splineId+1]-knotPositions[splineId])
+        / (knotDurations[splineId+1]-knotDurations[splineId]);
+  }
+  if (numSplines == 1u) {
+    slopes[1] = slopes[2];
+    slopes[numSplines+2] = slopes[numSplines+1];
+  } else {
+    slopes[1] = Scalar_(2.0)*slopes[2] - slopes[3];
+    slopes[numSplines+2] = Scalar_(2.0)*slopes[numSplines+1] - slopes[numSplines];
+  }
+  slopes[0] = Scalar_(2.0)*slopes[1] - slopes[2];
+  slopes[numSplines+3] = Scalar_(2.0)*slopes[numSplines+2] - slopes[numSplines+1];
+
+  // Velocity at knot i from the slopes of the splines i-2, ..., i+1.
+  std::vector<Scalar_> knotVelocities(numKnots);
+  for (unsigned int knotId=0; knotId<numKnots; ++knotId) {
+    const Scalar_ weight0 = std::abs(slopes[knotId+3]-slopes[knotId+2]);
+    const Scalar_ weight1 = std::abs(slopes[knotId+1]-slopes[knotId]);
+    if (weight0 + weight1 > Scalar_(0.0)) {
+      knotVelocities[knotId] = (weight0*slopes[knotId+1] + weight1*slopes[knotId+2]) / (weight0 + weight1);
+    } else {
+      knotVelocities[knotId] = Scalar_(0.5)*(slopes[knotId+1] + slopes[knotId+2]);
+    }
+  }
+
+  return setHermiteSplines(knotDurations, knotPositions, knotVelocities, nullptr);
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setHermiteSplines(
+    const std::vector<Scalar_>& knotDurations,
+    const std::vector<Scalar_>& knotPositions,
+    const std::vector<Scalar_>& knotVelocities,
+    const std::vector<Scalar_>* knotAccelerations) {
+  const unsigned int hermiteOrder = (knotAccelerations == nullptr) ? 3u : 5u;
+  if (splineOrder_ < hermiteOrder) {
+    std::cout << "[PolynomialSplineContainer::setDataHermite] Spline order " << splineOrder_
+              << " is too low for Hermite splines of order " << hermiteOrder << "!" << std::endl;
+    return false;
+  }
+
+  const unsigned int numKnots = knotDurations.size();
+  if (numKnots<2u || knotPositions.size() != numKnots || knotVelocities.size() != numKnots
+      || (knotAccelerations != nullptr && knotAccelerations->size() != numKnots)) {
+    std::cout << "[PolynomialSplineContainer::setDataHermite] Not enough knot points available!" << std::endl;
+    return false;
+  }
+
+  const unsigned int numSplines = numKnots-1;
+  for (unsigned int splineId=0; splineId<numSplines; ++splineId) {
+    const Scalar_ duration = knotDurations[splineId+1]-knotDurations[splineId];
+    if (duration<=0.0) {
+      std::cout << "[PolynomialSplineContainer::setDataHermite] Invalid spline duration at index" << splineId << ": " << duration << std::endl;
+      reset();
+      return false;
+    }
+  }
+
+  bool success = reset();
+  splines_.resize(numSplines);
+
+  // The splines do not depend on each other. Large containers are split into chunks of at least
+  // kHermiteSplinesPerChunk splines, one per core, built in parallel. The calling thread takes the last one.
+  const unsigned int kHermiteSplinesPerChunk = 8192u;
+  const unsigned int numChunks = std::min(std::max(1u, boost::thread::hardware_concurrency()),
+                                          (numSplines + kHermiteSplinesPerChunk - 1u) / kHermiteSplinesPerChunk);
+  const unsigned int splinesPerChunk = (numSplines + numChunks - 1u) / numChunks;
+  boost::thread_group workers;
+  for (unsigned int chunkId=0; chunkId<numChunks; ++chunkId) {
+    const unsigned int begin = chunkId*splinesPerChunk;
+    const unsigned int end = std::min(numSplines, begin+splinesPerChunk);
+    if (chunkId+1u == numChunks) {
+      setHermiteSplineRange(begin, end, hermiteOrder, knotDurations, knotPositions, knotVelocities, knotAccelerations);
+    } else {
+      workers.create_thread([=, &knotDurations, &knotPositions, &knotVelocities]() {
+        setHermiteSplineRange(begin, end, hermiteOrder, knotDurations, knotPositions, knotVelocities, knotAccelerations);
+      });
+    }
+  }
+  workers.join_all();
+
+  for (const auto& spline : splines_) {
+    containerDuration_ += spline.getSplineDuration();
+  }
+
+  return success;
+}
+
+template <int splineOrder_, typename Scalar_>
+void PolynomialSplineContainer<splineOrder_, Scalar_>::setHermiteSplineRange(
+    unsigned int beginSplineId,
+    unsigned int endSplineId,
+    unsigned int hermiteOrder,
+    const std::vector<Scalar_>& knotDurations,
+    const std::vector<Scalar_>& knotPositions,
+    const std::vector<Scalar_>& knotVelocities,
+    const std::vector<Scalar_>* knotAccelerations) {
+  for (unsigned int splineId=beginSplineId; splineId<endSplineId; ++splineId) {
+    const Scalar_ duration = knotDurations[splineId+1]-knotDurations[splineId];
+
+    // Coefficients c0, c1, ... of s(t) = sum(ci*t^i).
+    std::array<Scalar_, 6> c;
+    c.fill(Scalar_(0.0));
+    const Scalar_ dp = knotPositions[splineId+1]-knotPositions[splineId];
+    const Scalar_ v0 = knotVelocities[splineId];
+    const Scalar_ v1 = knotVelocities[splineId+1];
+    c[0] = knotPositions[splineId];
+    c[1] = v0;
+    if (knotAccelerations == nullptr) {
+      c[2] = (Scalar_(3.0)*dp/duration - Scalar_(2.0)*v0 - v1) / duration;
+      c[3] = (v0 + v1 - Scalar_(2.0)*dp/duration) / (duration*duration);
+    } else {
+      const Scalar_ a0 = (*knotAccelerations)[splineId];
+      const Scalar_ a1 = (*knotAccelerations)[splineId+1];
+      const Scalar_ duration2 = duration*duration;
+      c[2] = Scalar_(0.5)*a0;
+      c[3] = (Scalar_(20.0)*dp - (Scalar_(8.0)*v1 + Scalar_(12.0)*v0)*duration
+          - (Scalar_(3.0)*a0 - a1)*duration2) / (Scalar_(2.0)*duration2*duration);
+      c[4] = (Scalar_(-30.0)*dp + (Scalar_(14.0)*v1 + Scalar_(16.0)*v0)*duration
+          + (Scalar_(3.0)*a0 - Scalar_(2.0)*a1)*duration2) / (Scalar_(2.0)*duration2*duration2);
+      c[5] = (Scalar_(12.0)*dp - Scalar_(6.0)*(v1 + v0)*duration
+          - (a0 - a1)*duration2) / (Scalar_(2.0)*duration2*duration2*duration);
+    }
+
+    // Spline coefficients are stored as [an ... a1 a0].
+    typename SplineType::SplineCoefficients coefficients;
+    coefficients.fill(Scalar_(0.0));
+    for (unsigned int i=0; i<=hermiteOrder; ++i) {
+      coefficients[splineOrder_-i] = c[i];
+    }
+    splines_[splineId].setCoefficientsAndDuration(coefficients, duration);
+  }
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setDataMinimumDerivative(
+    const std::vector<Scalar_>& knotDurations,
+    const std::vector<Scalar_>& knotPositions,
+    unsigned int derivativeOrder,
+    const std::vector<Scalar_>& initialDerivatives,
+    const std::vector<Scalar_>& finalDerivatives) {
+  const int r = derivativeOrder;
+  const int numCoefficients = 2*r;
+  if (r < 2 || static_cast<int>(splineOrder_) < numCoefficients-1) {
+    std::cout << "[PolynomialSplineContainer::setDataMinimumDerivative] Spline order " << splineOrder_
+              << " is too low to minimize derivative " << derivativeOrder << "!" << std::endl;
+    return false;
+  }
+
+  const unsigned int numKnots = knotDurations.size();
+  if (numKnots<2u || knotPositions.size() != numKnots
+      || initialDerivatives.size() > static_cast<size_t>(r-1) || finalDerivatives.size() > static_cast<size_t>(r-1)) {
+    std::cout << "[PolynomialSplineContainer::setDataMinimumDerivative] Not enough knot points available!" << std::endl;
+    return false;
+  }
+  const int numSplines = numKnots-1;
+  const int q = r-1;
+
+  // Derivatives 1 to r-1 at the knots, all unknown except the given ones at the first and the last knot.
+  std::vector<VectorX> knotDerivatives(numKnots, VectorX::Zero(q));
+
+  // Row of derivative j of [1 t ... t^(2r-1)] evaluated at time t.
+  auto derivativeRow = [numCoefficients](int j, Scalar_ t) {
+    VectorX row = VectorX::Zero(numCoefficients);
+    for (int i=j; i<numCoefficients; ++i) {
+      Scalar_ factor = Scalar_(1.0);
+      for (int k=i-j+1; k<=i; ++k) {
+        factor *= Scalar_(k);
+      }
+      row(i) = factor*std::pow(t, i-j);
+    }
+    return row;
+  };
+
+  // For every spline, the inverse of the Hermite matrix maps the derivatives 0 to r-1 at both ends,
+  // [d(0); d(T)], to the coefficients. startMaps and endMaps map them to the derivatives r to 2r-2
+  // at the start and the end, these have to be continuous at the interior knots.
+  std::vector<MatrixX> hermiteInverses(numSplines), startMaps(numSplines), endMaps(numSplines);
+  for (int splineId=0; splineId<numSplines; ++splineId) {
+    const Scalar_ duration = knotDurations[splineId+1]-knotDurations[splineId];
+    if (duration<=0.0) {
+      std::cout << "[PolynomialSplineContainer::setDataMinimumDerivative] Invalid spline duration at index" << splineId << ": " << duration << std::endl;
+      return false;
+    }
+    MatrixX hermite(numCoefficients, numCoefficients);
+    for (int j=0; j<r; ++j) {
+      hermite.row(j) = derivativeRow(j, Scalar_(0.0)).transpose();
+      hermite.row(r+j) = derivativeRow(j, duration).transpose();
+    }
+    hermiteInverses[splineId] = hermite.partialPivLu().inverse();
+    MatrixX startRows(q, numCoefficients), endRows(q, numCoefficients);
+    for (int j=0; j<q; ++j) {
+      startRows.row(j) = derivativeRow(r+j, Scalar_(0.0)).transpose();
+      endRows.row(j) = derivativeRow(r+j, duration).transpose();
+    }
+    startMaps[splineId] = startRows*hermiteInverses[splineId];
+    endMaps[splineId] = endRows*hermiteInverses[splineId];
+  }
+
+  // Optimality conditions at interior knot k between the splines a = k-1 and b = k:
+  //   endMaps[a]*[p(k-1); x(k-1); p(k); x(k)] = startMaps[b]*[p(k); x(k); p(k+1); x(k+1)].
+  // At the first and the last knot the given derivatives are fixed, and a free derivative j has the
+  // natural boundary condition that derivative 2r-1-j vanishes. The conditions are block tridiagonal
+  // in x(0) to x(n-1), lowerBlocks couple x(k-1), upperBlocks x(k+1). Solved by block elimination.
+  std::vector<MatrixX> lowerBlocks(numKnots, MatrixX::Zero(q, q)), diagonalBlocks(numKnots, MatrixX::Zero(q, q)),
+      upperBlocks(numKnots, MatrixX::Zero(q, q));
+  std::vector<VectorX> rhs(numKnots, VectorX::Zero(q));
+  const int numInitial = initialDerivatives.size();
+  for (int i=0; i<q; ++i) {
+    if (i < numInitial) {
+      diagonalBlocks.front()(i, i) = Scalar_(1.0);
+      rhs.front()(i) = initialDerivatives[i];
+    } else {
+      // Derivatives r to 2r-2-numInitial at the start vanish.
+      const MatrixX& startMap = startMaps.front();
+      diagonalBlocks.front().row(i) = startMap.block(i-numInitial, 1, 1, q);
+      upperBlocks.front().row(i) = startMap.block(i-numInitial, r+1, 1, q);
+      rhs.front()(i) = -(startMap(i-numInitial, 0)*knotPositions[0] + startMap(i-numInitial, r)*knotPositions[1]);
+    }
+  }
+  for (int k=1; k<numSplines; ++k) {
+    const MatrixX& endMap = endMaps[k-1];
+    const MatrixX& startMap = startMaps[k];
+    lowerBlocks[k] = endMap.block(0, 1, q, q);
+    diagonalBlocks[k] = endMap.block(0, r+1, q, q) - startMap.block(0, 1, q, q);
+    upperBlocks[k] = -startMap.block(0, r+1, q, q);
+    rhs[k] = -(endMap.col(0)*knotPositions[k-1] + (endMap.col(r) - startMap.col(0))*knotPositions[k]
+        - startMap.col(r)*knotPositions[k+1]);
+  }
+  const int numFinal = finalDerivatives.size();
+  for (int i=0; i<q; ++i) {
+    if (i < numFinal) {
+      diagonalBlocks.back()(i, i) = Scalar_(1.0);
+      rhs.back()(i) = finalDerivatives[i];
+    } else {
+      // Derivatives r to 2r-2-numFinal at the end vanish.
+      const MatrixX& endMap = endMaps.back();
+      lowerBlocks.back().row(i) = endMap.block(i-numFinal, 1, 1, q);
+      diagonalBlocks.back().row(i) = endMap.block(i-numFinal, r+1, 1, q);
+      rhs.back()(i) = -(endMap(i-numFinal, 0)*knotPositions[numKnots-2] + endMap(i-numFinal, r)*knotPositions[numKnots-1]);
+    }
+  }
+
+  std::vector<Eigen::PartialPivLU<MatrixX>> pivots(numKnots);
+  for (unsigned int k=0; k<numKnots; ++k) {
+    if (k > 0) {
+      const MatrixX elimination = lowerBlocks[k]*pivots[k-1].inverse();
+      diagonalBlocks[k] -= elimination*upperBlocks[k-1];
+      rhs[k] -= elimination*rhs[k-1];
+    }
+    pivots[k].compute(diagonalBlocks[k]);
+  }
+  for (int k=numKnots-1; k>=0; --k) {
+    VectorX b = rhs[k];
+    if (k+1 < static_cast<int>(numKnots)) {
+      b -= upperBlocks[k]*knotDerivatives[k+1];
+    }
+    knotDerivatives[k] = pivots[k].solve(b);
+  }
+
+  // Write the coefficients into the splines, stored as [an ... a1 a0].
+  bool success = reset();
+  splines_.resize(numSplines);
+  VectorX boundaryDerivatives(numCoefficients);
+  typename SplineType::SplineCoefficients coefficients;
+  coefficients.fill(Scalar_(0.0));
+  for (int splineId=0; splineId<numSplines; ++splineId) {
+    boundaryDerivatives << knotPositions[splineId], knotDerivatives[splineId],
+                           knotPositions[splineId+1], knotDerivatives[splineId+1];
+    const VectorX c = hermiteInverses[splineId]*boundaryDerivatives;
+    for (int i=0; i<numCoefficients; ++i) {
+      coefficients[splineOrder_-i] = c(i);
+    }
+    const Scalar_ duration = knotDurations[splineId+1]-knotDurations[splineId];
+    splines_[splineId].setCoefficientsAndDuration(coefficients, duration);
+    containerDuration_ += duration;
+  }
+
+  return success;
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setDataPeriodic(
+    const std::vector<Scalar_>& knotDurations,
+    const std::vector<Scalar_>& knotPositions) {
+  if (splineOrder_ < 3) {
+    std::cout << "[PolynomialSplineContainer::setDataPeriodic] Spline order " << splineOrder_
+              << " is too low for periodic splines!" << std::endl;
+    return false;
+  }
+
+  const unsigned int numKnots = knotDurations.size();
+  if (numKnots<2u || knotPositions.size() != numKnots) {
+    std::cout << "[PolynomialSplineContainer::setDataPeriodic] Not enough knot points available!" << std::endl;
+    return false;
+  }
+
+  if (knotPositions.front() != knotPositions.back()) {
+    std::cout << "[PolynomialSplineContainer::setDataPeriodic] First and last knot positions differ!" << std::endl;
+    return false;
+  }
+
+  // Durations and slopes of the splines.
+  const unsigned int numSplines = numKnots-1;
+  VectorX durations(numSplines), slopes(numSplines);
+  for (unsigned int splineId=0; splineId<numSplines; ++splineId) {
+    durations(splineId) = knotDurations[splineId+1]-knotDurations[splineId];
+    if (durations(splineId)<=0.0) {
+      std::cout << "[PolynomialSplineContainer::setDataPeriodic] Invalid spline duration at index" << splineId << ": " << durations(splineId) << std::endl;
+      return false;
+    }
+    slopes(splineId) = (knotPositions[splineId+1]-knotPositions[splineId]) / durations(splineId);
+  }
+
+  // Second derivatives at the knots, continuity of the first derivative at knot i connects
+  // the splines i-1 and i, knot 0 connects the last and the first spline.
+  VectorX knotAccelerations = VectorX::Zero(numSplines);
+  if (numSplines == 2u) {
+    // Both neighbors of a knot are the other knot.
+    const Scalar_ diagonal = Scalar_(2.0)*(durations(0) + durations(1));
+    const Scalar_ offDiagonal = durations(0) + durations(1);
+    const Scalar_ rhs0 = Scalar_(6.0)*(slopes(0) - slopes(1));
+    const Scalar_ rhs1 = Scalar_(6.0)*(slopes(1) - slopes(0));
+    const Scalar_ determinant = diagonal*diagonal - offDiagonal*offDiagonal;
+    knotAccelerations(0) = (diagonal*rhs0 - offDiagonal*rhs1) / determinant;
+    knotAccelerations(1) = (diagonal*rhs1 - offDiagonal*rhs0) / determinant;
+  } else if (numSplines > 2u) {
+    VectorX lower(numSplines), diagonal(numSplines), upper(numSplines), rhs(numSplines);
+    for (unsigned int knotId=0; knotId<numSplines; ++knotId) {
+      const unsigned int previousSplineId = (knotId == 0u) ? numSplines-1 : knotId-1;
+      lower(knotId) = durations(previousSplineId);
+      diagonal(knotId) = Scalar_(2.0)*(durations(previousSplineId) + durations(knotId));
+      upper(knotId) = durations(knotId);
+      rhs(knotId) = Scalar_(6.0)*(slopes(knotId) - slopes(previousSplineId));
+    }
+    if (!solveCyclicTridiagonal(lower, diagonal, upper, rhs, knotAccelerations)) {
+      reset();
+      return false;
+    }
+  }
+
+  // The last knot closes the period.
+  VectorX closedKnotAccelerations(numKnots);
+  closedKnotAccelerations << knotAccelerations, knotAccelerations(0);
+  if (!addCubicSplines(durations, Eigen::Map<const VectorX>(knotPositions.data(), numKnots),
+                       closedKnotAccelerations)) {
+    // Do not wrap the time over a partially filled container.
+    reset();
+    return false;
+  }
+
+  isPeriodic_ = true;
+  return true;
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setDataSmoothing(
+    const std::vector<Scalar_>& knotDurations,
+    const std::vector<Scalar_>& knotPositions,
+    Scalar_ smoothingParameter) {
+  if (smoothingParameter < Scalar_(0.0)) {
+    std::cout << "[PolynomialSplineContainer::setDataSmoothing] Negative smoothing parameter!" << std::endl;
+    return false;
+  }
+
+  VectorX durations, knotValues, knotAccelerations;
+  if (!getSmoothingDurations(knotDurations, knotPositions, durations)
+      || !solveSmoothing(durations, Eigen::Map<const VectorX>(knotPositions.data(), knotPositions.size()),
+                         smoothingParameter, knotValues, knotAccelerations, nullptr)) {
+    return false;
+  }
+  return addCubicSplines(durations, knotValues, knotAccelerations);
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::setDataSmoothingGcv(
+    const std::vector<Scalar_>& knotDurations,
+    const std::vector<Scalar_>& knotPositions,
+    Scalar_* smoothingParameter) {
+  VectorX durations, knotValues, knotAccelerations;
+  if (!getSmoothingDurations(knotDurations, knotPositions, durations)) {
+    return false;
+  }
+  const Eigen::Map<const VectorX> positions(knotPositions.data(), knotPositions.size());
+
+  // Without interior knots the fit is the line through the two knots.
+  Scalar_ bestParameter = Scalar_(0.0);
+  if (durations.size() > 1) {
+    // Search log10 of the parameter relative to the ratio of the penalty and data terms, first on
+    // a coarse grid and then by golden section search around the best grid point.
+    const int m = durations.size()-1;
+    Scalar_ traceR = Scalar_(0.0), traceQtQ = Scalar_(0.0);
+    for (int j=0; j<m; ++j) {
+      traceR += (durations(j) + durations(j+1)) / Scalar_(3.0);
+      traceQtQ += Scalar_(1.0)/(durations(j)*durations(j)) + Scalar_(1.0)/(durations(j+1)*durations(j+1))
+          + boost::math::pow<2>(Scalar_(1.0)/durations(j) + Scalar_(1.0)/durations(j+1));
+    }
+    const Scalar_ scale = traceR / traceQtQ;
+    auto score = [&](Scalar_ exponent) {
+      Scalar_ gcvScore = std::numeric_limits<Scalar_>::max();
+      solveSmoothing(durations, positions, scale*std::pow(Scalar_(10.0), exponent),
+                     knotValues, knotAccelerations, &gcvScore);
+      return gcvScore;
+    };
+
+    constexpr int numGridPoints = 29;
+    const Scalar_ minExponent = Scalar_(-8.0), gridStep = Scalar_(0.5);
+    int bestGridPoint = 0;
+    Scalar_ bestScore = std::numeric_limits<Scalar_>::max();
+    for (int i=0; i<numGridPoints; ++i) {
+      const Scalar_ gridScore = score(minExponent + i*gridStep);
+      if (gridScore < bestScore) {
+        bestScore = gridScore;
+        bestGridPoint = i;
+      }
+    }
+
+    const Scalar_ goldenRatio = Scalar_(0.5)*(std::sqrt(Scalar_(5.0)) - Scalar_(1.0));
+    Scalar_ lowerExponent = minExponent + std::max(bestGridPoint-1, 0)*gridStep;
+    Scalar_ upperExponent = minExponent + std::min(bestGridPoint+1, numGridPoints-1)*gridStep;
+    Scalar_ exponent0 = upperExponent - goldenRatio*(upperExponent - lowerExponent);
+    Scalar_ exponent1 = lowerExponent + goldenRatio*(upperExponent - lowerExponent);
+    Scalar_ score0 = score(exponent0), score1 = score(exponent1);
+    for (int iteration=0; iteration<30; ++iteration) {
+      if (score0 < score1) {
+        upperExponent = exponent1;
+        exponent1 = exponent0;
+        score1 = score0;
+        exponent0 = upperExponent - goldenRatio*(upperExponent - lowerExponent);
+        score0 = score(exponent0);
+      } else {
+        lowerExponent = exponent0;
+        exponent0 = exponent1;
+        score0 = score1;
+        exponent1 = lowerExponent + goldenRatio*(upperExponent - lowerExponent);
+        score1 = score(exponent1);
+      }
+    }
+    const Scalar_ bestExponent = (std::min(score0, score1) < bestScore)
+        ? Scalar_(0.5)*(lowerExponent + upperExponent) : minExponent + bestGridPoint*gridStep;
+    bestParameter = scale*std::pow(Scalar_(10.0), bestExponent);
+  }
+
+  if (smoothingParameter != nullptr) {
+    *smoothingParameter = bestParameter;
+  }
+  if (!solveSmoothing(durations, positions, bestParameter, knotValues, knotAccelerations, nullptr)) {
+    return false;
+  }
+  return addCubicSplines(durations, knotValues, knotAccelerations);
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::isPeriodic() const {
+  return isPeriodic_;
+}
+
+template <int splineOrder_, typename Scalar_>
+Scalar_ PolynomialSplineContainer<splineOrder_, Scalar_>::getWrappedTime(Scalar_ t) const {
+  if (!isPeriodic_ || (t >= Scalar_(0.0) && t < containerDuration_)) {
+    return t;
+  }
+  const Scalar_ wrappedTime = t - containerDuration_*std::floor(t/containerDuration_);
+  // Rounding can end up at the period.
+  return (wrappedTime < containerDuration_) ? wrappedTime : Scalar_(0.0);
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::getSmoothingDurations(
+    const std::vector<Scalar_>& knotDurations,
+    const std::vector<Scalar_>& knotPositions,
+    VectorX& durations) {
+  if (splineOrder_ < 3) {
+    std::cout << "[PolynomialSplineContainer::setDataSmoothing] Spline order " << splineOrder_
+              << " is too low for smoothing splines!" << std::endl;
+    return false;
+  }
+
+  const unsigned int numKnots = knotDurations.size();
+  if (numKnots<2u || knotPositions.size() != numKnots) {
+    std::cout << "[PolynomialSplineContainer::setDataSmoothing] Not enough knot points available!" << std::endl;
+    return false;
+  }
+
+  durations.resize(numKnots-1);
+  for (unsigned int splineId=0; splineId<numKnots-1; ++splineId) {
+    durations(splineId) = knotDurations[splineId+1]-knotDurations[splineId];
+    if (durations(splineId)<=0.0) {
+      std::cout << "[PolynomialSplineContainer::setDataSmoothing] Invalid spline duration at index" << splineId << ": " << durations(splineId) << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::solveSmoothing(
+    const VectorX& durations,
+    const VectorX& knotPositions,
+    Scalar_ smoothingParameter,
+    VectorX& knotValues,
+    VectorX& knotAccelerations,
+    Scalar_* gcvScore) {
+  // Reinsch algorithm with the notation of Green and Silverman. Q is the n x (n-2) matrix of the
+  // second divided differences and R the (n-2) x (n-2) matrix of the natural spline penalty. The
+  // interior knot accelerations solve (R + lambda*Q^T*Q)*gamma = Q^T*y, the knot values are
+  // g = y - lambda*Q*gamma. The matrices are stored by their diagonals, Q^T*Q is pentadiagonal.
+  const int n = knotPositions.size();
+  const int m = n-2;
+  knotValues = knotPositions;
+  knotAccelerations = VectorX::Zero(n);
+  if (m < 1) {
+    return true;
+  }
+
+  // Column j of Q has the entries q0, q1, q2 in the rows j, j+1, j+2.
+  VectorX q0(m), q1(m), q2(m);
+  for (int j=0; j<m; ++j) {
+    q0(j) = Scalar_(1.0)/durations(j);
+    q2(j) = Scalar_(1.0)/durations(j+1);
+    q1(j) = -q0(j) - q2(j);
+  }
+
+  // Diagonals of Q^T*Q and of B = R + lambda*Q^T*Q, and Q^T*y.
+  VectorX p0(m), p1 = VectorX::Zero(m), p2 = VectorX::Zero(m);
+  VectorX b0(m), b1 = VectorX::Zero(m), b2 = VectorX::Zero(m), qty(m);
+  for (int j=0; j<m; ++j) {
+    p0(j) = q0(j)*q0(j) + q1(j)*q1(j) + q2(j)*q2(j);
+    b0(j) = (durations(j) + durations(j+1))/Scalar_(3.0) + smoothingParameter*p0(j);
+    if (j+1 < m) {
+      p1(j) = q1(j)*q0(j+1) + q2(j)*q1(j+1);
+      b1(j) = durations(j+1)/Scalar_(6.0) + smoothingParameter*p1(j);
+    }
+    if (j+2 < m) {
+      p2(j) = q2(j)*q0(j+2);
+      b2(j) = smoothingParameter*p2(j);
+    }
+    qty(j) = q0(j)*knotPositions(j) + q1(j)*knotPositions(j+1) + q2(j)*knotPositions(j+2);
+  }
+
+  // Banded LDL^T factorization, l1(i) = L(i+1,i) and l2(i) = L(i+2,i).
+  VectorX d(m), l1 = VectorX::Zero(m), l2 = VectorX::Zero(m);
+  for (int i=0; i<m; ++i) {
+    d(i) = b0(i);
+    if (i >= 1) { d(i) -= l1(i-1)*l1(i-1)*d(i-1); }
+    if (i >= 2) { d(i) -= l2(i-2)*l2(i-2)*d(i-2); }
+    if (d(i) <= Scalar_(0.0)) {
+      std::cout << "[PolynomialSplineContainer::setDataSmoothing] Singular system!" << std::endl;
+      return false;
+    }
+    l1(i) = b1(i);
+    if (i >= 1) { l1(i) -= l2(i-1)*l1(i-1)*d(i-1); }
+    l1(i) /= d(i);
+    l2(i) = b2(i)/d(i);
+  }
+
+  // Forward and backward substitution.
+  VectorX gamma(m);
+  for (int i=0; i<m; ++i) {
+    gamma(i) = qty(i);
+    if (i >= 1) { gamma(i) -= l1(i-1)*gamma(i-1); }
+    if (i >= 2) { gamma(i) -= l2(i-2)*gamma(i-2); }
+  }
+  for (int i=m-1; i>=0; --i) {
+    gamma(i) /= d(i);
+    if (i+1 < m) { gamma(i) -= l1(i)*gamma(i+1); }
+    if (i+2 < m) { gamma(i) -= l2(i)*gamma(i+2); }
+  }
+
+  // Knot values, the natural spline has zero acceleration at the end knots.
+  for (int j=0; j<m; ++j) {
+    knotValues(j) -= smoothingParameter*q0(j)*gamma(j);
+    knotValues(j+1) -= smoothingParameter*q1(j)*gamma(j);
+    knotValues(j+2) -= smoothingParameter*q2(j)*gamma(j);
+    knotAccelerations(j+1) = gamma(j);
+  }
+
+  if (gcvScore != nullptr) {
+    // GCV = n*RSS / (n - tr(A))^2 with the hat matrix A = I - lambda*Q*B^-1*Q^T, hence
+    // n - tr(A) = lambda*tr(Q^T*Q*B^-1). Only the pentadiagonal band of B^-1 is needed, it is
+    // computed from the factorization backwards (Hutchinson and de Hoog).
+    VectorX s0(m), s1 = VectorX::Zero(m), s2 = VectorX::Zero(m);
+    for (int i=m-1; i>=0; --i) {
+      if (i+2 < m) {
+        s2(i) = -l1(i)*s1(i+1) - l2(i)*s0(i+2);
+      }
+      if (i+1 < m) {
+        s1(i) = -l1(i)*s0(i+1) - ((i+2 < m) ? l2(i)*s1(i+1) : Scalar_(0.0));
+      }
+      s0(i) = Scalar_(1.0)/d(i) - ((i+1 < m) ? l1(i)*s1(i) : Scalar_(0.0)) - ((i+2 < m) ? l2(i)*s2(i) : Scalar_(0.0));
+    }
+    const Scalar_ trace = p0.dot(s0) + Scalar_(2.0)*(p1.dot(s1) + p2.dot(s2));
+    const Scalar_ residualSumOfSquares = (knotPositions - knotValues).squaredNorm();
+    const Scalar_ degreesOfFreedom = smoothingParameter*trace;
+    *gcvScore = (degreesOfFreedom > Scalar_(0.0))
+        ? n*residualSumOfSquares/(degreesOfFreedom*degreesOfFreedom) : std::numeric_limits<Scalar_>::max();
+  }
+
+  return true;
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::addCubicSplines(
+    const VectorX& durations,
+    const VectorX& knotPositions,
+    const VectorX& knotAccelerations) {
+  bool success = reset();
+  const unsigned int numSplines = durations.size();
+  this->reserveSplines(numSplines);
+
+  typename SplineType::SplineCoefficients coefficients;
+  coefficients.fill(Scalar_(0.0));
+  for (unsigned int splineId=0; splineId<numSplines; ++splineId) {
+    const Scalar_ duration = durations(splineId);
+    const Scalar_ slope = (knotPositions(splineId+1) - knotPositions(splineId)) / duration;
+    const Scalar_ acceleration0 = knotAccelerations(splineId);
+    const Scalar_ acceleration1 = knotAccelerations(splineId+1);
+    coefficients[splineOrder_] = knotPositions(splineId); // a0
+    coefficients[splineOrder_-1] = slope - duration*(Scalar_(2.0)*acceleration0 + acceleration1)/Scalar_(6.0); // a1
+    coefficients[splineOrder_-2] = Scalar_(0.5)*acceleration0; // a2
+    coefficients[splineOrder_-3] = (acceleration1 - acceleration0)/(Scalar_(6.0)*duration); // a3
+    success &= this->addSpline(SplineType(coefficients, duration));
+  }
+
+  return success;
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::solveCyclicTridiagonal(
+    const VectorX& lower, const VectorX& diagonal, const VectorX& upper,
+    const VectorX& rhs, VectorX& x) {
+  const int n = diagonal.size();
+  if (n < 3) {
+    return false;
+  }
+
+  // Solve the tridiagonal part with the corners removed, A = T + u*v^T with
+  // u = [gamma 0 ... 0 upper(n-1)]^T and v = [1 0 ... 0 lower(0)/gamma]^T.
+  const Scalar_ alpha = upper(n-1);
+  const Scalar_ beta = lower(0);
+  const Scalar_ gamma = -diagonal(0);
+  VectorX modifiedDiagonal = diagonal;
+  modifiedDiagonal(0) -= gamma;
+  modifiedDiagonal(n-1) -= alpha*beta/gamma;
+
+  // Thomas algorithm for T*y = rhs and T*z = u, sharing the forward elimination.
+  VectorX scaledUpper(n), y(n), z(n);
+  VectorX u = VectorX::Zero(n);
+  u(0) = gamma;
+  u(n-1) = alpha;
+  Scalar_ pivot = modifiedDiagonal(0);
+  y(0) = rhs(0)/pivot;
+  z(0) = u(0)/pivot;
+  for (int i=1; i<n; ++i) {
+    scaledUpper(i-1) = upper(i-1)/pivot;
+    pivot = modifiedDiagonal(i) - lower(i)*scaledUpper(i-1);
+    if (pivot == Scalar_(0.0)) {
+      std::cout << "[PolynomialSplineContainer::solveCyclicTridiagonal] Singular system!" << std::endl;
+      return false;
+    }
+    y(i) = (rhs(i) - lower(i)*y(i-1))/pivot;
+    z(i) = (u(i) - lower(i)*z(i-1))/pivot;
+  }
+  for (int i=n-2; i>=0; --i) {
+    y(i) -= scaledUpper(i)*y(i+1);
+    z(i) -= scaledUpper(i)*z(i+1);
+  }
+
+  // Sherman-Morrison correction.
+  const Scalar_ factor = (y(0) + beta*y(n-1)/gamma) / (Scalar_(1.0) + z(0) + beta*z(n-1)/gamma);
+  x = y - factor*z;
+  return true;
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::solveEqualityConstraints(
+    const std::vector<Scalar_>& splineDurations,
+    const MatrixX& knotPositions,
+    const MatrixX& initialConditions,
+    const MatrixX& finalConditions,
+    MatrixX& coeffs) {
+  const unsigned int numSplines = splineDurations.size();
+  const unsigned int num_junctions = numSplines-1;
+  const unsigned int num_constraints = initialConditions.rows() + finalConditions.rows() + 4*num_junctions;
+
+  // The equality matrix only depends on the spline durations and the boundary conditions.
+  // On a cache hit only the target values are filled and solved with the stored factorization.
+  if (factorizedNumConditions_ == initialConditions.rows()
+      && factorizedSplineDurations_ == splineDurations) {
+    ++factorizationCacheHits_;
+  } else {
+    equalityConstraintJacobian_.setZero(num_constraints, numSplines*SplineType::coefficientCount);
+    unsigned int constraintIdx = 0;
+    addInitialConditions(initialConditions, constraintIdx);
+    addFinalConditions(finalConditions, constraintIdx, splineDurations.back(), num_junctions);
+    addJunctionsConditions(splineDurations, constraintIdx, num_junctions);
+
+    if (num_constraints != constraintIdx) {
+      std::cout << "[PolynomialSplineContainer::setData] Wrong number of equality constraints!" << std::endl;
+      return false;
+    }
+
+    ++factorizationCacheMisses_;
+    equalityConstraintFactorization_.compute(equalityConstraintJacobian_);
+    factorizedSplineDurations_ = splineDurations;
+    factorizedNumConditions_ = initialConditions.rows();
+  }
+
+  addConstraintTargetValues(initialConditions, finalConditions, knotPositions, num_junctions);
+  coeffs = equalityConstraintFactorization_.solve(equalityConstraintTargetValues_);
+  return true;
+}
+
+template <int splineOrder_, typename Scalar_>
+void PolynomialSplineContainer<splineOrder_, Scalar_>::addInitialConditions(const MatrixX& initialConditions,
                           unsigned int& constraintIdx) {
   // Initial position.
-  if (initialConditions.size()>0) {
+  if (initialConditions.rows()>0) {
     SplineType::getTimeVectorAtZero(
-        equalityConstraintJacobian_.block<1, SplineType::coefficientCount>(constraintIdx, getSplineColumnIndex(0)));
-    equalityConstraintTargetValues_(constraintIdx) = initialConditions(0);
+        equalityConstraintJacobian_.template block<1, SplineType::coefficientCount>(constraintIdx, getSplineColumnIndex(0)));
     ++constraintIdx;
   }
 
   // Initial velocity.
-  if (initialConditions.size()>1) {
+  if (initialConditions.rows()>1) {
     SplineType::getDiffTimeVectorAtZero(
-        equalityConstraintJacobian_.block<1, SplineType::coefficientCount>(constraintIdx, getSplineColumnIndex(0)));
-    equalityConstraintTargetValues_(constraintIdx) = initialConditions(1);
+        equalityConstraintJacobian_.template block<1, SplineType::coefficientCount>(constraintIdx, getSplineColumnIndex(0)));
     ++constraintIdx;
   }
 
   // Initial acceleration.
-  if (initialConditions.size()>2) {
+  if (initialConditions.rows()>2) {
     SplineType::getDDiffTimeVectorAtZero(
-        equalityConstraintJacobian_.block<1, SplineType::coefficientCount>(constraintIdx, getSplineColumnIndex(0)));
-    equalityConstraintTargetValues_(constraintIdx) = initialConditions(2);
+        equalityConstraintJacobian_.template block<1, SplineType::coefficientCount>(constraintIdx, getSplineColumnIndex(0)));
     ++constraintIdx;
   }
 }
 
-template <int splineOrder_>
-void PolynomialSplineContainer<splineOrder_>::addFinalConditions(const Eigen::VectorXd& finalConditions,
+template <int splineOrder_, typename Scalar_>
+void PolynomialSplineContainer<splineOrder_, Scalar_>::addFinalConditions(const MatrixX& finalConditions,
                         unsigned int& constraintIdx,
-                        double lastSplineDuration,
+                        Scalar_ lastSplineDuration,
                         unsigned int lastSplineId) {
   // Time container
-  typename SplineType::EigenTimeVectorType timeVec;
+  typename SplineType::EigenTimeVectorType timeVec = SplineType::EigenTimeVectorType::Zero();
 
   // Initial position.
-  if (finalConditions.size()>0) {
+  if (finalConditions.rows()>0) {
     SplineType::getTimeVector(timeVec, lastSplineDuration);
     equalityConstraintJacobian_.block(constraintIdx, getSplineColumnIndex(lastSplineId), 1, SplineType::coefficientCount) = timeVec;
-    equalityConstraintTargetValues_(constraintIdx) = finalConditions(0);
     constraintIdx++;
   }
 
   // Initial velocity.
-  if (finalConditions.size()>1) {
+  if (finalConditions.rows()>1) {
     SplineType::getDTimeVector(timeVec, lastSplineDuration);
     equalityConstraintJacobian_.block(constraintIdx, getSplineColumnIndex(lastSplineId), 1, SplineType::coefficientCount) = timeVec;
-    equalityConstraintTargetValues_(constraintIdx) = finalConditions(1);
     constraintIdx++;
   }
 
   // Initial acceleration.
-  if (finalConditions.size()>2) {
+  if (finalConditions.rows()>2) {
     SplineType::getDDTimeVector(timeVec, lastSplineDuration);
     equalityConstraintJacobian_.block(constraintIdx, getSplineColumnIndex(lastSplineId), 1, SplineType::coefficientCount) = timeVec;
-    equalityConstraintTargetValues_(constraintIdx) = finalConditions(2);
     constraintIdx++;
   }
 }
 
-template <int splineOrder_>
-void PolynomialSplineContainer<splineOrder_>::addJunctionsConditions(const std::vector<double>& splineDurations,
-                            const std::vector<double>& knotPositions,
+template <int splineOrder_, typename Scalar_>
+void PolynomialSplineContainer<splineOrder_, Scalar_>::addJunctionsConditions(const std::vector<Scalar_>& splineDurations,
                             unsigned int& constraintIdx,
                             unsigned int num_junctions) {
 
@@ -491,53 +1398,172 @@ void PolynomialSplineContainer<splineOrder_>::addJunctionsConditions(const std::
 
     // Smooth position transition with fixed positions.
     equalityConstraintJacobian_.block(constraintIdx, getSplineColumnIndex(splineId),     1, SplineType::coefficientCount) =  timeVecTf;
-    equalityConstraintTargetValues_(constraintIdx) = knotPositions[nextSplineId];
     constraintIdx++;
 
     equalityConstraintJacobian_.block(constraintIdx, getSplineColumnIndex(nextSplineId), 1, SplineType::coefficientCount) =  timeVec0;
-    equalityConstraintTargetValues_(constraintIdx) = knotPositions[nextSplineId];
     constraintIdx++;
 
     // Smooth velocity transition.
     equalityConstraintJacobian_.block(constraintIdx, getSplineColumnIndex(splineId),     1, SplineType::coefficientCount) =  dTimeVecTf;
     equalityConstraintJacobian_.block(constraintIdx, getSplineColumnIndex(nextSplineId), 1, SplineType::coefficientCount) = -dTimeVec0;
-    equalityConstraintTargetValues_(constraintIdx) = 0.0;
     constraintIdx++;
 
     // Smooth acceleration transition.
     equalityConstraintJacobian_.block(constraintIdx, getSplineColumnIndex(splineId),     1, SplineType::coefficientCount) =  ddTimeVecTf;
     equalityConstraintJacobian_.block(constraintIdx, getSplineColumnIndex(nextSplineId), 1, SplineType::coefficientCount) = -ddTimeVec0;
-    equalityConstraintTargetValues_(constraintIdx) = 0.0;
     constraintIdx++;
   }
 }
 
-template <int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::extractSplineCoefficients(
-    const Eigen::VectorXd& coeffs,
-    const std::vector<double>& splineDurations,
+template <int splineOrder_, typename Scalar_>
+void PolynomialSplineContainer<splineOrder_, Scalar_>::addConstraintTargetValues(const MatrixX& initialConditions,
+                               const MatrixX& finalConditions,
+                               const MatrixX& knotPositions,
+                               unsigned int num_junctions) {
+  const unsigned int numBoundaryConditions = initialConditions.rows() + finalConditions.rows();
+  equalityConstraintTargetValues_.setZero(numBoundaryConditions + 4*num_junctions, knotPositions.cols());
+  equalityConstraintTargetValues_.topRows(initialConditions.rows()) = initialConditions;
+  equalityConstraintTargetValues_.middleRows(initialConditions.rows(), finalConditions.rows()) = finalConditions;
+
+  // Both position rows of a junction target the knot, the velocity and acceleration rows zero.
+  for (unsigned int splineId=0; splineId<num_junctions; splineId++) {
+    const unsigned int constraintIdx = numBoundaryConditions + 4*splineId;
+    equalityConstraintTargetValues_.row(constraintIdx) = knotPositions.row(splineId+1);
+    equalityConstraintTargetValues_.row(constraintIdx+1) = knotPositions.row(splineId+1);
+  }
+}
+
+template <int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::extractSplineCoefficients(
+    const VectorX& coeffs,
+    const std::vector<Scalar_>& splineDurations,
     const unsigned int numSplines) {
   typename SplineType::SplineCoefficients coefficients;
 
   this->reserveSplines(numSplines);
 
   for (unsigned int splineId = 0; splineId<numSplines; ++splineId) {
-    Eigen::Map<Eigen::VectorXd>(coefficients.data(), SplineType::coefficientCount, 1) =
-        coeffs.segment<SplineType::coefficientCount>(getSplineColumnIndex(splineId));
+    Eigen::Map<VectorX>(coefficients.data(), SplineType::coefficientCount, 1) =
+        coeffs.template segment<SplineType::coefficientCount>(getSplineColumnIndex(splineId));
     this->addSpline(SplineType(coefficients,splineDurations[splineId]));
   }
 
   return true;
 }
 
-template<int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::reserveSplines(const unsigned int numSplines) {
+template<int splineOrder_, typename Scalar_>
+unsigned int PolynomialSplineContainer<splineOrder_, Scalar_>::getFactorizationCacheHits() const {
+  return factorizationCacheHits_;
+}
+
+template<int splineOrder_, typename Scalar_>
+unsigned int PolynomialSplineContainer<splineOrder_, Scalar_>::getFactorizationCacheMisses() const {
+  return factorizationCacheMisses_;
+}
+
+template<int splineOrder_, typename Scalar_>
+void PolynomialSplineContainer<splineOrder_, Scalar_>::clearFactorizationCache() {
+  factorizedSplineDurations_.clear();
+  factorizedNumConditions_ = 0;
+  factorizationCacheHits_ = 0u;
+  factorizationCacheMisses_ = 0u;
+}
+
+template<int splineOrder_, typename Scalar_>
+void PolynomialSplineContainer<splineOrder_, Scalar_>::setDeferredSolve(bool deferSolve) {
+  isSolveDeferred_ = deferSolve;
+}
+
+template<int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::isSolveDeferred() const {
+  return isSolveDeferred_;
+}
+
+template<int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::hasPendingSolve() const {
+  return hasPendingSolve_;
+}
+
+template<int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::finalize() {
+  if (!hasPendingSolve_) {
+    return true;
+  }
+
+  // Solve with the immediate setData, the reduced problems it falls back to included.
+  const bool isSolveDeferred = isSolveDeferred_;
+  isSolveDeferred_ = false;
+  hasPendingSolve_ = false;
+  const std::vector<Scalar_>& bc = pendingBoundaryConditions_;
+  bool success = false;
+  switch (bc.size()) {
+    case 0u:
+      success = setData(pendingKnotDurations_, pendingKnotPositions_);
+      break;
+    case 2u:
+      success = setData(pendingKnotDurations_, pendingKnotPositions_, bc[0], bc[1]);
+      break;
+    case 4u:
+      success = setData(pendingKnotDurations_, pendingKnotPositions_, bc[0], bc[1], bc[2], bc[3]);
+      break;
+    default:
+      break;
+  }
+  isSolveDeferred_ = isSolveDeferred;
+
+  return success;
+}
+
+template<int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::recordPendingSolve(
+    const std::vector<Scalar_>& knotDurations,
+    const std::vector<Scalar_>& knotPositions,
+    std::initializer_list<Scalar_> boundaryConditions) {
+  reset();
+
+  // Reject the inputs the solve would reject for sure, the solve itself is deferred.
+  if (knotDurations.size()<2u || knotPositions.size() != knotDurations.size()) {
+    std::cout << "[PolynomialSplineContainer::setData] Not enough knot points available!" << std::endl;
+    return false;
+  }
+  for (size_t splineId=0; splineId+1<knotDurations.size(); ++splineId) {
+    const Scalar_ duration = knotDurations[splineId+1]-knotDurations[splineId];
+    if (!(duration>0.0)) {
+      std::cout << "[PolynomialSplineContainer::setData] Invalid spline duration at index" << splineId << ": " << duration << std::endl;
+      return false;
+    }
+  }
+
+  pendingKnotDurations_.assign(knotDurations.begin(), knotDurations.end());
+  pendingKnotPositions_.assign(knotPositions.begin(), knotPositions.end());
+  pendingBoundaryConditions_.assign(boundaryConditions.begin(), boundaryConditions.end());
+  hasPendingSolve_ = true;
+  return true;
+}
+
+template<int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::finalizeOnRead() const {
+  if (!hasPendingSolve_) {
+    return true;
+  }
+
+  // Only setData records a pending solve, so a container with one was never defined const.
+  if (!const_cast<PolynomialSplineContainer*>(this)->finalize()) {
+    std::cout << "[PolynomialSplineContainer::finalizeOnRead] The deferred solve of setData failed!" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+template<int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::reserveSplines(const unsigned int numSplines) {
   splines_.reserve(numSplines);
   return true;
 }
 
-template<int splineOrder_>
-bool PolynomialSplineContainer<splineOrder_>::checkContainer() const {
+template<int splineOrder_, typename Scalar_>
+bool PolynomialSplineContainer<splineOrder_, Scalar_>::checkContainer() const {
+  finalizeOnRead();
   if (containerTime_<0.0) {
     std::cout << "[PolynomialSplineContainer::checkContainer] negative container time.\n";
     return false;
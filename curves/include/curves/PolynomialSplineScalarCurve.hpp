@@ -128,6 +128,44 @@ class PolynomialSplineScalarCurve : public Curve<ScalarCurveConfig>
     minTime_ = times.front();
   }
 
+  /*!
+   * Fit quintic Hermite splines through the values, first and second derivatives at the knots.
+   * Each spline only depends on its two knots, no global system is solved.
+   */
+  virtual void fitCurve(const std::vector<Time>& times, const std::vector<ValueType>& values,
+                        const std::vector<DerivativeType>& firstDerivatives,
+                        const std::vector<DerivativeType>& secondDerivatives,
+                        std::vector<Key>* /*outKeys*/ = NULL)
+  {
+    container_.setDataHermite(times, values, firstDerivatives, secondDerivatives);
+    minTime_ = times.front();
+  }
+
+  /*!
+   * Fit a periodic curve with period times.back() - times.front(), values.back() has to be equal
+   * to values.front(). The curve is C2 also across periods and can be evaluated at any time.
+   */
+  bool fitPeriodicCurve(const std::vector<Time>& times, const std::vector<ValueType>& values)
+  {
+    minTime_ = times.front();
+    return container_.setDataPeriodic(times, values);
+  }
+
+  /*!
+   * Fit a smoothing spline to noisy values instead of interpolating them.
+   * @param smoothingParameter weight of the curvature penalty, if negative it is selected by
+   *                           generalized cross-validation.
+   */
+  bool fitSmoothingCurve(const std::vector<Time>& times, const std::vector<ValueType>& values,
+                         double smoothingParameter = -1.0)
+  {
+    minTime_ = times.front();
+    if (smoothingParameter < 0.0) {
+      return container_.setDataSmoothingGcv(times, values);
+    }
+    return container_.setDataSmoothing(times, values, smoothingParameter);
+  }
+
   virtual void fitCurve(const std::vector<SplineOptions>& optionList,
                         std::vector<Key>* outKeys = NULL)
   {
@@ -87,13 +87,8 @@ class PolynomialSplineVectorSpaceCurve : public VectorSpaceCurve<N>
   virtual void fitCurve(const std::vector<Time>& times, const std::vector<ValueType>& values,
                         std::vector<Key>* outKeys = NULL)
   {
-    minTime_ = times.front();
-    for (size_t i = 0; i < N; ++i) {
-      std::vector<double> scalarValues;
-      scalarValues.reserve(times.size());
-      for (size_t t = 0; t < times.size(); ++t) scalarValues.push_back(values.at(t)(i));
-      containers_.at(i).setData(times, scalarValues, 0.0, 0.0, 0.0, 0.0);
-    }
+    fitContainers(times, values, DerivativeType::Zero(), DerivativeType::Zero(),
+                  DerivativeType::Zero(), DerivativeType::Zero());
   }
 
   virtual void fitCurve(const std::vector<Time>& times,
@@ -103,40 +98,35 @@ class PolynomialSplineVectorSpaceCurve : public VectorSpaceCurve<N>
                         const DerivativeType& finalVelocity,
                         const DerivativeType& finalAcceleration)
   {
-    minTime_ = times.front();
-    for (size_t i = 0; i < N; ++i) {
-      std::vector<double> scalarValues;
-      scalarValues.reserve(times.size());
-      for (size_t t = 0; t < times.size(); ++t) scalarValues.push_back(values.at(t)(i));
-      containers_.at(i).setData(times, scalarValues, initialVelocity(i), initialAcceleration(i),
-                                finalVelocity(i), finalAcceleration(i));
-    }
+    fitContainers(times, values, initialVelocity, initialAcceleration, finalVelocity, finalAcceleration);
   }
 
   virtual void fitCurve(const std::vector<Time>& times, const std::vector<ValueType>& values,
                         const std::vector<DerivativeType>& firstDerivatives,
                         const std::vector<DerivativeType>& secondDerivatives,
                         std::vector<Key>* outKeys = NULL)
+  {
+    // TODO Copy all derivates, right now only first and last are supported.
+    fitContainers(times, values, firstDerivatives.front(), secondDerivatives.front(),
+                  firstDerivatives.back(), secondDerivatives.back());
+  }
+
+
+  /// \brief Fit a periodic curve with period times.back() - times.front(), values.back() has to
+  ///        be equal to values.front(). The curve is C2 also across periods.
+  bool fitPeriodicCurve(const std::vector<Time>& times, const std::vector<ValueType>& values)
   {
     minTime_ = times.front();
+    bool success = true;
     for (size_t i = 0; i < N; ++i) {
-      std::vector<double> scalarValues, scalarFirstDerivates, scalarSecondDerivates;
+      std::vector<double> scalarValues;
       scalarValues.reserve(times.size());
-      scalarFirstDerivates.reserve(times.size());
-      scalarSecondDerivates.reserve(times.size());
-      for (size_t t = 0; t < times.size(); ++t) {
-        scalarValues.push_back(values.at(t)(i));
-        scalarFirstDerivates.push_back(firstDerivatives.at(t)(i));
-        scalarSecondDerivates.push_back(secondDerivatives.at(t)(i));
-      }
-      // TODO Copy all derivates, right now only first and last are supported.
-      containers_.at(i).setData(times, scalarValues,
-                                *(scalarFirstDerivates.begin()), *(scalarSecondDerivates.begin()),
-                                *(scalarFirstDerivates.end() - 1), *(scalarSecondDerivates.end() - 1));
+      for (size_t t = 0; t < times.size(); ++t) scalarValues.push_back(values.at(t)(i));
+      success &= containers_.at(i).setDataPeriodic(times, scalarValues);
     }
+    return success;
   }
 
-
   virtual void fitCurve(const std::vector<SplineOptions>& /*values*/,
                         std::vector<Key>* /*outKeys*/)
   {
@@ -157,6 +147,21 @@ class PolynomialSplineVectorSpaceCurve : public VectorSpaceCurve<N>
   }
 
  private:
+  /// \brief Fit all dimensions at once, the constraint matrix only depends on the times
+  ///        and is factorized once for the N right-hand sides.
+  void fitContainers(const std::vector<Time>& times, const std::vector<ValueType>& values,
+                     const DerivativeType& initialVelocity, const DerivativeType& initialAcceleration,
+                     const DerivativeType& finalVelocity, const DerivativeType& finalAcceleration)
+  {
+    minTime_ = times.front();
+    Eigen::MatrixXd knotPositions(times.size(), N);
+    for (size_t t = 0; t < times.size(); ++t) {
+      knotPositions.row(t) = values.at(t).transpose();
+    }
+    PolynomialSplineContainerQuintic::setData(times, knotPositions, initialVelocity, initialAcceleration,
+                                              finalVelocity, finalAcceleration, &containers_);
+  }
+
   std::vector<PolynomialSplineContainerQuintic> containers_;
   Time minTime_;
 };
@@ -11,9 +11,14 @@
 //     on base is computed resulting in
 //     interpolation(corr(t1) * base(t1), corr(t2) * base(t2), alpha)
 
+#ifndef COMPOSITION_STRATEGY
 #define COMPOSITION_STRATEGY 1
+#endif
+
+#include <iterator>
 
 #include "curves/SE3CompositionCurve.hpp"
+#include "curves/cubic_hermite_kernels.hpp"
 #include "curves/helpers.hpp"
 
 namespace curves{
@@ -44,8 +49,9 @@ void SE3CompositionCurve<C1, C2>::saveCurves(const std::string& filename) const
   Eigen::VectorXd v(7);
 
   std::vector<Eigen::VectorXd> baseCurveValues;
+  ValueType val;
   for (size_t i = 0; i < baseCurveTimes.size(); ++i) {
-    ValueType val = baseCurve_.evaluate(baseCurveTimes[i]);
+    baseCurve_.evaluate(val, baseCurveTimes[i]);
     v << val.getPosition().x(), val.getPosition().y(), val.getPosition().z(),
         val.getRotation().w(), val.getRotation().x(), val.getRotation().y(), val.getRotation().z();
     baseCurveValues.push_back(v);
@@ -55,15 +61,17 @@ void SE3CompositionCurve<C1, C2>::saveCurves(const std::string& filename) const
   correctionCurve_.manager_.getTimes(&correctionCurveTimes);
   std::vector<Eigen::VectorXd> correctionCurveValues;
   for (size_t i = 0; i < correctionCurveTimes.size(); ++i) {
-    ValueType val = correctionCurve_.evaluate(correctionCurveTimes[i]);
+    correctionCurve_.evaluate(val, correctionCurveTimes[i]);
     v << val.getPosition().x(), val.getPosition().y(), val.getPosition().z(),
         val.getRotation().w(), val.getRotation().x(), val.getRotation().y(), val.getRotation().z();
     correctionCurveValues.push_back(v);
   }
 
   std::vector<Eigen::VectorXd> combinedCurveValues;
-  for (size_t i = 0; i < baseCurveTimes.size(); ++i) {
-    ValueType val = this->evaluate(baseCurveTimes[i]);
+  std::vector<ValueType> combinedValues;
+  this->evaluate(baseCurveTimes, &combinedValues);
+  for (size_t i = 0; i < combinedValues.size(); ++i) {
+    const ValueType& val = combinedValues[i];
     v << val.getPosition().x(), val.getPosition().y(), val.getPosition().z(),
         val.getRotation().w(), val.getRotation().x(), val.getRotation().y(), val.getRotation().z();
     combinedCurveValues.push_back(v);
@@ -156,15 +164,18 @@ void SE3CompositionCurve<C1, C2>::extend(const std::vector<Time>& times,
     correctionCurve_.extend(correctionTimes, correctionValues);
   }
 
+  ValueType correction;
   if (correctionCurve_.getMaxTime() < newMaxTime) {
     correctionTimes.push_back(newMaxTime);
-    correctionValues.push_back(correctionCurve_.evaluate(correctionCurve_.getMaxTime()));
+    correctionCurve_.evaluate(correction, correctionCurve_.getMaxTime());
+    correctionValues.push_back(correction);
     correctionCurve_.extend(correctionTimes, correctionValues);
   }
 
   if (correctionCurve_.getMinTime() > newMinTime) {
     correctionTimes.push_back(newMinTime);
-    correctionValues.push_back(correctionCurve_.evaluate(correctionCurve_.getMinTime()));
+    correctionCurve_.evaluate(correction, correctionCurve_.getMinTime());
+    correctionValues.push_back(correction);
     correctionCurve_.extend(correctionTimes, correctionValues);
   }
 
@@ -172,7 +183,8 @@ void SE3CompositionCurve<C1, C2>::extend(const std::vector<Time>& times,
   std::vector<ValueType> newValues;
   std::vector<ValueType>::const_iterator itValues = values.begin();
   for (std::vector<Time>::const_iterator it = times.begin(); it != times.end(); ++it) {
-    newValues.push_back(correctionCurve_.evaluate(*it).inverted() * (*itValues));
+    correctionCurve_.evaluate(correction, *it);
+    newValues.push_back(correction.inverted() * (*itValues));
     ++itValues;
   }
   baseCurve_.extend(times, newValues, outKeys);
@@ -180,23 +192,95 @@ void SE3CompositionCurve<C1, C2>::extend(const std::vector<Time>& times,
 
 template <class C1, class C2>
 void SE3CompositionCurve<C1, C2>::foldInCorrections() {
-  std::cout << "foldincorrections" << std::endl;
-  std::vector<Time> times;
-  std::vector<ValueType> newValues;
-  baseCurve_.manager_.getTimes(&times);
-  for (std::vector<Time>::const_iterator it = times.begin(); it != times.end(); ++it) {
-    newValues.push_back(this->evaluate(*it));
+  if (!correctionCurve_.isEmpty()) {
+    foldInCorrections(correctionCurve_.getMinTime(), correctionCurve_.getMaxTime());
   }
-  baseCurve_.clear();
-  baseCurve_.extend(times,newValues);
-  times.clear();
-  newValues.clear();
-  correctionCurve_.manager_.getTimes(&times);
-  for (std::vector<Time>::const_iterator it = times.begin(); it != times.end(); ++it) {
-    newValues.push_back(ValueType(ValueType::Position(0,0,0), ValueType::Rotation(1,0,0,0)));
+}
+
+template <class C1, class C2>
+template <class Manager>
+typename Manager::CoefficientIter SE3CompositionCurve<C1, C2>::lowerBoundKnot(const Manager& manager, Time time) {
+  if (manager.empty() || time <= manager.getMinTime()) {
+    return manager.coefficientBegin();
+  }
+  if (time > manager.getMaxTime()) {
+    return manager.coefficientEnd();
+  }
+  typename Manager::CoefficientIter a, b;
+  manager.getCoefficientsAt(time, &a, &b);
+  return a->first < time ? b : a;
+}
+
+template <class C1, class C2>
+template <class Manager>
+typename Manager::CoefficientIter SE3CompositionCurve<C1, C2>::upperBoundKnot(const Manager& manager, Time time) {
+  if (manager.empty() || time >= manager.getMaxTime()) {
+    return manager.coefficientEnd();
+  }
+  if (time < manager.getMinTime()) {
+    return manager.coefficientBegin();
+  }
+  typename Manager::CoefficientIter a, b;
+  manager.getCoefficientsAt(time, &a, &b);
+  return b;
+}
+
+template <class C1, class C2>
+void SE3CompositionCurve<C1, C2>::foldInCorrections(Time begTime, Time endTime) {
+  const typename C2::CoefficientIter correctionBegin = correctionCurve_.manager_.coefficientBegin();
+  const typename C2::CoefficientIter correctionEnd = correctionCurve_.manager_.coefficientEnd();
+  const typename C2::CoefficientIter first = lowerBoundKnot(correctionCurve_.manager_, begTime);
+  const typename C2::CoefficientIter last = upperBoundKnot(correctionCurve_.manager_, endTime);
+  std::vector<Time> correctionTimes;
+  for (typename C2::CoefficientIter it = first; it != last && begTime <= endTime; ++it) {
+    correctionTimes.push_back(it->first);
+  }
+  if (correctionTimes.empty()) {
+    return;
+  }
+
+  // Resetting these correction knots changes the correction curve between the untouched
+  // correction knots around them, the base knots in between have to absorb the difference.
+  const bool hasPrecedingKnot = first != correctionBegin;
+  const bool hasFollowingKnot = last != correctionEnd;
+  const Time foldBegTime = hasPrecedingKnot ? std::prev(first)->first : correctionTimes.front();
+  const Time foldEndTime = hasFollowingKnot ? last->first : correctionTimes.back();
+  std::vector<Time> baseTimes;
+  const typename C1::CoefficientIter baseLast = upperBoundKnot(baseCurve_.manager_, foldEndTime);
+  for (typename C1::CoefficientIter it = lowerBoundKnot(baseCurve_.manager_, foldBegTime); it != baseLast; ++it) {
+    // The correction is unchanged at the untouched knots.
+    if ((hasPrecedingKnot && it->first == foldBegTime) || (hasFollowingKnot && it->first == foldEndTime)) {
+      continue;
+    }
+    baseTimes.push_back(it->first);
+  }
+  std::vector<ValueType> composedValues;
+  if (!this->evaluate(baseTimes, &composedValues)) {
+    LOG(ERROR) << "Unable to evaluate the composed curve at the base knots in [" << foldBegTime
+               << ", " << foldEndTime << "], the corrections are not folded in.";
+    return;
+  }
+
+  correctionCurve_.manager_.modifyCoefficientsValuesInBatch(
+      correctionTimes,
+      std::vector<ValueType>(correctionTimes.size(),
+                             ValueType(ValueType::Position(0,0,0), ValueType::Rotation(1,0,0,0))));
+
+  // The correction is identity between the reset knots.
+  ValueType correction;
+  for (size_t i = 0; i < baseTimes.size(); ++i) {
+    if (baseTimes[i] >= correctionTimes.front() && baseTimes[i] <= correctionTimes.back()) {
+      continue;
+    }
+    if (!correctionCurve_.evaluate(correction, baseTimes[i])) {
+      LOG(ERROR) << "Unable to evaluate the correction at " << baseTimes[i] << ".";
+      continue;
+    }
+    composedValues[i] = correction.inverted() * composedValues[i];
+  }
+  if (!baseTimes.empty()) {
+    baseCurve_.manager_.modifyCoefficientsValuesInBatch(baseTimes, composedValues);
   }
-  correctionCurve_.clear();
-  correctionCurve_.extend(times,newValues);
 }
 
 template <class C1, class C2>
@@ -209,9 +293,9 @@ void SE3CompositionCurve<C1, C2>::fitCurve(const std::vector<Time>& times,
 template <class C1, class C2>
 void SE3CompositionCurve<C1, C2>::setCorrectionTimes(const std::vector<Time>& times) {
   // Evaluate the correction curve at these times
-  std::vector<ValueType> values;
+  std::vector<ValueType> values(times.size());
   for (size_t i = 0; i < times.size(); ++i) {
-    values.push_back(correctionCurve_.evaluate(times[i]));
+    correctionCurve_.evaluate(values[i], times[i]);
   }
 
   // Redefine the correction curve
@@ -223,63 +307,131 @@ void SE3CompositionCurve<C1, C2>::setCorrectionTimes(const std::vector<Time>& ti
 }
 
 template <class C1, class C2>
-typename SE3CompositionCurve<C1, C2>::ValueType SE3CompositionCurve<C1, C2>::evaluate(Time time) const{
+bool SE3CompositionCurve<C1, C2>::evaluate(ValueType& value, Time time) const{
 
 #if COMPOSITION_STRATEGY == 1
   // (1) corr(t) * base(t) is implemented
-  return correctionCurve_.evaluate(time) * baseCurve_.evaluate(time);
+  return evaluateComposition(value, time);
 #elif COMPOSITION_STRATEGY == 2
   // (2) corr is evaluated at the coefficient times (t1, t2) where the interpolation
   //     on base is computed resulting in
   //     interpolation(corr(t1) * base(t1), corr(t2) * base(t2), alpha)
-  if (time == 0) {
-    return correctionCurve_.evaluate(time) * baseCurve_.evaluate(time);
+  typename C1::CoefficientIter a, b;
+  if (!baseCurve_.manager_.getCoefficientsAt(time, &a, &b)) {
+    // The base curve may only be defined at this one time.
+    return evaluateComposition(value, time);
+  }
+  if (a->first == time || b->first == time) {
+    return evaluateComposition(value, time);
   }
+  // The base values at the knots are the coefficients, only the correction is evaluated.
+  ValueType T_W_A, T_W_B;
+  if (!evaluateCorrectedKnot(T_W_A, a) || !evaluateCorrectedKnot(T_W_B, b)) {
+    return false;
+  }
+  value = interpolateComposedKnots(T_W_A, T_W_B, double(time - a->first) / double(b->first - a->first));
+  return true;
+#endif
+}
 
-  typename C2::CoefficientIter it1, it2;
-  baseCurve_.manager_.getCoefficientsAt(time, &it1, &it2);
-  //todo Is it true that the value of a curve at a time where a coefficient
-  // is defined is always only dependent on this coefficient?
-  if(it1->first == time || it2->first == time) {
-    return correctionCurve_.evaluate(time) * baseCurve_.evaluate(time);
-  } else {
-    Time tA, tB;
-    ValueType A, B, dA, dB, T_W_A, T_W_B;
-    //if the iterators returned are in order ( last element bug)
-    if (it1->first < it2->first) {
-      tA = it1->first;
-      tB = it2->first;
+template <class C1, class C2>
+bool SE3CompositionCurve<C1, C2>::evaluate(const std::vector<Time>& times,
+                                           std::vector<ValueType>* values) const {
+  CHECK_NOTNULL(values);
+  values->resize(times.size());
+#if COMPOSITION_STRATEGY == 1
+  // Both curves walk their own knots with a shared cursor, the samples are composed afterwards.
+  std::vector<ValueType> corrections;
+  if (!baseCurve_.evaluate(times, values) || !correctionCurve_.evaluate(times, &corrections)) {
+    return false;
+  }
+  for (size_t i = 0; i < times.size(); ++i) {
+    (*values)[i] = corrections[i] * (*values)[i];
+  }
+  return true;
+#elif COMPOSITION_STRATEGY == 2
+  // Shared cursor over the base intervals. The composed knot values only change when the
+  // cursor moves to another interval, and the end of one interval is the start of the next.
+  typename C1::CoefficientIter a, b;
+  ValueType T_W_A, T_W_B;
+  bool hasInterval = false;
+  for (size_t i = 0; i < times.size(); ++i) {
+    const Time time = times[i];
+    if (!hasInterval || time < a->first || time > b->first) {
+      typename C1::CoefficientIter newA, newB;
+      if (!baseCurve_.manager_.getCoefficientsAt(time, &newA, &newB)) {
+        if (!evaluateComposition((*values)[i], time)) {
+          return false;
+        }
+        continue;
+      }
+      if (hasInterval && newA == b) {
+        T_W_A = T_W_B;
+      } else if (!evaluateCorrectedKnot(T_W_A, newA)) {
+        return false;
+      }
+      if (!evaluateCorrectedKnot(T_W_B, newB)) {
+        return false;
+      }
+      a = newA;
+      b = newB;
+      hasInterval = true;
+    }
+    if (time == a->first) {
+      (*values)[i] = T_W_A;
+    } else if (time == b->first) {
+      (*values)[i] = T_W_B;
     } else {
-      tA = it2->first;
-      tB = it1->first;
+      (*values)[i] = interpolateComposedKnots(T_W_A, T_W_B, double(time - a->first) / double(b->first - a->first));
     }
+  }
+  return true;
+#endif
+}
 
-    double alpha = double(time - tA)/double(tB - tA);
-
-    A = baseCurve_.evaluate(tA);
-    B = baseCurve_.evaluate(tB);
-    dA = correctionCurve_.evaluate(tA);
-    dB = correctionCurve_.evaluate(tB);
-
-    T_W_A = dA * A;
-    T_W_B = dB * B;
+template <class C1, class C2>
+bool SE3CompositionCurve<C1, C2>::evaluateComposition(ValueType& value, Time time) const {
+  ValueType correction, base;
+  if (!correctionCurve_.evaluate(correction, time) || !baseCurve_.evaluate(base, time)) {
+    return false;
+  }
+  value = correction * base;
+  return true;
+}
 
-    //Implementation of T_W_I = T_W_A*exp(alpha*log(inv(T_W_A)*T_W_B))
-    using namespace kindr::minimal;
-    ValueType T_A_B = invertAndComposeImplementation(T_W_A, T_W_B, boost::none, boost::none);
-    gtsam::Vector6 log_T_A_B = transformationLogImplementation(T_A_B, boost::none);
-    gtsam::Vector6 log_T_A_I = vectorScalingImplementation<int(6)>(log_T_A_B, alpha, boost::none, boost::none);
-    ValueType T_A_I = transformationExpImplementation(log_T_A_I, boost::none);
-    return composeImplementation(T_W_A, T_A_I, boost::none, boost::none);
+template <class C1, class C2>
+bool SE3CompositionCurve<C1, C2>::evaluateCorrectedKnot(ValueType& value,
+                                                        typename C1::CoefficientIter knot) const {
+  ValueType correction;
+  if (!correctionCurve_.evaluate(correction, knot->first)) {
+    return false;
   }
-#endif
+  value = correction * knot->second.coefficient;
+  return true;
+}
+
+template <class C1, class C2>
+typename SE3CompositionCurve<C1, C2>::ValueType SE3CompositionCurve<C1, C2>::interpolateComposedKnots(
+    const ValueType& T_W_A, const ValueType& T_W_B, double alpha) {
+  // log(T_A_B) = (rho, phi) with rho = Jl(phi)^-1 * t_A_B, and Jl(phi) = Jr(-phi).
+  const ValueType T_A_B = T_W_A.inverted() * T_W_B;
+  const Eigen::Vector3d phi = hermite_kernels::quaternionLog<double>(T_A_B.getRotation().toImplementation());
+  const Eigen::Vector3d rho = hermite_kernels::rightJacobianInverse<double>(Eigen::Vector3d(-phi))
+      * T_A_B.getPosition().toImplementation();
+  // exp(alpha * log(T_A_B)).
+  const Eigen::Vector3d phiI = alpha * phi;
+  const Eigen::Quaterniond q_A_I = hermite_kernels::quaternionExp<double>(phiI);
+  const Eigen::Vector3d t_A_I = hermite_kernels::rightJacobian<double>(Eigen::Vector3d(-phiI)) * (alpha * rho);
+  return T_W_A * ValueType(typename ValueType::Position(t_A_I),
+                           typename ValueType::Rotation(q_A_I.w(), q_A_I.x(), q_A_I.y(), q_A_I.z()));
 }
 
 template <class C1, class C2>
-typename SE3CompositionCurve<C1, C2>::DerivativeType SE3CompositionCurve<C1, C2>::evaluateDerivative(Time time,
-                                                                                                     unsigned derivativeOrder) const{
+bool SE3CompositionCurve<C1, C2>::evaluateDerivative(DerivativeType& /*derivative*/, Time /*time*/,
+                                                     unsigned /*derivativeOrder*/) const{
   //todo
-  return typename SE3CompositionCurve<C1, C2>::DerivativeType();
+  std::cerr << "SE3CompositionCurve::evaluateDerivative: not implemented!" << std::endl;
+  return false;
 }
 
 template <class C1, class C2>
@@ -431,9 +583,10 @@ void SE3CompositionCurve<C1, C2>::saveCurveAtTimes(const std::string& filename,
   Eigen::VectorXd v(7);
 
   std::vector<Eigen::VectorXd> curveValues;
-  ValueType val;
-  for (size_t i = 0; i < times.size(); ++i) {
-    val = evaluate(times[i]);
+  std::vector<ValueType> values;
+  evaluate(times, &values);
+  for (size_t i = 0; i < values.size(); ++i) {
+    const ValueType& val = values[i];
     v << val.getPosition().x(), val.getPosition().y(), val.getPosition().z(),
         val.getRotation().w(), val.getRotation().x(), val.getRotation().y(), val.getRotation().z();
     curveValues.push_back(v);
@@ -457,7 +610,7 @@ void SE3CompositionCurve<C1, C2>::saveCorrectionCurveAtTimes(const std::string&
   std::vector<Eigen::VectorXd> curveValues;
   ValueType val;
   for (size_t i = 0; i < times.size(); ++i) {
-    val = correctionCurve_.evaluate(times[i]);
+    correctionCurve_.evaluate(val, times[i]);
     v << val.getPosition().x(), val.getPosition().y(), val.getPosition().z(),
         val.getRotation().w(), val.getRotation().x(), val.getRotation().y(), val.getRotation().z();
     curveValues.push_back(v);
@@ -71,6 +71,14 @@ class SE3CompositionCurve : public SE3Curve {
     ///        correction curve coefficients to identity transformations.
     void foldInCorrections();
 
+    /// \brief Fold in the corrections of the correction knots in [begTime, endTime] and
+    ///        reinitialize these coefficients to identity transformations.
+    ///
+    /// The window may lie anywhere in the curve. The base coefficients between the correction
+    /// knots preceding and following the window are modified in place, the work is proportional
+    /// to their number. The composed curve is unchanged at the base knots.
+    void foldInCorrections(Time begTime, Time endTime);
+
     /// \brief Fit a new curve to these data points.
     ///
     /// The existing curve will be cleared.
@@ -83,7 +91,15 @@ class SE3CompositionCurve : public SE3Curve {
     void setCorrectionTimes(const std::vector<Time>& times);
 
     /// Evaluate the ambient space of the curve.
-    virtual ValueType evaluate(Time time) const;
+    virtual bool evaluate(ValueType& value, Time time) const;
+
+    /// \brief Evaluate the curve at several times, fastest when the times are sorted.
+    ///
+    /// With COMPOSITION_STRATEGY 1 the base and correction curves are each evaluated in batch,
+    /// walking their knots with a shared cursor. With COMPOSITION_STRATEGY 2 the base knots are
+    /// walked with a shared cursor and the composed knot values corr(t_i) * base(t_i) are
+    /// computed once per base interval.
+    bool evaluate(const std::vector<Time>& times, std::vector<ValueType>* values) const;
 
     /// Evaluate the curve derivatives.
     /// linear 1st derivative has following behaviour:
@@ -92,7 +108,7 @@ class SE3CompositionCurve : public SE3Curve {
     /// - time is on coefficient (not last coefficient) --> take slope between coefficient and next coefficients
     /// - time is on last coefficient --> take slope between last-1 and last coefficient
     /// derivatives of order >1 equal 0
-    virtual DerivativeType evaluateDerivative(Time time, unsigned derivativeOrder) const;
+    virtual bool evaluateDerivative(DerivativeType& derivative, Time time, unsigned derivativeOrder) const;
 
     virtual void setTimeRange(Time minTime, Time maxTime);
 
@@ -180,6 +196,24 @@ class SE3CompositionCurve : public SE3Curve {
     void getBaseCurveTimesInWindow(std::vector<Time>* outTimes, Time begTime, Time endTime) const;
 
     void getCurveTimes(std::vector<Time>* outTimes) const;
+
+ private:
+    /// \brief corr(time) * base(time).
+    bool evaluateComposition(ValueType& value, Time time) const;
+
+    /// \brief corr(t_i) * base(t_i) at a base knot, base(t_i) being its coefficient.
+    bool evaluateCorrectedKnot(ValueType& value, typename C1::CoefficientIter knot) const;
+
+    /// \brief T_W_A * exp(alpha * log(T_W_A^-1 * T_W_B)) on SE3.
+    static ValueType interpolateComposedKnots(const ValueType& T_W_A, const ValueType& T_W_B, double alpha);
+
+    /// \brief First knot of the manager at or after time.
+    template <class Manager>
+    static typename Manager::CoefficientIter lowerBoundKnot(const Manager& manager, Time time);
+
+    /// \brief First knot of the manager after time.
+    template <class Manager>
+    static typename Manager::CoefficientIter upperBoundKnot(const Manager& manager, Time time);
 };
 
 } // namespace curves
@@ -106,6 +106,11 @@ class SE3Curve : public Curve<SE3Config> {
   ///        correction curve coefficients to identity transformations.
   virtual void foldInCorrections() = 0;
 
+  /// \brief Fold in the corrections of the correction knots in [begTime, endTime] and
+  ///        reinitialize these coefficients to identity transformations.
+  ///        Curves without a correction curve have nothing to fold in, by default nothing is done.
+  virtual void foldInCorrections(Time begTime, Time endTime);
+
   /// \brief Add coefficients to the correction curve at given times.
   virtual void setCorrectionTimes(const std::vector<Time>& times) = 0;
 
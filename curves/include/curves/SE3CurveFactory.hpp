@@ -9,10 +9,13 @@
 
 #include "SE3Curve.hpp"
 #include "SlerpSE3Curve.hpp"
+#ifdef CURVES_USE_GTSAM
 #include "DiscreteSE3Curve.hpp"
 #include "SemiDiscreteSE3Curve.hpp"
+#endif
 #include "SE3CompositionCurve.hpp"
 
+#include <memory>
 #include <string>
 
 namespace curves {
@@ -24,6 +27,8 @@ class SE3CurveFactory {
   SE3CurveFactory() {}
   ~SE3CurveFactory() {}
 
+  /// \brief Create a curve by name. The discrete curves are only available when
+  ///        the library is built with CURVES_USE_GTSAM.
   static std::shared_ptr<SE3Curve> create_curve(const std::string& curveType);
 
 }; // class SE3CurveFactory
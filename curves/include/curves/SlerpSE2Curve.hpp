@@ -10,7 +10,9 @@
 #include "SE2Curve.hpp"
 #include "LocalSupport2CoefficientManager.hpp"
 //#include "SE2CompositionCurve.hpp"
+#include "gtsam/nonlinear/Expression.h"
 #include "gtsam/nonlinear/NonlinearFactorGraph.h"
+#include "gtsam/nonlinear/Values.h"
 #include "SamplingPolicy.hpp"
 
 namespace curves {
@@ -67,7 +69,7 @@ class SlerpSE2Curve : public SE2Curve {
                 const std::vector<ValueType>& values);
 
   /// Evaluate the ambient space of the curve.
-  virtual ValueType evaluate(Time time) const;
+  virtual bool evaluate(ValueType& value, Time time) const;
 
   /// Evaluate the curve derivatives.
   /// linear 1st derivative has following behaviour:
@@ -76,13 +78,11 @@ class SlerpSE2Curve : public SE2Curve {
   /// - time is on coefficient (not last coefficient) --> take slope between coefficient and next coefficients
   /// - time is on last coefficient --> take slope between last-1 and last coefficient
   /// derivatives of order >1 equal 0
-  virtual DerivativeType evaluateDerivative(Time time, unsigned derivativeOrder) const;
+  virtual bool evaluateDerivative(DerivativeType& derivative, Time time, unsigned derivativeOrder) const;
 
   /// \brief Get an evaluator at this time
   virtual gtsam::Expression<ValueType> getValueExpression(const Time& time) const;
 
-  virtual gtsam::Expression<DerivativeType> getDerivativeExpression(const Time& time, unsigned derivativeOrder) const;
-
   virtual void setTimeRange(Time minTime, Time maxTime);
 
   /// Initialize a GTSAM values structure with the desired keys
@@ -109,7 +109,7 @@ class SlerpSE2Curve : public SE2Curve {
   /// \brief Perform a rigid transformation on the left side of the curve
   void transformCurve(const ValueType T);
 
-  virtual Time getTimeAtKey(gtsam::Key key) const;
+  virtual Time getTimeAtKey(Key key) const;
 
   void saveCurveTimesAndValues(const std::string& filename) const;
 
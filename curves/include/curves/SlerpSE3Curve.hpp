@@ -9,6 +9,7 @@
 #pragma once
 
 #include "SE3Curve.hpp"
+#include "CoefficientExpression.hpp"
 #include "LocalSupport2CoefficientManager.hpp"
 #include "kindr/Core"
 #include "SE3CompositionCurve.hpp"
@@ -69,7 +70,15 @@ class SlerpSE3Curve : public SE3Curve {
                 const std::vector<ValueType>& values);
 
   /// Evaluate the ambient space of the curve.
-  virtual ValueType evaluate(Time time) const;
+  virtual bool evaluate(ValueType& value, Time time) const;
+
+  /// \brief Evaluate the curve at several times, fastest when the times are sorted.
+  ///
+  /// The log of each interval is computed once and reused by all the samples within it.
+  bool evaluate(const std::vector<Time>& times, std::vector<ValueType>* values) const;
+
+  /// \brief Get an expression of the value at this time in terms of the curve coefficients.
+  CoefficientExpression<ValueType> getValueExpression(const Time& time) const;
 
   /// Evaluate the curve derivatives.
   /// linear 1st derivative has following behaviour:
@@ -78,7 +87,11 @@ class SlerpSE3Curve : public SE3Curve {
   /// - time is on coefficient (not last coefficient) --> take slope between coefficient and next coefficients
   /// - time is on last coefficient --> take slope between last-1 and last coefficient
   /// derivatives of order >1 equal 0
-  virtual DerivativeType evaluateDerivative(Time time, unsigned derivativeOrder) const;
+  virtual bool evaluateDerivative(DerivativeType& derivative, Time time, unsigned derivativeOrder) const;
+
+  /// \brief Evaluate the curve derivatives at several times, fastest when the times are sorted.
+  bool evaluateDerivative(const std::vector<Time>& times, unsigned derivativeOrder,
+                          std::vector<DerivativeType>* derivatives) const;
 
   virtual void setTimeRange(Time minTime, Time maxTime);
 
@@ -156,6 +169,8 @@ class SlerpSE3Curve : public SE3Curve {
   ///        correction curve coefficients to identity transformations.
   void foldInCorrections() {}
 
+  using SE3Curve::foldInCorrections;
+
   /// \brief Add coefficients to the correction curve at given times.
   void setCorrectionTimes(const std::vector<Time>& /*times*/) {}
 
@@ -0,0 +1,346 @@
+/*
+ * cubic_hermite_kernels.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#pragma once
+
+// stl
+#include <cmath>
+
+// eigen
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+namespace curves {
+namespace hermite_kernels {
+
+/*!
+ * Scalar cubic Hermite evaluation kernels shared by the E3 and SE3 Hermite curves.
+ * All kernels are templated on the scalar type (double, float or an autodiff scalar) and
+ * work on the interval [A, B] with duration dt and normalized time alpha in [0, 1].
+ * Velocities at the knots are given in the world frame, quaternions are Hamilton (w, x, y, z).
+ */
+template<typename Scalar_>
+using Vector3 = Eigen::Matrix<Scalar_, 3, 1>;
+
+template<typename Scalar_>
+using Quaternion = Eigen::Quaternion<Scalar_>;
+
+//! Unit quaternion of the rotation vector v.
+template<typename Scalar_>
+Quaternion<Scalar_> quaternionExp(const Vector3<Scalar_>& v) {
+  using std::cos;
+  using std::sin;
+  using std::sqrt;
+  const Scalar_ squaredNorm = v.squaredNorm();
+  if (squaredNorm < Scalar_(1e-16)) {
+    // First order expansion, keeps autodiff derivatives finite at zero.
+    return Quaternion<Scalar_>(Scalar_(1.0), Scalar_(0.5) * v.x(), Scalar_(0.5) * v.y(), Scalar_(0.5) * v.z()).normalized();
+  }
+  const Scalar_ norm = sqrt(squaredNorm);
+  const Scalar_ halfAngle = Scalar_(0.5) * norm;
+  const Vector3<Scalar_> imaginary = v * (sin(halfAngle) / norm);
+  return Quaternion<Scalar_>(cos(halfAngle), imaginary.x(), imaginary.y(), imaginary.z());
+}
+
+//! Rotation vector of the unit quaternion q (shortest rotation).
+template<typename Scalar_>
+Vector3<Scalar_> quaternionLog(const Quaternion<Scalar_>& q) {
+  using std::atan2;
+  using std::sqrt;
+  Scalar_ w = q.w();
+  Vector3<Scalar_> imaginary = q.vec();
+  if (w < Scalar_(0.0)) {
+    w = -w;
+    imaginary = -imaginary;
+  }
+  const Scalar_ squaredNorm = imaginary.squaredNorm();
+  if (squaredNorm < Scalar_(1e-16)) {
+    return Scalar_(2.0) * imaginary;
+  }
+  const Scalar_ norm = sqrt(squaredNorm);
+  return imaginary * (Scalar_(2.0) * atan2(norm, w) / norm);
+}
+
+//! Position on the interval.
+template<typename Scalar_>
+Vector3<Scalar_> evaluatePosition(const Vector3<Scalar_>& positionA, const Vector3<Scalar_>& velocityA,
+                                  const Vector3<Scalar_>& positionB, const Vector3<Scalar_>& velocityB,
+                                  Scalar_ dt, Scalar_ alpha) {
+  const Scalar_ alpha2 = alpha * alpha;
+  const Scalar_ alpha3 = alpha2 * alpha;
+  const Scalar_ beta0 = Scalar_(2.0) * alpha3 - Scalar_(3.0) * alpha2 + Scalar_(1.0);
+  const Scalar_ beta1 = Scalar_(-2.0) * alpha3 + Scalar_(3.0) * alpha2;
+  const Scalar_ beta2 = alpha3 - Scalar_(2.0) * alpha2 + alpha;
+  const Scalar_ beta3 = alpha3 - alpha2;
+  return positionA * beta0 + positionB * beta1 + velocityA * (beta2 * dt) + velocityB * (beta3 * dt);
+}
+
+//! First time derivative of the position on the interval.
+template<typename Scalar_>
+Vector3<Scalar_> evaluateLinearVelocity(const Vector3<Scalar_>& positionA, const Vector3<Scalar_>& velocityA,
+                                        const Vector3<Scalar_>& positionB, const Vector3<Scalar_>& velocityB,
+                                        Scalar_ dt, Scalar_ alpha) {
+  const Scalar_ oneOverDt = Scalar_(1.0) / dt;
+  const Scalar_ alpha2 = alpha * alpha;
+  const Scalar_ gamma0 = Scalar_(6.0) * (alpha2 - alpha);
+  const Scalar_ gamma1 = Scalar_(3.0) * alpha2 - Scalar_(4.0) * alpha + Scalar_(1.0);
+  const Scalar_ gamma2 = Scalar_(6.0) * (alpha - alpha2);
+  const Scalar_ gamma3 = Scalar_(3.0) * alpha2 - Scalar_(2.0) * alpha;
+  return positionA * (gamma0 * oneOverDt) + velocityA * gamma1 + positionB * (gamma2 * oneOverDt) + velocityB * gamma3;
+}
+
+//! Second time derivative of the position on the interval.
+template<typename Scalar_>
+Vector3<Scalar_> evaluateLinearAcceleration(const Vector3<Scalar_>& positionA, const Vector3<Scalar_>& velocityA,
+                                            const Vector3<Scalar_>& positionB, const Vector3<Scalar_>& velocityB,
+                                            Scalar_ dt, Scalar_ alpha) {
+  const Scalar_ oneOverDt = Scalar_(1.0) / dt;
+  const Scalar_ dGamma0 = Scalar_(6.0) * (Scalar_(2.0) * alpha - Scalar_(1.0)) * oneOverDt;
+  const Scalar_ dGamma1 = (Scalar_(6.0) * alpha - Scalar_(4.0)) * oneOverDt;
+  const Scalar_ dGamma2 = Scalar_(6.0) * (Scalar_(1.0) - Scalar_(2.0) * alpha) * oneOverDt;
+  const Scalar_ dGamma3 = (Scalar_(6.0) * alpha - Scalar_(2.0)) * oneOverDt;
+  return positionA * (dGamma0 * oneOverDt) + velocityA * dGamma1 + positionB * (dGamma2 * oneOverDt) + velocityB * dGamma3;
+}
+
+/*!
+ * Local rotation tangents of the interval (see KimKimShin):
+ *   w1 = R_A^T * wA * dt / 3,  w3 = R_B^T * wB * dt / 3,
+ *   w2 = log( exp(w1)^{-1} * q_A^{-1} * q_B * exp(w3)^{-1} ).
+ */
+template<typename Scalar_>
+void computeRotationTangents(const Quaternion<Scalar_>& rotationA, const Vector3<Scalar_>& angularVelocityA,
+                             const Quaternion<Scalar_>& rotationB, const Vector3<Scalar_>& angularVelocityB,
+                             Scalar_ dt, Vector3<Scalar_>* w1, Vector3<Scalar_>* w2, Vector3<Scalar_>* w3) {
+  const Scalar_ dtThird = dt / Scalar_(3.0);
+  *w1 = rotationA.conjugate() * (angularVelocityA * dtThird);
+  *w3 = rotationB.conjugate() * (angularVelocityB * dtThird);
+  const Vector3<Scalar_> minusW1 = -(*w1);
+  const Vector3<Scalar_> minusW3 = -(*w3);
+  *w2 = quaternionLog<Scalar_>(quaternionExp<Scalar_>(minusW1) * rotationA.conjugate() * rotationB
+                               * quaternionExp<Scalar_>(minusW3));
+}
+
+//! Rotation on the interval, q = q_A * exp(b1*w1) * exp(b2*w2) * exp(b3*w3).
+template<typename Scalar_>
+Quaternion<Scalar_> evaluateRotation(const Quaternion<Scalar_>& rotationA, const Vector3<Scalar_>& angularVelocityA,
+                                     const Quaternion<Scalar_>& rotationB, const Vector3<Scalar_>& angularVelocityB,
+                                     Scalar_ dt, Scalar_ alpha) {
+  Vector3<Scalar_> w1, w2, w3;
+  computeRotationTangents<Scalar_>(rotationA, angularVelocityA, rotationB, angularVelocityB, dt, &w1, &w2, &w3);
+  const Scalar_ alpha2 = alpha * alpha;
+  const Scalar_ alpha3 = alpha2 * alpha;
+  const Scalar_ beta1 = alpha3 - Scalar_(3.0) * alpha2 + Scalar_(3.0) * alpha;
+  const Scalar_ beta2 = Scalar_(-2.0) * alpha3 + Scalar_(3.0) * alpha2;
+  const Scalar_ beta3 = alpha3;
+  const Vector3<Scalar_> v1 = beta1 * w1;
+  const Vector3<Scalar_> v2 = beta2 * w2;
+  const Vector3<Scalar_> v3 = beta3 * w3;
+  return rotationA * quaternionExp<Scalar_>(v1) * quaternionExp<Scalar_>(v2) * quaternionExp<Scalar_>(v3);
+}
+
+//! Angular velocity on the interval, expressed in the world frame.
+template<typename Scalar_>
+Vector3<Scalar_> evaluateAngularVelocity(const Quaternion<Scalar_>& rotationA, const Vector3<Scalar_>& angularVelocityA,
+                                         const Quaternion<Scalar_>& rotationB, const Vector3<Scalar_>& angularVelocityB,
+                                         Scalar_ dt, Scalar_ alpha) {
+  Vector3<Scalar_> w1, w2, w3;
+  computeRotationTangents<Scalar_>(rotationA, angularVelocityA, rotationB, angularVelocityB, dt, &w1, &w2, &w3);
+  const Scalar_ oneMinusAlpha = Scalar_(1.0) - alpha;
+  const Scalar_ alpha2 = alpha * alpha;
+  const Scalar_ alpha3 = alpha2 * alpha;
+  const Scalar_ beta1 = Scalar_(1.0) - oneMinusAlpha * oneMinusAlpha * oneMinusAlpha;
+  const Scalar_ beta2 = Scalar_(3.0) * alpha2 - Scalar_(2.0) * alpha3;
+  const Scalar_ dBeta1 = Scalar_(3.0) * oneMinusAlpha * oneMinusAlpha;
+  const Scalar_ dBeta2 = Scalar_(6.0) * alpha * oneMinusAlpha;
+  const Scalar_ dBeta3 = Scalar_(3.0) * alpha2;
+  const Vector3<Scalar_> v1 = beta1 * w1;
+  const Vector3<Scalar_> v2 = beta2 * w2;
+  const Vector3<Scalar_> v3 = alpha3 * w3;
+  const Quaternion<Scalar_> q1 = rotationA * quaternionExp<Scalar_>(v1);
+  const Quaternion<Scalar_> q2 = q1 * quaternionExp<Scalar_>(v2);
+  const Quaternion<Scalar_> q3 = q2 * quaternionExp<Scalar_>(v3);
+  return (q1 * (dBeta1 * w1) + q2 * (dBeta2 * w2) + q3 * (dBeta3 * w3)) / dt;
+}
+
+//! Skew-symmetric matrix of v, skew(v) * u = v x u.
+template<typename Scalar_>
+Eigen::Matrix<Scalar_, 3, 3> skewMatrix(const Vector3<Scalar_>& v) {
+  Eigen::Matrix<Scalar_, 3, 3> m;
+  m << Scalar_(0.0), -v.z(), v.y(),
+       v.z(), Scalar_(0.0), -v.x(),
+       -v.y(), v.x(), Scalar_(0.0);
+  return m;
+}
+
+//! Right Jacobian of the SO3 exponential map, Exp(v + dv) = Exp(v) * Exp(Jr(v) * dv).
+template<typename Scalar_>
+Eigen::Matrix<Scalar_, 3, 3> rightJacobian(const Vector3<Scalar_>& v) {
+  using std::cos;
+  using std::sin;
+  using std::sqrt;
+  const Scalar_ squaredAngle = v.squaredNorm();
+  const Eigen::Matrix<Scalar_, 3, 3> skew = skewMatrix<Scalar_>(v);
+  Scalar_ a, b;
+  if (squaredAngle < Scalar_(1e-10)) {
+    a = Scalar_(0.5) - squaredAngle / Scalar_(24.0);
+    b = Scalar_(1.0) / Scalar_(6.0) - squaredAngle / Scalar_(120.0);
+  } else {
+    const Scalar_ angle = sqrt(squaredAngle);
+    a = (Scalar_(1.0) - cos(angle)) / squaredAngle;
+    b = (angle - sin(angle)) / (squaredAngle * angle);
+  }
+  return Eigen::Matrix<Scalar_, 3, 3>::Identity() - a * skew + b * skew * skew;
+}
+
+//! Inverse of the right Jacobian of the SO3 exponential map.
+template<typename Scalar_>
+Eigen::Matrix<Scalar_, 3, 3> rightJacobianInverse(const Vector3<Scalar_>& v) {
+  using std::cos;
+  using std::sin;
+  using std::sqrt;
+  const Scalar_ squaredAngle = v.squaredNorm();
+  const Eigen::Matrix<Scalar_, 3, 3> skew = skewMatrix<Scalar_>(v);
+  Scalar_ c;
+  if (squaredAngle < Scalar_(1e-10)) {
+    c = Scalar_(1.0) / Scalar_(12.0) + squaredAngle / Scalar_(720.0);
+  } else {
+    const Scalar_ angle = sqrt(squaredAngle);
+    c = Scalar_(1.0) / squaredAngle - (Scalar_(1.0) + cos(angle)) / (Scalar_(2.0) * angle * sin(angle));
+  }
+  return Eigen::Matrix<Scalar_, 3, 3>::Identity() + Scalar_(0.5) * skew + c * skew * skew;
+}
+
+/*!
+ * Derivative of a global rotation perturbation, R' = Exp(dtheta) * R, with respect to the raw
+ * (w, x, y, z) components of the unit quaternion q.
+ */
+template<typename Scalar_>
+Eigen::Matrix<Scalar_, 3, 4> quaternionToRotationVectorJacobian(const Quaternion<Scalar_>& q) {
+  Eigen::Matrix<Scalar_, 3, 4> jacobian;
+  jacobian.col(0) = Scalar_(-2.0) * q.vec();
+  jacobian.template rightCols<3>() = Scalar_(2.0) * (q.w() * Eigen::Matrix<Scalar_, 3, 3>::Identity()
+      + skewMatrix<Scalar_>(q.vec()));
+  return jacobian;
+}
+
+/*!
+ * Pose on the interval together with its Jacobians with respect to the two bracketing coefficients.
+ * The coefficient parameters are ordered as in HermiteSE3Coefficient:
+ *   [ px py pz | qw qx qy qz | vx vy vz | wx wy wz ].
+ * The rows are the position (0,1,2) and a global rotation perturbation R' = Exp(dtheta) * R (3,4,5).
+ */
+template<typename Scalar_>
+void evaluatePoseWithJacobians(const Vector3<Scalar_>& positionA, const Quaternion<Scalar_>& rotationA,
+                               const Vector3<Scalar_>& velocityA, const Vector3<Scalar_>& angularVelocityA,
+                               const Vector3<Scalar_>& positionB, const Quaternion<Scalar_>& rotationB,
+                               const Vector3<Scalar_>& velocityB, const Vector3<Scalar_>& angularVelocityB,
+                               Scalar_ dt, Scalar_ alpha,
+                               Vector3<Scalar_>* position, Quaternion<Scalar_>* rotation,
+                               Eigen::Matrix<Scalar_, 6, 13>* jacobianA,
+                               Eigen::Matrix<Scalar_, 6, 13>* jacobianB) {
+  typedef Eigen::Matrix<Scalar_, 3, 3> Matrix3;
+  const Matrix3 identity = Matrix3::Identity();
+
+  const Scalar_ alpha2 = alpha * alpha;
+  const Scalar_ alpha3 = alpha2 * alpha;
+  const Scalar_ beta0 = Scalar_(2.0) * alpha3 - Scalar_(3.0) * alpha2 + Scalar_(1.0);
+  const Scalar_ beta1 = Scalar_(-2.0) * alpha3 + Scalar_(3.0) * alpha2;
+  const Scalar_ beta2 = alpha3 - Scalar_(2.0) * alpha2 + alpha;
+  const Scalar_ beta3 = alpha3 - alpha2;
+  *position = positionA * beta0 + positionB * beta1 + velocityA * (beta2 * dt) + velocityB * (beta3 * dt);
+
+  // Rotation, see evaluateRotation.
+  Vector3<Scalar_> w1, w2, w3;
+  computeRotationTangents<Scalar_>(rotationA, angularVelocityA, rotationB, angularVelocityB, dt, &w1, &w2, &w3);
+  const Scalar_ rotationBeta1 = alpha3 - Scalar_(3.0) * alpha2 + Scalar_(3.0) * alpha;
+  const Scalar_ rotationBeta2 = beta1;
+  const Scalar_ rotationBeta3 = alpha3;
+  const Vector3<Scalar_> v1 = rotationBeta1 * w1;
+  const Vector3<Scalar_> v2 = rotationBeta2 * w2;
+  const Vector3<Scalar_> v3 = rotationBeta3 * w3;
+  const Quaternion<Scalar_> q1 = rotationA * quaternionExp<Scalar_>(v1);
+  const Quaternion<Scalar_> q2 = q1 * quaternionExp<Scalar_>(v2);
+  *rotation = q2 * quaternionExp<Scalar_>(v3);
+
+  if (jacobianA == NULL && jacobianB == NULL) {
+    return;
+  }
+
+  // Sensitivity of the global rotation perturbation to the local tangents w1, w2, w3.
+  const Matrix3 c1 = q1.toRotationMatrix() * rightJacobian<Scalar_>(v1) * rotationBeta1;
+  const Matrix3 c2 = q2.toRotationMatrix() * rightJacobian<Scalar_>(v2) * rotationBeta2;
+  const Matrix3 c3 = rotation->toRotationMatrix() * rightJacobian<Scalar_>(v3) * rotationBeta3;
+
+  // Tangents with respect to the knot rotations (global perturbations) and angular velocities.
+  const Scalar_ dtThird = dt / Scalar_(3.0);
+  const Matrix3 rotationATransposed = rotationA.toRotationMatrix().transpose();
+  const Matrix3 rotationBTransposed = rotationB.toRotationMatrix().transpose();
+  const Matrix3 dW1dThetaA = rotationATransposed * skewMatrix<Scalar_>(Vector3<Scalar_>(angularVelocityA * dtThird));
+  const Matrix3 dW1dOmegaA = rotationATransposed * dtThird;
+  const Matrix3 dW3dThetaB = rotationBTransposed * skewMatrix<Scalar_>(Vector3<Scalar_>(angularVelocityB * dtThird));
+  const Matrix3 dW3dOmegaB = rotationBTransposed * dtThird;
+
+  // w2 = Log(M), M = Exp(-w1) * R_A^T * R_B * Exp(-w3).
+  const Vector3<Scalar_> minusW1 = -w1;
+  const Vector3<Scalar_> minusW2 = -w2;
+  const Matrix3 leftJacobianInverseW2 = rightJacobianInverse<Scalar_>(minusW2);
+  const Matrix3 rightJacobianInverseW2 = rightJacobianInverse<Scalar_>(w2);
+  const Matrix3 expMinusW1RotationATransposed = quaternionExp<Scalar_>(minusW1).toRotationMatrix() * rotationATransposed;
+  const Matrix3 dW2dW1 = -leftJacobianInverseW2 * rightJacobian<Scalar_>(w1);
+  const Matrix3 dW2dW3 = -rightJacobianInverseW2 * rightJacobian<Scalar_>(Vector3<Scalar_>(-w3));
+  const Matrix3 dW2dThetaA = -leftJacobianInverseW2 * expMinusW1RotationATransposed + dW2dW1 * dW1dThetaA;
+  const Matrix3 dW2dThetaB = leftJacobianInverseW2 * expMinusW1RotationATransposed + dW2dW3 * dW3dThetaB;
+
+  if (jacobianA != NULL) {
+    jacobianA->setZero();
+    jacobianA->template block<3, 3>(0, 0) = beta0 * identity;
+    jacobianA->template block<3, 3>(0, 7) = (beta2 * dt) * identity;
+    const Matrix3 dThetadThetaA = identity + c1 * dW1dThetaA + c2 * dW2dThetaA;
+    jacobianA->template block<3, 4>(3, 3) = dThetadThetaA * quaternionToRotationVectorJacobian<Scalar_>(rotationA);
+    jacobianA->template block<3, 3>(3, 10) = (c1 + c2 * dW2dW1) * dW1dOmegaA;
+  }
+
+  if (jacobianB != NULL) {
+    jacobianB->setZero();
+    jacobianB->template block<3, 3>(0, 0) = beta1 * identity;
+    jacobianB->template block<3, 3>(0, 7) = (beta3 * dt) * identity;
+    const Matrix3 dThetadThetaB = c2 * dW2dThetaB + c3 * dW3dThetaB;
+    jacobianB->template block<3, 4>(3, 3) = dThetadThetaB * quaternionToRotationVectorJacobian<Scalar_>(rotationB);
+    jacobianB->template block<3, 3>(3, 10) = (c3 + c2 * dW2dW3) * dW3dOmegaB;
+  }
+}
+
+// Explicitly instantiated in cubic_hermite_kernels.cpp.
+#define CURVES_HERMITE_KERNELS_DECLARE(EXTERN, Scalar_) \
+  EXTERN template Quaternion<Scalar_> quaternionExp<Scalar_>(const Vector3<Scalar_>&); \
+  EXTERN template Vector3<Scalar_> quaternionLog<Scalar_>(const Quaternion<Scalar_>&); \
+  EXTERN template Vector3<Scalar_> evaluatePosition<Scalar_>(const Vector3<Scalar_>&, const Vector3<Scalar_>&, \
+      const Vector3<Scalar_>&, const Vector3<Scalar_>&, Scalar_, Scalar_); \
+  EXTERN template Vector3<Scalar_> evaluateLinearVelocity<Scalar_>(const Vector3<Scalar_>&, const Vector3<Scalar_>&, \
+      const Vector3<Scalar_>&, const Vector3<Scalar_>&, Scalar_, Scalar_); \
+  EXTERN template Vector3<Scalar_> evaluateLinearAcceleration<Scalar_>(const Vector3<Scalar_>&, const Vector3<Scalar_>&, \
+      const Vector3<Scalar_>&, const Vector3<Scalar_>&, Scalar_, Scalar_); \
+  EXTERN template void computeRotationTangents<Scalar_>(const Quaternion<Scalar_>&, const Vector3<Scalar_>&, \
+      const Quaternion<Scalar_>&, const Vector3<Scalar_>&, Scalar_, Vector3<Scalar_>*, Vector3<Scalar_>*, Vector3<Scalar_>*); \
+  EXTERN template Quaternion<Scalar_> evaluateRotation<Scalar_>(const Quaternion<Scalar_>&, const Vector3<Scalar_>&, \
+      const Quaternion<Scalar_>&, const Vector3<Scalar_>&, Scalar_, Scalar_); \
+  EXTERN template Vector3<Scalar_> evaluateAngularVelocity<Scalar_>(const Quaternion<Scalar_>&, const Vector3<Scalar_>&, \
+      const Quaternion<Scalar_>&, const Vector3<Scalar_>&, Scalar_, Scalar_); \
+  EXTERN template Eigen::Matrix<Scalar_, 3, 3> skewMatrix<Scalar_>(const Vector3<Scalar_>&); \
+  EXTERN template Eigen::Matrix<Scalar_, 3, 3> rightJacobian<Scalar_>(const Vector3<Scalar_>&); \
+  EXTERN template Eigen::Matrix<Scalar_, 3, 3> rightJacobianInverse<Scalar_>(const Vector3<Scalar_>&); \
+  EXTERN template Eigen::Matrix<Scalar_, 3, 4> quaternionToRotationVectorJacobian<Scalar_>(const Quaternion<Scalar_>&); \
+  EXTERN template void evaluatePoseWithJacobians<Scalar_>(const Vector3<Scalar_>&, const Quaternion<Scalar_>&, \
+      const Vector3<Scalar_>&, const Vector3<Scalar_>&, const Vector3<Scalar_>&, const Quaternion<Scalar_>&, \
+      const Vector3<Scalar_>&, const Vector3<Scalar_>&, Scalar_, Scalar_, Vector3<Scalar_>*, Quaternion<Scalar_>*, \
+      Eigen::Matrix<Scalar_, 6, 13>*, Eigen::Matrix<Scalar_, 6, 13>*);
+
+CURVES_HERMITE_KERNELS_DECLARE(extern, float)
+CURVES_HERMITE_KERNELS_DECLARE(extern, double)
+
+} // namespace hermite_kernels
+} // namespace curves
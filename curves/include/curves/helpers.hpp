@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <stdio.h>
 #include <stdlib.h>
+#include <string>
 #include <vector>
 #include <iostream>
 
@@ -34,4 +36,31 @@ void writeTimeVectorCSV(std::string fileName, const std::vector<curves::Time>& t
 /// \brief Helper function to read CSV files formatted in: time0, time1, vectorEntry0, vectorEntry1, ...
 void loadTimeTimeVectorCSV(std::string fileName, std::vector<curves::Time>* outTimes0, std::vector<curves::Time>* outTimes1, std::vector<Eigen::VectorXd>* outValues);
 
+/// \brief Write CSV file formatted in: time, vectorEntry0, vectorEntry1, ... from contiguous arrays.
+///        values holds the vectors back to back, dimension entries per time. Chunks of rows are
+///        formatted into large buffers in parallel on numThreads threads (0: one per core) and
+///        written in order. precision is the number of significant digits in [1, 17], 0 writes the
+///        shorter of 15 or 17 digits that reads back exactly.
+void writeTimeVectorCSV(const std::string& fileName, const curves::Time* times, const double* values,
+                        size_t numRows, size_t dimension, int precision = 0, unsigned numThreads = 0);
+
+/// \brief Same as above, but appends the rows to an open file.
+void writeTimeVectorCSV(FILE* file, const curves::Time* times, const double* values,
+                        size_t numRows, size_t dimension, int precision = 0, unsigned numThreads = 0);
+
+/// \brief Stream a numeric CSV file into one row-major array without intermediate strings.
+///        Returns the number of columns, all rows must have the same number of columns.
+size_t loadNumericCSV(const std::string& fileName, std::vector<double>* outData);
+
+/// \brief Read CSV files formatted in: time, vectorEntry0, vectorEntry1, ... into contiguous arrays.
+///        outValues holds the vectors back to back, outDimension entries per time.
+void loadTimeVectorCSV(const std::string& fileName, std::vector<curves::Time>* outTimes,
+                       std::vector<double>* outValues, size_t* outDimension);
+
+/// \brief Read CSV files formatted in: time0, time1, vectorEntry0, vectorEntry1, ... into contiguous arrays.
+///        outValues holds the vectors back to back, outDimension entries per row.
+void loadTimeTimeVectorCSV(const std::string& fileName, std::vector<curves::Time>* outTimes0,
+                           std::vector<curves::Time>* outTimes1, std::vector<double>* outValues,
+                           size_t* outDimension);
+
 }
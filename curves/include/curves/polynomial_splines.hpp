@@ -17,5 +17,6 @@ using PolynomialSplineQuadratic = PolynomialSpline<2>;
 using PolynomialSplineCubic     = PolynomialSpline<3>;
 using PolynomialSplineQuartic   = PolynomialSpline<4>;
 using PolynomialSplineQuintic   = PolynomialSpline<5>;
+using PolynomialSplineSeptic    = PolynomialSpline<7>;
 
 }
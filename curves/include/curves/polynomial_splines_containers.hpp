@@ -17,5 +17,6 @@ using PolynomialSplineContainerQuadratic = PolynomialSplineContainer<2>;
 using PolynomialSplineContainerCubic     = PolynomialSplineContainer<3>;
 using PolynomialSplineContainerQuartic   = PolynomialSplineContainer<4>;
 using PolynomialSplineContainerQuintic   = PolynomialSplineContainer<5>;
+using PolynomialSplineContainerSeptic    = PolynomialSplineContainer<7>;
 
 }
@@ -68,231 +68,203 @@ struct SplineOptions {
 
 namespace spline_traits {
 
-// Main struct template.
-template<typename Core_, int SplineOrder_>
-struct spline_rep {
-
-  static constexpr unsigned int splineOrder = SplineOrder_;
-  static constexpr unsigned int numCoefficients = SplineOrder_+1;
+namespace internal {
 
-  using TimeVectorType = std::array<Core_, numCoefficients>;
-  using SplineCoefficients = std::array<Core_, numCoefficients>;
+//! Compile-time list of indices, a C++11 stand-in for std::index_sequence.
+template<unsigned int... Indices>
+struct index_sequence { };
 
-  static inline TimeVectorType tau(Core_ tk) noexcept;
-  static inline TimeVectorType dtau(Core_ tk) noexcept;
-  static inline TimeVectorType ddtau(Core_ tk) noexcept;
+//! Builds index_sequence<0, ..., N-1>.
+template<unsigned int N, unsigned int... Indices>
+struct make_index_sequence : make_index_sequence<N-1, N-1, Indices...> { };
 
-  static bool compute(const SplineOptions& opts, SplineCoefficients& coefficients);
+template<unsigned int... Indices>
+struct make_index_sequence<0, Indices...> {
+  using type = index_sequence<Indices...>;
 };
 
-// Specialization for linear splines.
-template<>
-struct spline_rep<double, 1> {
-
-  static constexpr unsigned int splineOrder = 1;
-  static constexpr unsigned int numCoefficients = splineOrder+1;
+//! Falling factorial p*(p-1)*...*(p-k+1), i.e. the factor of the k-th derivative of t^p (zero if k > p).
+constexpr double fallingFactorial(unsigned int p, unsigned int k) {
+  return (k == 0u) ? 1.0 : ((k > p) ? 0.0 : double(p) * fallingFactorial(p-1u, k-1u));
+}
 
-  using TimeVectorType = std::array<double, numCoefficients>;
-  using SplineCoefficients = std::array<double, numCoefficients>;
+//! t^e by repeated multiplication, unrolled by the compiler for constant exponents.
+template<typename Core_>
+constexpr Core_ power(Core_ t, unsigned int e) {
+  return (e == 0u) ? Core_(1.0) : t * power(t, e-1u);
+}
 
-  static inline TimeVectorType tau(double tk) noexcept {
-    return { tk, 1.0 };
-  }
+} // namespace internal
 
-  static inline TimeVectorType dtau(double /*tk*/) noexcept {
-    return { 1.0, 0.0 };
-  }
+/*! Spline representation for any order. Core_ is the scalar type (double, float or an autodiff scalar).
+ *
+ * Coefficients are stored from the highest power down, [an ... a1 a0], so entry i of the time vector is
+ * t^(n-i) and entry i of its k-th derivative is derivativeFactor(k, i) * t^(n-i-k). The factors are
+ * compile-time constants and the time vectors are expanded element by element at compile time.
+ */
+template<typename Core_, int SplineOrder_>
+struct spline_rep {
 
-  static inline TimeVectorType ddtau(double /*tk*/) noexcept {
-    return { 0.0, 0.0 };
-  }
+  static_assert(SplineOrder_ >= 1, "Splines need to be at least linear.");
 
-  static constexpr TimeVectorType   tauZero{{ 0.0, 1.0 }};
-  static constexpr TimeVectorType  dtauZero{{ 1.0, 0.0 }};
-  static constexpr TimeVectorType ddtauZero{{ 0.0, 0.0 }};
+  static constexpr unsigned int splineOrder = SplineOrder_;
+  static constexpr unsigned int numCoefficients = SplineOrder_+1;
 
-  //! Map initial pos and final pos to spline coefficients.
-  static bool compute(const SplineOptions& opts, SplineCoefficients& coefficients) {
-    coefficients[1] = opts.pos0_; //a0
-    coefficients[0] = (opts.posT_ - opts.pos0_) / opts.tf_; //a1
+  using TimeVectorType = std::array<Core_, numCoefficients>;
+  using SplineCoefficients = std::array<Core_, numCoefficients>;
 
-    return true;
+  //! Factor of entry i of the k-th derivative of the time vector.
+  static constexpr double derivativeFactor(unsigned int k, unsigned int i) noexcept {
+    return internal::fallingFactorial(splineOrder-i, k);
   }
-};
 
-// Specialization for quadratic splines.
-template<>
-struct spline_rep<double, 2> {
-
-  static constexpr unsigned int splineOrder = 2;
-  static constexpr unsigned int numCoefficients = splineOrder+1;
-
-  using TimeVectorType = std::array<double, numCoefficients>;
-  using SplineCoefficients = std::array<double, numCoefficients>;
-
-  static inline TimeVectorType tau(double tk) noexcept {
-    return { boost::math::pow<2>(tk), tk, 1.0 };
+  //! k-th time derivative of the time vector, evaluated at tk.
+  template<unsigned int k>
+  static constexpr TimeVectorType dktau(Core_ tk) noexcept {
+    return dktau<k>(tk, typename internal::make_index_sequence<numCoefficients>::type());
   }
 
-  static inline TimeVectorType dtau(double tk) noexcept {
-    return { 2.0*tk, 1.0, 0.0 };
+  static constexpr TimeVectorType tau(Core_ tk) noexcept {
+    return dktau<0>(tk);
   }
 
-  static inline TimeVectorType ddtau(double /*tk*/) noexcept {
-    return { 2.0, 0.0, 0.0 };
+  static constexpr TimeVectorType dtau(Core_ tk) noexcept {
+    return dktau<1>(tk);
   }
 
-  static constexpr TimeVectorType   tauZero{{ 0.0, 0.0, 1.0 }};
-  static constexpr TimeVectorType  dtauZero{{ 0.0, 1.0, 0.0 }};
-  static constexpr TimeVectorType ddtauZero{{ 2.0, 0.0, 0.0 }};
-
-  //! Map initial pos, initial vel and final pos to spline coefficients.
-  static bool compute(const SplineOptions& opts, SplineCoefficients& coefficients) {
-
-    coefficients[2] = opts.pos0_; // a0
-    coefficients[1] = opts.vel0_; // a1
-    coefficients[0] = (opts.posT_ - opts.pos0_ - opts.vel0_*opts.tf_) / boost::math::pow<2>(opts.tf_); // a2
-
-    return true;
+  static constexpr TimeVectorType ddtau(Core_ tk) noexcept {
+    return dktau<2>(tk);
   }
-};
-
-// Specialization for third order splines (cubic).
-template<>
-struct spline_rep<double, 3> {
-
-  static constexpr unsigned int splineOrder = 3;
-  static constexpr unsigned int numCoefficients = splineOrder+1;
-
-  using TimeVectorType = std::array<double, numCoefficients>;
-  using SplineCoefficients = std::array<double, numCoefficients>;
 
-  static inline TimeVectorType tau(double tk) noexcept {
-    return { boost::math::pow<3>(tk), boost::math::pow<2>(tk), tk, 1.0 };
+  //! k-th derivative of the time vector at time zero, the only non-zero entry is k! at the coefficient of t^k.
+  template<unsigned int k>
+  static constexpr TimeVectorType dktauZero() noexcept {
+    return dktau<k>(Core_(0.0));
   }
 
-  static inline TimeVectorType dtau(double tk) noexcept {
-    return { 3.0*boost::math::pow<2>(tk), 2.0*tk, 1.0, 0.0 };
+  static constexpr TimeVectorType tauZero() noexcept {
+    return dktauZero<0>();
   }
 
-  static inline TimeVectorType ddtau(double tk) noexcept {
-    return { 6.0*tk, 2.0, 0.0, 0.0 };
+  static constexpr TimeVectorType dtauZero() noexcept {
+    return dktauZero<1>();
   }
 
-  static constexpr TimeVectorType   tauZero{{ 0.0, 0.0, 0.0, 1.0 }};
-  static constexpr TimeVectorType  dtauZero{{ 0.0, 0.0, 1.0, 0.0 }};
-  static constexpr TimeVectorType ddtauZero{{ 0.0, 2.0, 0.0, 0.0 }};
-
-  //! Map initial pos, initial vel, final pos and final vel to spline coefficients.
-  static bool compute(const SplineOptions& opts, SplineCoefficients& coefficients) {
-
-    Eigen::Matrix<double, numCoefficients, 1> b;
-    b << opts.pos0_, opts.vel0_, opts.posT_, opts.velT_;
-
-    Eigen::Matrix<double, numCoefficients, numCoefficients> A;
-    A << Eigen::Map<const Eigen::Matrix<double, 1, numCoefficients>>(tauZero.data()),
-         Eigen::Map<const Eigen::Matrix<double, 1, numCoefficients>>(dtauZero.data()),
-         Eigen::Map<Eigen::Matrix<double, 1, numCoefficients>>((tau(opts.tf_)).data()),
-         Eigen::Map<Eigen::Matrix<double, 1, numCoefficients>>((dtau(opts.tf_)).data());
-
-    Eigen::Map<Eigen::VectorXd>(coefficients.data(), numCoefficients, 1) = A.colPivHouseholderQr().solve(b);
-
-    return true;
+  static constexpr TimeVectorType ddtauZero() noexcept {
+    return dktauZero<2>();
   }
-};
 
-// Specialization for fourth order (quartic) splines.
-template<>
-struct spline_rep<double, 4> {
-
-  static constexpr unsigned int splineOrder = 4;
-  static constexpr unsigned int numCoefficients = splineOrder+1;
-
-  using TimeVectorType = std::array<double, numCoefficients>;
-  using SplineCoefficients = std::array<double, numCoefficients>;
-
-  static inline TimeVectorType tau(double tk) noexcept {
-    return { boost::math::pow<4>(tk), boost::math::pow<3>(tk), boost::math::pow<2>(tk), tk, 1.0};
+  /*! k-th derivative of the spline with coefficients [an ... a0] at tk, using Horner's scheme.
+   *
+   * The derivative coefficients are the coefficients scaled by the compile-time factors. The scaling does
+   * not depend on tk, so it stays off the dependency chain of the n-k multiply-adds.
+   */
+  template<unsigned int k>
+  static inline Core_ evaluateHorner(const SplineCoefficients& coefficients, Core_ tk) noexcept {
+    if (k > splineOrder) {
+      return Core_(0.0);
+    }
+    Core_ value = Core_(derivativeFactor(k, 0u)) * coefficients[0];
+    for (unsigned int i = 1u; i + k <= splineOrder; ++i) {
+      value = value * tk + Core_(derivativeFactor(k, i)) * coefficients[i];
+    }
+    return value;
   }
 
-  static inline TimeVectorType dtau(double tk) noexcept {
-    return { 4.0*boost::math::pow<3>(tk), 3.0*boost::math::pow<2>(tk), 2.0*tk, 1.0, 0.0};
+  /*! k-th derivative of the spline with coefficients [an ... a0] at tk, using Estrin's scheme.
+   *
+   * Neighbouring terms are combined pairwise with tk, tk^2, tk^4, ..., which shortens the dependency chain
+   * to about log2(n-k+1) multiply-adds at the price of the squarings.
+   */
+  template<unsigned int k>
+  static inline Core_ evaluateEstrin(const SplineCoefficients& coefficients, Core_ tk) noexcept {
+    if (k > splineOrder) {
+      return Core_(0.0);
+    }
+    // Coefficients of the derivative in ascending powers of tk.
+    std::array<Core_, numCoefficients> terms;
+    unsigned int numTerms = splineOrder - k + 1u;
+    for (unsigned int j = 0u; j < numTerms; ++j) {
+      const unsigned int i = splineOrder - k - j;
+      terms[j] = Core_(derivativeFactor(k, i)) * coefficients[i];
+    }
+    Core_ x = tk;
+    while (numTerms > 1u) {
+      for (unsigned int j = 0u; 2u*j < numTerms; ++j) {
+        terms[j] = (2u*j + 1u < numTerms) ? terms[2u*j] + terms[2u*j + 1u] * x : terms[2u*j];
+      }
+      numTerms = (numTerms + 1u) / 2u;
+      x = x * x;
+    }
+    return terms[0];
   }
 
-  static inline TimeVectorType ddtau(double tk) noexcept {
-    return { 12.0*boost::math::pow<2>(tk), 6.0*tk, 2.0, 0.0, 0.0};
+  /*! k-th derivative of the spline at tk.
+   *
+   * Horner's scheme has the fewest operations and the best throughput when many independent evaluations are
+   * in flight, e.g. when sampling a container. evaluateEstrin has the lower latency when each evaluation waits
+   * for the previous one (see benchmark/PolynomialSplineEvaluationBenchmark.cpp).
+   */
+  template<unsigned int k>
+  static inline Core_ evaluate(const SplineCoefficients& coefficients, Core_ tk) noexcept {
+    return evaluateHorner<k>(coefficients, tk);
   }
 
-  static constexpr TimeVectorType   tauZero{{ 0.0, 0.0, 0.0, 0.0, 1.0 }};
-  static constexpr TimeVectorType  dtauZero{{ 0.0, 0.0, 0.0, 1.0, 0.0 }};
-  static constexpr TimeVectorType ddtauZero{{ 0.0, 0.0, 2.0, 0.0, 0.0 }};
-
-  //! Map initial pos/vel/accel and final pos/vel to spline coefficients.
+  /*! Map the boundary conditions to spline coefficients.
+   *
+   * The first ceil((n+1)/2) derivatives at time 0 and the first floor((n+1)/2) derivatives at time tf are
+   * matched, in the order pos, vel, acc. Derivatives above the acceleration are set to zero.
+   */
   static bool compute(const SplineOptions& opts, SplineCoefficients& coefficients) {
-    Eigen::Matrix<double, numCoefficients, 1> b;
-    b << opts.pos0_, opts.vel0_, opts.acc0_, opts.posT_, opts.velT_;
-
-    Eigen::Matrix<double, numCoefficients, numCoefficients> A;
-    A << Eigen::Map<const Eigen::Matrix<double, 1, numCoefficients>>(tauZero.data()),
-         Eigen::Map<const Eigen::Matrix<double, 1, numCoefficients>>(dtauZero.data()),
-         Eigen::Map<const Eigen::Matrix<double, 1, numCoefficients>>(ddtauZero.data()),
-         Eigen::Map<Eigen::Matrix<double, 1, numCoefficients>>((tau(opts.tf_)).data()),
-         Eigen::Map<Eigen::Matrix<double, 1, numCoefficients>>((dtau(opts.tf_)).data());
-
-    Eigen::Map<Eigen::VectorXd>(coefficients.data(), numCoefficients, 1) = A.colPivHouseholderQr().solve(b);
+    constexpr unsigned int numInitialConditions = (numCoefficients+1)/2;
+
+    Eigen::Matrix<Core_, numCoefficients, numCoefficients> A;
+    Eigen::Matrix<Core_, numCoefficients, 1> b;
+    const Core_ tf = Core_(opts.tf_);
+    const double initialConditions[3] = { opts.pos0_, opts.vel0_, opts.acc0_ };
+    const double finalConditions[3] = { opts.posT_, opts.velT_, opts.accT_ };
+
+    for (unsigned int row = 0u; row < numCoefficients; ++row) {
+      const bool isInitial = (row < numInitialConditions);
+      const unsigned int derivative = isInitial ? row : row - numInitialConditions;
+      const Core_ t = isInitial ? Core_(0.0) : tf;
+      for (unsigned int i = 0u; i < numCoefficients; ++i) {
+        A(row, i) = (derivative > splineOrder-i) ? Core_(0.0) :
+            Core_(derivativeFactor(derivative, i)) * internal::power(t, splineOrder-i-derivative);
+      }
+      b(row) = (derivative < 3u) ? Core_(isInitial ? initialConditions[derivative] : finalConditions[derivative]) : Core_(0.0);
+    }
+
+    Eigen::Map<Eigen::Matrix<Core_, Eigen::Dynamic, 1>>(coefficients.data(), numCoefficients, 1) = A.colPivHouseholderQr().solve(b);
 
     return true;
   }
 
-};
-
-
-// Specialization for fifth order (quintic) splines.
-template<>
-struct spline_rep<double, 5> {
-
-  static constexpr unsigned int splineOrder = 5;
-  static constexpr unsigned int numCoefficients = splineOrder+1;
-
-  using TimeVectorType = std::array<double, numCoefficients>;
-  using SplineCoefficients = std::array<double, numCoefficients>;
-
-  static inline TimeVectorType tau(double tk) noexcept {
-    return { boost::math::pow<5>(tk), boost::math::pow<4>(tk), boost::math::pow<3>(tk),
-             boost::math::pow<2>(tk), tk, 1.0};
-  }
-
-  static inline TimeVectorType dtau(double tk) noexcept {
-    return { 5.0*boost::math::pow<4>(tk), 4.0*boost::math::pow<3>(tk), 3.0*boost::math::pow<2>(tk),
-             2.0*tk, 1.0, 0.0};
-  }
-
-  static inline TimeVectorType ddtau(double tk) noexcept {
-    return { 20.0*boost::math::pow<3>(tk), 12.0*boost::math::pow<2>(tk), 6.0*tk,
-              2.0, 0.0, 0.0};
+ private:
+  template<unsigned int k>
+  static constexpr Core_ dktauEntry(Core_ tk, unsigned int i) noexcept {
+    return (k > splineOrder-i) ? Core_(0.0) : Core_(derivativeFactor(k, i)) * internal::power(tk, splineOrder-i-k);
   }
 
-  static constexpr TimeVectorType   tauZero{{ 0.0, 0.0, 0.0, 0.0, 0.0, 1.0 }};
-  static constexpr TimeVectorType  dtauZero{{ 0.0, 0.0, 0.0, 0.0, 1.0, 0.0 }};
-  static constexpr TimeVectorType ddtauZero{{ 0.0, 0.0, 0.0, 2.0, 0.0, 0.0 }};
-
-  //! Map initial pos/vel/accel and final pos/vel/accel to spline coefficients.
-  static inline bool compute(const SplineOptions& opts, SplineCoefficients& coefficients) {
-    Eigen::Map<Eigen::VectorXd>(coefficients.data(), numCoefficients, 1) =
-      (Eigen::Matrix<double, numCoefficients, numCoefficients>() << Eigen::Map<const Eigen::Matrix<double, 1, numCoefficients>>(tauZero.data()),
-               Eigen::Map<const Eigen::Matrix<double, 1, numCoefficients>>(dtauZero.data()),
-               Eigen::Map<const Eigen::Matrix<double, 1, numCoefficients>>(ddtauZero.data()),
-               Eigen::Map<Eigen::Matrix<double, 1, numCoefficients>>((tau(opts.tf_)).data()),
-               Eigen::Map<Eigen::Matrix<double, 1, numCoefficients>>((dtau(opts.tf_)).data()),
-               Eigen::Map<Eigen::Matrix<double, 1, numCoefficients>>((ddtau(opts.tf_)).data())).finished().
-                 colPivHouseholderQr().solve(
-                     (Eigen::Matrix<double, numCoefficients, 1>() << opts.pos0_, opts.vel0_, opts.acc0_, opts.posT_, opts.velT_, opts.accT_).finished());
-
-    return true;
+  template<unsigned int k, unsigned int... Indices>
+  static constexpr TimeVectorType dktau(Core_ tk, internal::index_sequence<Indices...>) noexcept {
+    return TimeVectorType{{ dktauEntry<k>(tk, Indices)... }};
   }
-
 };
 
+// Explicitly instantiated in polynomial_splines_traits.cpp.
+extern template struct spline_rep<float, 1>;
+extern template struct spline_rep<float, 2>;
+extern template struct spline_rep<float, 3>;
+extern template struct spline_rep<float, 4>;
+extern template struct spline_rep<float, 5>;
+extern template struct spline_rep<double, 1>;
+extern template struct spline_rep<double, 2>;
+extern template struct spline_rep<double, 3>;
+extern template struct spline_rep<double, 4>;
+extern template struct spline_rep<double, 5>;
+extern template struct spline_rep<double, 7>;
+
 }
 
 }
@@ -0,0 +1,46 @@
+function [t, p, q, v, w] = readCubicHermiteSE3CurveBinary(filename)
+%READCUBICHERMITESE3CURVEBINARY Read a curve written by CubicHermiteSE3Curve::saveCurveBinary.
+%
+%   [t, p, q, v, w] = readCubicHermiteSE3CurveBinary(filename) returns the
+%   knot times t (Nx1), positions p (Nx3), quaternions q (Nx4, [w x y z]),
+%   linear velocities v (Nx3) and angular velocities w (Nx3).
+%
+%   See HermiteSE3CurveFile.hpp for the file layout (version 1, little-endian).
+
+fileID = fopen(filename, 'r', 'ieee-le');
+if fileID < 0
+    error('Could not open file %s.', filename);
+end
+cleanup = onCleanup(@() fclose(fileID));
+
+%% Header (64 bytes).
+magic = fread(fileID, [1 8], '*char');
+if ~strcmp(magic, 'CURVHSE3')
+    error('%s is not a Hermite SE3 curve file.', filename);
+end
+version = fread(fileID, 1, 'uint32');
+if version ~= 1
+    error('%s has unsupported version %d.', filename, version);
+end
+fread(fileID, 1, 'uint32'); % header size
+numKnots = fread(fileID, 1, 'uint64');
+timesOffset = fread(fileID, 1, 'uint64');
+coefficientsOffset = fread(fileID, 1, 'uint64');
+coefficientStride = fread(fileID, 1, 'uint32');
+coefficientSize = fread(fileID, 1, 'uint32');
+
+%% Knot times.
+fseek(fileID, timesOffset, 'bof');
+t = fread(fileID, numKnots, 'double');
+
+%% Coefficients, one padded record of coefficientStride bytes per knot.
+fseek(fileID, coefficientsOffset, 'bof');
+skip = coefficientStride - 8 * coefficientSize;
+c = fread(fileID, [coefficientSize numKnots], ...
+          sprintf('%d*double', coefficientSize), skip)';
+
+p = c(:, 1:3);
+q = c(:, 4:7);
+v = c(:, 8:10);
+w = c(:, 11:13);
+end
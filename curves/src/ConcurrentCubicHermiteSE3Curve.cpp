@@ -0,0 +1,218 @@
+/*
+ * ConcurrentCubicHermiteSE3Curve.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include <iostream>
+
+#include <glog/logging.h>
+
+#include "curves/ConcurrentCubicHermiteSE3Curve.hpp"
+
+namespace curves {
+
+namespace {
+
+typedef ConcurrentCubicHermiteSE3Curve::KnotStorage::Knot Knot;
+
+// Same slope as CubicHermiteSE3Curve::calculateSlope.
+ConcurrentCubicHermiteSE3Curve::DerivativeType calculateSlope(
+    Time timeA, Time timeB,
+    const ConcurrentCubicHermiteSE3Curve::ValueType& T_W_A,
+    const ConcurrentCubicHermiteSE3Curve::ValueType& T_W_B) {
+  const double inverse_dt_sec = 1.0/double(timeB - timeA);
+  const Eigen::Vector3d angularVelocity_rad_s = T_W_B.getRotation().boxMinus(T_W_A.getRotation()) * inverse_dt_sec;
+  const Eigen::Vector3d velocity_m_s = (T_W_B.getPosition().vector() - T_W_A.getPosition().vector()) * inverse_dt_sec;
+  return ConcurrentCubicHermiteSE3Curve::DerivativeType(velocity_m_s, angularVelocity_rad_s);
+}
+
+// Find the published knots bracketing time among the first n knots.
+bool getKnotsAt(const ConcurrentCubicHermiteSE3Curve::KnotStorage& knots, size_t n, Time time,
+                const Knot** a, const Knot** b) {
+  if (n < 2 || time < knots[0].time || time > knots[n - 1].time) {
+    return false;
+  }
+  size_t upper = knots.upperBound(time, n);
+  if (upper == n) {
+    --upper;
+  }
+  *a = &knots[upper - 1];
+  *b = &knots[upper];
+  return true;
+}
+
+// Evaluate the pose from the first n published knots.
+bool evaluateKnots(const ConcurrentCubicHermiteSE3Curve::KnotStorage& knots, size_t n,
+                   ConcurrentCubicHermiteSE3Curve::ValueType& value, Time time) {
+  // Check if the curve is only defined at this one time
+  if (n == 1 && knots[0].time == time) {
+    value = knots[0].coefficient.getTransformation();
+    return true;
+  }
+  const Knot* a;
+  const Knot* b;
+  if (!getKnotsAt(knots, n, time, &a, &b)) {
+    std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+    return false;
+  }
+  const double dt_sec = (b->time - a->time);
+  const double alpha = double(time - a->time)/dt_sec;
+  value = HermiteSE3Coefficient::interpolate(a->coefficient, b->coefficient, dt_sec, alpha);
+  return true;
+}
+
+// Evaluate the first derivative from the first n published knots.
+bool evaluateKnotsDerivative(const ConcurrentCubicHermiteSE3Curve::KnotStorage& knots, size_t n,
+                             ConcurrentCubicHermiteSE3Curve::DerivativeType& derivative, Time time,
+                             unsigned int derivativeOrder) {
+  if (derivativeOrder != 1) {
+    std::cerr << "ConcurrentCubicHermiteSE3Curve::evaluateDerivative: higher order derivatives are not implemented!";
+    return false;
+  }
+  // Check if the curve is only defined at this one time
+  if (n == 1 && knots[0].time == time) {
+    derivative = knots[0].coefficient.getTransformationDerivative();
+    return true;
+  }
+  const Knot* a;
+  const Knot* b;
+  if (!getKnotsAt(knots, n, time, &a, &b)) {
+    std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+    return false;
+  }
+  const double dt_sec = (b->time - a->time);
+  const double alpha = double(time - a->time)/dt_sec;
+  derivative = HermiteSE3Coefficient::interpolateDerivative(a->coefficient, b->coefficient, dt_sec, alpha);
+  return true;
+}
+
+} // namespace
+
+ConcurrentCubicHermiteSE3Curve::Snapshot::Snapshot(const std::shared_ptr<const KnotStorage>& knots,
+                                                   size_t size)
+    : knots_(knots),
+      size_(size) {}
+
+Time ConcurrentCubicHermiteSE3Curve::Snapshot::getMinTime() const {
+  return size_ == 0 ? 0.0 : (*knots_)[0].time;
+}
+
+Time ConcurrentCubicHermiteSE3Curve::Snapshot::getMaxTime() const {
+  return size_ == 0 ? 0.0 : (*knots_)[size_ - 1].time;
+}
+
+bool ConcurrentCubicHermiteSE3Curve::Snapshot::isEmpty() const {
+  return size_ == 0;
+}
+
+int ConcurrentCubicHermiteSE3Curve::Snapshot::size() const {
+  return static_cast<int>(size_);
+}
+
+bool ConcurrentCubicHermiteSE3Curve::Snapshot::evaluate(ValueType& value, Time time) const {
+  return evaluateKnots(*knots_, size_, value, time);
+}
+
+bool ConcurrentCubicHermiteSE3Curve::Snapshot::evaluateDerivative(DerivativeType& derivative, Time time,
+                                                                  unsigned int derivativeOrder) const {
+  return evaluateKnotsDerivative(*knots_, size_, derivative, time, derivativeOrder);
+}
+
+ConcurrentCubicHermiteSE3Curve::ConcurrentCubicHermiteSE3Curve(size_t capacity)
+    : knots_(new KnotStorage(capacity)),
+      hasPending_(false),
+      pendingTime_(0.0),
+      hasPrevious_(false),
+      previousTime_(0.0) {}
+
+ConcurrentCubicHermiteSE3Curve::~ConcurrentCubicHermiteSE3Curve() {}
+
+bool ConcurrentCubicHermiteSE3Curve::extend(const std::vector<Time>& times,
+                                            const std::vector<ValueType>& values,
+                                            const DerivativeType& initialDerivative) {
+  CHECK_EQ(times.size(), values.size()) << "number of times and number of coefficients don't match";
+  if (!hasPending_ && !hasPrevious_) {
+    initialDerivative_ = initialDerivative;
+  }
+  for (size_t i = 0; i < times.size(); ++i) {
+    if (hasPending_) {
+      CHECK_GT(times[i], pendingTime_) << "extend times have to strictly increase the curve time";
+      // The pending knot is complete as soon as its successor is known.
+      const DerivativeType derivative = hasPrevious_ ?
+          calculateSlope(previousTime_, times[i], previousValue_, values[i]) : initialDerivative_;
+      if (!publish(pendingTime_, pendingValue_, derivative)) {
+        return false;
+      }
+      hasPrevious_ = true;
+      previousTime_ = pendingTime_;
+      previousValue_ = pendingValue_;
+    } else if (hasPrevious_) {
+      CHECK_GT(times[i], previousTime_) << "extend times have to strictly increase the curve time";
+    }
+    hasPending_ = true;
+    pendingTime_ = times[i];
+    pendingValue_ = values[i];
+  }
+  return true;
+}
+
+bool ConcurrentCubicHermiteSE3Curve::finalize(const DerivativeType& finalDerivative) {
+  if (!hasPending_) {
+    return true;
+  }
+  if (!publish(pendingTime_, pendingValue_, hasPrevious_ ? finalDerivative : initialDerivative_)) {
+    return false;
+  }
+  hasPending_ = false;
+  hasPrevious_ = true;
+  previousTime_ = pendingTime_;
+  previousValue_ = pendingValue_;
+  return true;
+}
+
+bool ConcurrentCubicHermiteSE3Curve::publish(Time time, const ValueType& value,
+                                             const DerivativeType& derivative) {
+  if (!knots_->push_back(time, Coefficient(value, derivative))) {
+    LOG(ERROR) << "ConcurrentCubicHermiteSE3Curve is full, capacity " << knots_->capacity() << " knots.";
+    return false;
+  }
+  return true;
+}
+
+Time ConcurrentCubicHermiteSE3Curve::getMinTime() const {
+  return knots_->size() == 0 ? 0.0 : (*knots_)[0].time;
+}
+
+Time ConcurrentCubicHermiteSE3Curve::getMaxTime() const {
+  const size_t n = knots_->size();
+  return n == 0 ? 0.0 : (*knots_)[n - 1].time;
+}
+
+bool ConcurrentCubicHermiteSE3Curve::isEmpty() const {
+  return knots_->size() == 0;
+}
+
+int ConcurrentCubicHermiteSE3Curve::size() const {
+  return static_cast<int>(knots_->size());
+}
+
+size_t ConcurrentCubicHermiteSE3Curve::capacity() const {
+  return knots_->capacity();
+}
+
+bool ConcurrentCubicHermiteSE3Curve::evaluate(ValueType& value, Time time) const {
+  return evaluateKnots(*knots_, knots_->size(), value, time);
+}
+
+bool ConcurrentCubicHermiteSE3Curve::evaluateDerivative(DerivativeType& derivative, Time time,
+                                                        unsigned int derivativeOrder) const {
+  return evaluateKnotsDerivative(*knots_, knots_->size(), derivative, time, derivativeOrder);
+}
+
+ConcurrentCubicHermiteSE3Curve::SnapshotPtr ConcurrentCubicHermiteSE3Curve::snapshot() const {
+  return SnapshotPtr(new Snapshot(knots_, knots_->size()));
+}
+
+} // namespace curves
@@ -6,10 +6,11 @@
  */
 
 #include <curves/CubicHermiteE3Curve.hpp>
+#include <curves/cubic_hermite_kernels.hpp>
 
 namespace curves {
 
-CubicHermiteE3Curve::CubicHermiteE3Curve() {
+CubicHermiteE3Curve::CubicHermiteE3Curve() : maxNumberOfCoefficients_(0) {
 
 }
 CubicHermiteE3Curve::~CubicHermiteE3Curve() {
@@ -98,6 +99,20 @@ int CubicHermiteE3Curve::size() const {
   return manager_.size();
 }
 
+void CubicHermiteE3Curve::getKnots(std::vector<Time>* outTimes,
+                                   std::vector<Coefficient>* outCoefficients) const {
+  CHECK_NOTNULL(outTimes);
+  CHECK_NOTNULL(outCoefficients);
+  outTimes->clear();
+  outCoefficients->clear();
+  outTimes->reserve(manager_.size());
+  outCoefficients->reserve(manager_.size());
+  for (CoefficientIter it = manager_.coefficientBegin(); it != manager_.coefficientEnd(); ++it) {
+    outTimes->push_back(it->first);
+    outCoefficients->push_back(it->second.coefficient);
+  }
+}
+
 /// \brief calculate the slope between 2 coefficients
 CubicHermiteE3Curve::DerivativeType CubicHermiteE3Curve::calculateSlope(const Time& timeA,
                               const Time& timeB,
@@ -114,10 +129,36 @@ CubicHermiteE3Curve::DerivativeType CubicHermiteE3Curve::calculateSlope(const Ti
 }
 
 
-void CubicHermiteE3Curve::extend(const std::vector<Time>& /*times*/,
-                    const std::vector<ValueType>& /*values*/,
-                    std::vector<Key>* /*outKeys*/) {
+void CubicHermiteE3Curve::extend(const std::vector<Time>& times,
+                    const std::vector<ValueType>& values,
+                    std::vector<Key>* outKeys) {
+  CHECK_EQ(times.size(), values.size()) << "number of times and number of values don't match";
+  for (size_t i = 0; i < times.size(); ++i) {
+    if (manager_.empty()) {
+      const Key key = manager_.insertCoefficient(times[i], Coefficient(values[i], DerivativeType::Zero()));
+      if (outKeys != NULL) {
+        outKeys->push_back(key);
+      }
+      continue;
+    }
 
+    // The previous last knot becomes an inner knot and gets its Catmull-Rom tangent,
+    // its derivative moves to the new last knot.
+    LocalSupport2CoefficientManager<Coefficient>::TimeToKeyCoefficientMap::iterator last = manager_.coefficientEnd();
+    --last;
+    const DerivativeType finalDerivative = last->second.coefficient.getVelocity();
+    if (last != manager_.coefficientBegin()) {
+      LocalSupport2CoefficientManager<Coefficient>::TimeToKeyCoefficientMap::iterator previous = last;
+      --previous;
+      last->second.coefficient.setVelocity(calculateSlope(previous->first, times[i],
+                                                          previous->second.coefficient.getPosition(), values[i]));
+    }
+    manager_.addCoefficientAtEnd(times[i], Coefficient(values[i], finalDerivative), outKeys);
+
+    while (maxNumberOfCoefficients_ > 0 && manager_.size() > maxNumberOfCoefficients_) {
+      manager_.removeCoefficientAtBegin();
+    }
+  }
 }
 
 
@@ -147,6 +188,8 @@ void CubicHermiteE3Curve::fitCurveWithDerivatives(const std::vector<Time>& times
                       std::vector<Key>* outKeys) {
   assert(times.size() == values.size());
 
+  clear();
+
   // construct the Hemrite coefficients
   std::vector<Coefficient> coefficients;
   // fill the coefficients with ValueType and DerivativeType
@@ -195,36 +238,16 @@ bool CubicHermiteE3Curve::evaluate(ValueType& value, Time time) const {
        return false;
      }
 
-     // read out transformation from coefficient
-     const ValueType T_W_A = a->second.coefficient.getPosition();
-     const ValueType T_W_B = b->second.coefficient.getPosition();
-
-     // read out derivative from coefficient
-     const DerivativeType d_W_A = a->second.coefficient.getVelocity();
-     const DerivativeType d_W_B = b->second.coefficient.getVelocity();
+     const Coefficient& coefficientA = a->second.coefficient;
+     const Coefficient& coefficientB = b->second.coefficient;
 
      // make alpha
      const double dt_sec = (b->first - a->first);
      const double alpha = double(time - a->first)/(b->first - a->first);
 
-     // Implemantation of Hermite Interpolation not easy and not fun (without expressions)!
-
-     // translational part (easy):
-     const double alpha2 = alpha * alpha;
-     const double alpha3 = alpha2 * alpha;
-
-     const double beta0 = 2.0 * alpha3 - 3.0 * alpha2 + 1.0;
-     const double beta1 = -2.0 * alpha3 + 3.0 * alpha2;
-     const double beta2 = alpha3 - 2.0 * alpha2 + alpha;
-     const double beta3 = alpha3 - alpha2;
-
-     /**************************************************************************************
-      *  Translational part:
-      **************************************************************************************/
-     value = ValueType(T_W_A * beta0
-                         + T_W_B * beta1
-                         + d_W_A * (beta2 * dt_sec)
-                         + d_W_B * (beta3 * dt_sec));
+     value = hermite_kernels::evaluatePosition<double>(coefficientA.getPosition(), coefficientA.getVelocity(),
+                                                       coefficientB.getPosition(), coefficientB.getVelocity(),
+                                                       dt_sec, alpha);
      return true;
    }
    return false;
@@ -248,35 +271,16 @@ bool CubicHermiteE3Curve::evaluateDerivative(DerivativeType& derivative, Time ti
           return false;
         }
 
-        // read out transformation from coefficient
-        const ValueType T_W_A = a->second.coefficient.getPosition();
-        const ValueType T_W_B = b->second.coefficient.getPosition();
-
-        // read out derivative from coefficient
-        const DerivativeType d_W_A = a->second.coefficient.getVelocity();
-        const DerivativeType d_W_B = b->second.coefficient.getVelocity();
+        const Coefficient& coefficientA = a->second.coefficient;
+        const Coefficient& coefficientB = b->second.coefficient;
 
         // make alpha
-        double dt_sec = (b->first - a->first);
-        const double one_over_dt_sec = 1.0/dt_sec;
-        double alpha = double(time - a->first)/dt_sec;
-
-        const double alpha2 = alpha * alpha;
-        // const double alpha3 = alpha2 * alpha; // TODO(maintainer) This value is unused - maybe a bug?
-
-        /**************************************************************************************
-         *  Translational part:
-         **************************************************************************************/
-        // Implementation of translation
-        const double gamma0 = 6.0*(alpha2 - alpha);
-        const double gamma1 = 3.0*alpha2 - 4.0*alpha + 1.0;
-        const double gamma2 = 6.0*(alpha - alpha2);
-        const double gamma3 = 3.0*alpha2 - 2.0*alpha;
-
-        const DerivativeType velocity_m_s = T_W_A*(gamma0*one_over_dt_sec)
-                                           + d_W_A*(gamma1)
-                                           + T_W_B*(gamma2*one_over_dt_sec)
-                                           + d_W_B*(gamma3);
+        const double dt_sec = (b->first - a->first);
+        const double alpha = double(time - a->first)/dt_sec;
+
+        const DerivativeType velocity_m_s = hermite_kernels::evaluateLinearVelocity<double>(
+            coefficientA.getPosition(), coefficientA.getVelocity(),
+            coefficientB.getPosition(), coefficientB.getVelocity(), dt_sec, alpha);
 
         derivative = velocity_m_s;
         return true;
@@ -299,31 +303,16 @@ bool CubicHermiteE3Curve::evaluateLinearAcceleration(Acceleration& linearAcceler
      return false;
    }
 
-   // read out transformation from coefficient
-   const ValueType T_W_A = a->second.coefficient.getPosition();
-   const ValueType T_W_B = b->second.coefficient.getPosition();
-
-   // read out derivative from coefficient
-   const DerivativeType d_W_A = a->second.coefficient.getVelocity();
-   const DerivativeType d_W_B = b->second.coefficient.getVelocity();
+   const Coefficient& coefficientA = a->second.coefficient;
+   const Coefficient& coefficientB = b->second.coefficient;
 
    // make alpha
-   double dt_sec = (b->first - a->first);
-   const double one_over_dt_sec = 1.0/dt_sec;
-   double alpha = double(time - a->first)/dt_sec;
-   const double d_alpha = one_over_dt_sec;
-
-   /**************************************************************************************
-    *  Translational part:
-    **************************************************************************************/
-   // Implementation of translation
-   const double d_gamma0 = 6.0*(2*alpha - 1.0)*d_alpha;
-   const double d_gamma1 = (6.0*alpha - 4.0)*d_alpha;
-   const double d_gamma2 = 6.0*(1.0 - 2.0*alpha)*d_alpha;
-   const double d_gamma3 = (6.0*alpha - 2.0)*d_alpha;
-
-   linearAcceleration = Acceleration(T_W_A*d_gamma0*one_over_dt_sec + d_W_A*d_gamma1 +
-                                     T_W_B*d_gamma2*one_over_dt_sec + d_W_B*d_gamma3);
+   const double dt_sec = (b->first - a->first);
+   const double alpha = double(time - a->first)/dt_sec;
+
+   linearAcceleration = hermite_kernels::evaluateLinearAcceleration<double>(
+       coefficientA.getPosition(), coefficientA.getVelocity(),
+       coefficientB.getPosition(), coefficientB.getVelocity(), dt_sec, alpha);
 
    return true;
 }
@@ -332,4 +321,8 @@ void CubicHermiteE3Curve::clear() {
   manager_.clear();
 }
 
+void CubicHermiteE3Curve::setMaxNumberOfCoefficients(size_t maxNumberOfCoefficients) {
+  maxNumberOfCoefficients_ = maxNumberOfCoefficients;
+}
+
 } // namespace curves
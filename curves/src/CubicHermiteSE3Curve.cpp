@@ -9,7 +9,10 @@
 #include <iostream>
 
 #include "curves/CubicHermiteSE3Curve.hpp"
+#include "curves/CurveSampler.hpp"
+#include "curves/HermiteSE3CurveFile.hpp"
 #include "curves/SlerpSE3Curve.hpp"
+#include "curves/cubic_hermite_kernels.hpp"
 
 namespace curves {
 
@@ -59,7 +62,9 @@ bool CubicHermiteSE3Curve::writeEvalToFile(const std::string& filename, int nSam
   Time dt = (getMaxTime()-getMinTime())/(nSamples-1);
   ValueType pose;
   DerivativeType twist;
-  for (Time t = getMinTime(); t < getMaxTime(); t+=dt) {
+  for (int i = 0; i < nSamples; ++i) {
+    // Compute the time from the index so that rounding errors do not accumulate.
+    const Time t = (i == nSamples - 1) ? getMaxTime() : getMinTime() + i*dt;
     if(!evaluate(pose, t)) {
       std::cout << "Could not evaluate at time " << t << std::endl;
       fclose(fp);
@@ -206,68 +211,78 @@ bool CubicHermiteSE3Curve::evaluate(ValueType& value, Time time) const {
       return false;
     }
 
-    // read out transformation from coefficient
-    const SE3 T_W_A = a->second.coefficient.getTransformation();
-    const SE3 T_W_B = b->second.coefficient.getTransformation();
-
-    // read out derivative from coefficient
-    const Twist d_W_A = a->second.coefficient.getTransformationDerivative();
-    const Twist d_W_B = b->second.coefficient.getTransformationDerivative();
+    const Coefficient& coefficientA = a->second.coefficient;
+    const Coefficient& coefficientB = b->second.coefficient;
 
     // make alpha
-    const double dt_sec = (b->first - a->first);// * 1e-9;
+    const double dt_sec = (b->first - a->first);
     const double alpha = double(time - a->first)/(b->first - a->first);
 
-    // Implemantation of Hermite Interpolation not easy and not fun (without expressions)!
-
-    // translational part (easy):
-    const double alpha2 = alpha * alpha;
-    const double alpha3 = alpha2 * alpha;
-
-    const double beta0 = 2.0 * alpha3 - 3.0 * alpha2 + 1.0;
-    const double beta1 = -2.0 * alpha3 + 3.0 * alpha2;
-    const double beta2 = alpha3 - 2.0 * alpha2 + alpha;
-    const double beta3 = alpha3 - alpha2;
-
-    /**************************************************************************************
-     *  Translational part:
-     **************************************************************************************/
-    const SE3::Position translation(T_W_A.getPosition().vector() * beta0
-                                  + T_W_B.getPosition().vector() * beta1
-                                  + d_W_A.getTranslationalVelocity().vector() * (beta2 * dt_sec)
-                                  + d_W_B.getTranslationalVelocity().vector() * (beta3 * dt_sec));
-
-    /**************************************************************************************
-     *  Rotational part:
-     **************************************************************************************/
-    const double dt_sec_third = dt_sec / 3.0;
-    const Eigen::Vector3d scaled_d_W_A = dt_sec_third * d_W_A.getRotationalVelocity().vector();
-    const Eigen::Vector3d scaled_d_W_B = dt_sec_third * d_W_B.getRotationalVelocity().vector();
-
-    // d_W_A contains the global angular velocity, but we need the local angular velocity.
-    const Eigen::Vector3d w1 = T_W_A.getRotation().inverseRotate(scaled_d_W_A);
-    const Eigen::Vector3d w3 = T_W_B.getRotation().inverseRotate(scaled_d_W_B);
-    const RotationQuaternion expW1_inv = RotationQuaternion().exponentialMap(-w1);
-    const RotationQuaternion expW3_inv = RotationQuaternion().exponentialMap(-w3);
-    const RotationQuaternion expW1_Inv_qWB_expW3 = expW1_inv * T_W_A.getRotation().inverted() * T_W_B.getRotation() * expW3_inv;
-    const Eigen::Vector3d w2 = expW1_Inv_qWB_expW3.logarithmicMap();
-
-    const double dBeta1 = alpha3 - 3.0 * alpha2 + 3.0 * alpha;
-    const double dBeta2 = -2.0 * alpha3 + 3.0 * alpha2;
-    const double dBeta3 = alpha3;
-
-    const SO3 w1_dBeta1_exp = RotationQuaternion().exponentialMap(dBeta1 * w1);
-    const SO3 w2_dBeta2_exp = RotationQuaternion().exponentialMap(dBeta2 * w2);
-    const SO3 w3_dBeta3_exp = RotationQuaternion().exponentialMap(dBeta3 * w3);
-
-    const RotationQuaternion rotation = T_W_A.getRotation() * w1_dBeta1_exp * w2_dBeta2_exp * w3_dBeta3_exp;
-
-    value = SE3(translation, rotation);
+    value = Coefficient::interpolate(coefficientA, coefficientB, dt_sec, alpha);
     return true;
   }
   return false;
 }
 
+bool CubicHermiteSE3Curve::evaluate(ValueType& value, Time time,
+                                    CoefficientJacobian* jacobianA, CoefficientJacobian* jacobianB,
+                                    Key* keyA, Key* keyB) const {
+  // Check if the curve is only defined at this one time
+  if (manager_.getMaxTime() == time && manager_.getMinTime() == time) {
+    const Coefficient& coefficient = manager_.coefficientBegin()->second.coefficient;
+    value = coefficient.getTransformation();
+    if (jacobianA != NULL) {
+      jacobianA->setZero();
+      jacobianA->block<3, 3>(0, Coefficient::kPositionOffset).setIdentity();
+      jacobianA->block<3, 4>(3, Coefficient::kQuaternionOffset) =
+          hermite_kernels::quaternionToRotationVectorJacobian<double>(coefficient.getEigenQuaternion());
+    }
+    if (jacobianB != NULL) {
+      jacobianB->setZero();
+    }
+    if (keyA != NULL) {
+      *keyA = manager_.coefficientBegin()->second.key;
+    }
+    if (keyB != NULL) {
+      *keyB = manager_.coefficientBegin()->second.key;
+    }
+    return true;
+  }
+
+  CoefficientIter a, b;
+  bool success = manager_.getCoefficientsAt(time, &a, &b);
+  if(!success) {
+    std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+    return false;
+  }
+
+  const Coefficient& coefficientA = a->second.coefficient;
+  const Coefficient& coefficientB = b->second.coefficient;
+
+  // make alpha
+  const double dt_sec = (b->first - a->first);
+  const double alpha = double(time - a->first)/dt_sec;
+
+  Eigen::Vector3d translation;
+  Eigen::Quaterniond rotation;
+  hermite_kernels::evaluatePoseWithJacobians<double>(
+      coefficientA.getPosition(), coefficientA.getEigenQuaternion(),
+      coefficientA.getLinearVelocity(), coefficientA.getAngularVelocity(),
+      coefficientB.getPosition(), coefficientB.getEigenQuaternion(),
+      coefficientB.getLinearVelocity(), coefficientB.getAngularVelocity(),
+      dt_sec, alpha, &translation, &rotation, jacobianA, jacobianB);
+
+  value = SE3(SE3::Position(translation),
+              RotationQuaternion(rotation.w(), rotation.x(), rotation.y(), rotation.z()));
+  if (keyA != NULL) {
+    *keyA = a->second.key;
+  }
+  if (keyB != NULL) {
+    *keyB = b->second.key;
+  }
+  return true;
+}
+
 bool CubicHermiteSE3Curve::evaluateDerivative(DerivativeType& derivative,
     Time time, unsigned int derivativeOrder) const
 {
@@ -285,87 +300,16 @@ bool CubicHermiteSE3Curve::evaluateDerivative(DerivativeType& derivative,
         return false;
       }
 
-      // read out transformation from coefficient
-      const SE3 T_W_A = a->second.coefficient.getTransformation();
-      const SE3 T_W_B = b->second.coefficient.getTransformation();
-
-      // read out derivative from coefficient
-      const Twist d_W_A = a->second.coefficient.getTransformationDerivative();
-      const Twist d_W_B = b->second.coefficient.getTransformationDerivative();
+      const Coefficient& coefficientA = a->second.coefficient;
+      const Coefficient& coefficientB = b->second.coefficient;
 
       // make alpha
-      double dt_sec = (b->first - a->first);
-      const double one_over_dt_sec = 1.0/dt_sec;
-      double alpha = double(time - a->first)/dt_sec;
-
-      const double alpha2 = alpha * alpha;
-      const double alpha3 = alpha2 * alpha;
-
-      /**************************************************************************************
-       *  Translational part:
-       **************************************************************************************/
-      // Implementation of translation
-      const double gamma0 = 6.0*(alpha2 - alpha);
-      const double gamma1 = 3.0*alpha2 - 4.0*alpha + 1.0;
-      const double gamma2 = 6.0*(alpha - alpha2);
-      const double gamma3 = 3.0*alpha2 - 2.0*alpha;
-
-      const Eigen::Vector3d velocity_m_s = T_W_A.getPosition().vector()*(gamma0*one_over_dt_sec)
-                                         + d_W_A.getTranslationalVelocity().vector()*(gamma1)
-                                         + T_W_B.getPosition().vector()*(gamma2*one_over_dt_sec)
-                                         + d_W_B.getTranslationalVelocity().vector()*(gamma3);
-
-
-      /**************************************************************************************
-       *  Rotational part:
-       **************************************************************************************/
-      const double one_minus_alpha = (1.0 - alpha);
-      const double one_minus_alpha_2 = one_minus_alpha * one_minus_alpha;
-      const double one_minus_alpha_3 = one_minus_alpha * one_minus_alpha_2;
-
-      const double beta1 = 1.0 - one_minus_alpha_3;
-      const double dbeta1 = 3.0*one_minus_alpha_2;
-      const double beta2 = 3.0*alpha2 - 2.0*alpha3;
-      const double dbeta2 = 6.0*alpha*one_minus_alpha;
-      const double beta3 = alpha3;
-      const double dbeta3 = 3.0*alpha2;
-
-      const double one_third = 1.0 / 3.0;
-      const Eigen::Vector3d scaled_d_W_A = (one_third*dt_sec ) * d_W_A.getRotationalVelocity().vector();
-      const Eigen::Vector3d scaled_d_W_B = (one_third*dt_sec ) * d_W_B.getRotationalVelocity().vector();
-
-      const Eigen::Vector3d w1 = T_W_A.getRotation().inverseRotate(scaled_d_W_A);
-      const Eigen::Vector3d w3 = T_W_B.getRotation().inverseRotate(scaled_d_W_B);
-      const RotationQuaternion expW1_inv = RotationQuaternion().exponentialMap(-w1);
-      const RotationQuaternion expW3_inv = RotationQuaternion().exponentialMap(-w3);
-
-      const RotationQuaternion expW1_Inv_qWB_expW3 = expW1_inv * T_W_A.getRotation().inverted() * T_W_B.getRotation() * expW3_inv;
-
-      const Eigen::Vector3d w2 = expW1_Inv_qWB_expW3.logarithmicMap();
-
-      const SO3 w1_beta1_exp = RotationQuaternion().exponentialMap((beta1) * w1);
-      const SO3 w2_beta2_exp = RotationQuaternion().exponentialMap((beta2) * w2);
-      const SO3 w3_beta3_exp = RotationQuaternion().exponentialMap((beta3) * w3);
-
-      const RotationQuaternion w1_dbeta1(0.0, dbeta1 * w1);
-      const RotationQuaternion w2_dbeta2(0.0, dbeta2 * w2);
-      const RotationQuaternion w3_dbeta3(0.0, dbeta3 * w3);
-
-      const Eigen::Vector4d diff =    ((T_W_A.getRotation() * w1_beta1_exp * w1_dbeta1    * w2_beta2_exp * w3_beta3_exp).vector()
-                              + (T_W_A.getRotation() * w1_beta1_exp * w2_beta2_exp * w2_dbeta2    * w3_beta3_exp).vector()
-                              + (T_W_A.getRotation() * w1_beta1_exp * w2_beta2_exp * w3_beta3_exp * w3_dbeta3   ).vector())*one_over_dt_sec;
-
-      const RotationQuaternion qDiff(diff);
-      ValueType q;
-      if(!evaluate(q, time)) {
-        return false;
-      }
-      // This is the global angular velocity
-      const Eigen::Vector3d angularVelocity_rad_s = q.getRotation().rotate((q.getRotation().inverted()*qDiff).imaginary());
+      const double dt_sec = (b->first - a->first);
+      const double alpha = double(time - a->first)/dt_sec;
 
-      // note: unit of derivative is m/s for first 3 and rad/s for last 3 entries
-
-      derivative = DerivativeType(velocity_m_s, angularVelocity_rad_s);
+      // note: unit of derivative is m/s for first 3 and rad/s for last 3 entries,
+      // the angular velocity is global
+      derivative = Coefficient::interpolateDerivative(coefficientA, coefficientB, dt_sec, alpha);
       return true;
     }
   }
@@ -384,84 +328,41 @@ bool CubicHermiteSE3Curve::evaluateLinearAcceleration(kindr::Acceleration3D& lin
     return false;
   }
 
-  // read out transformation from coefficient
-  const SE3 T_W_A = a->second.coefficient.getTransformation();
-  const SE3 T_W_B = b->second.coefficient.getTransformation();
-
-  // read out derivative from coefficient
-  const Twist d_W_A = a->second.coefficient.getTransformationDerivative();
-  const Twist d_W_B = b->second.coefficient.getTransformationDerivative();
+  const Coefficient& coefficientA = a->second.coefficient;
+  const Coefficient& coefficientB = b->second.coefficient;
 
   // make alpha
-  double dt_sec = (b->first - a->first);
-  const double one_over_dt_sec = 1.0/dt_sec;
-  double alpha = double(time - a->first)/dt_sec;
-  const double d_alpha = one_over_dt_sec;
-
-  /**************************************************************************************
-   *  Translational part:
-   **************************************************************************************/
-  // Implementation of translation
-  const double d_gamma0 = 6.0*(2*alpha - 1.0)*d_alpha;
-  const double d_gamma1 = (6.0*alpha - 4.0)*d_alpha;
-  const double d_gamma2 = 6.0*(1.0 - 2.0*alpha)*d_alpha;
-  const double d_gamma3 = (6.0*alpha - 2.0)*d_alpha;
-
-  linearAcceleration = kindr::Acceleration3D(T_W_A.getPosition().vector()*d_gamma0*one_over_dt_sec + d_W_A.getTranslationalVelocity().vector()*d_gamma1 +
-                                             T_W_B.getPosition().vector()*d_gamma2*one_over_dt_sec + d_W_B.getTranslationalVelocity().vector()*d_gamma3);
+  const double dt_sec = (b->first - a->first);
+  const double alpha = double(time - a->first)/dt_sec;
 
+  linearAcceleration = kindr::Acceleration3D(hermite_kernels::evaluateLinearAcceleration<double>(
+      coefficientA.getPosition(), coefficientA.getLinearVelocity(),
+      coefficientB.getPosition(), coefficientB.getLinearVelocity(), dt_sec, alpha));
 
   return true;
 }
 
-/// \brief forms cubic Hermite interpolation into a binary expression with 2 leafs and binds alpha into it,
-///        uses break down of expression into its operations
-//gtsam::Expression<typename CubicHermiteSE3Curve::ValueType>
-//CubicHermiteSE3Curve::getValueExpression(const Time& time) const {
-//
-//  using namespace gtsam;
-//
-//  // CoefficientType is HermiteTransformation
-//  CoefficientIter rval0, rval1;
-//  bool success = manager_.getCoefficientsAt(time, &rval0, &rval1);
-//  CHECK(success) << "Unable to get the coefficients at time " << time;
-//
-//  // shall return the Transformation Expression for Hermite
-//  EHermiteTransformation leaf1(rval0->second.key);
-//  EHermiteTransformation leaf2(rval1->second.key);
-//
-//  double dt_sec = (rval1->first - rval0->first) * 1e-9;
-//  double alpha = double(time - rval0->first)/(rval1->first - rval0->first);
-//
-//  // construct the necessary Expressions (and underlying Jacobians) for evaluation
-//  ETransformation transformation1 = kindr::minimal::transformationFromHermiteTransformation(leaf1);
-//  EVector3 angVel1 = kindr::minimal::angularVelocitiesFromHermiteTransformation(leaf1);
-//  EVector3 vel1 = kindr::minimal::velocitiesFromHermiteTransformation(leaf1);
-//  EQuaternion quat1 = kindr::minimal::rotationFromTransformation(transformation1);
-//  EVector3 trans1 = kindr::minimal::translationFromTransformation(transformation1);
-//
-//  ETransformation transformation2 = kindr::minimal::transformationFromHermiteTransformation(leaf2);
-//  EVector3 angVel2 = kindr::minimal::angularVelocitiesFromHermiteTransformation(leaf2);
-//  EVector3 vel2 = kindr::minimal::velocitiesFromHermiteTransformation(leaf2);
-//  EQuaternion quat2 = kindr::minimal::rotationFromTransformation(transformation2);
-//  EVector3 trans2 = kindr::minimal::translationFromTransformation(transformation2);
-//
-//  EQuaternion quat = kindr::minimal::hermiteQuaternionInterpolation(quat1,
-//                                                                    angVel1,
-//                                                                    quat2,
-//                                                                    angVel2,
-//                                                                    alpha,
-//                                                                    dt_sec);
-//
-//  EVector3 trans = kindr::minimal::hermiteInterpolation<Vector3>(trans1,
-//                                                                 vel1,
-//                                                                 trans2,
-//                                                                 vel2,
-//                                                                 alpha,
-//                                                                 dt_sec);
-//
-//  return kindr::minimal::transformationFromComponents(quat, trans);
-//}
+CoefficientExpression<CubicHermiteSE3Curve::ValueType, CubicHermiteSE3Curve::Coefficient>
+CubicHermiteSE3Curve::getValueExpression(const Time& time) const {
+  typedef CoefficientExpression<ValueType, Coefficient> Expression;
+  // Check if the curve is only defined at this one time
+  if (manager_.getMaxTime() == time && manager_.getMinTime() == time) {
+    return Expression(std::vector<Key>(1, manager_.coefficientBegin()->second.key),
+                      [](const std::vector<Coefficient>& coefficients) {
+      return coefficients[0].getTransformation();
+    });
+  }
+  CoefficientIter a, b;
+  CHECK(manager_.getCoefficientsAt(time, &a, &b)) << "Unable to get the coefficients at time " << time;
+  std::vector<Key> keys;
+  keys.push_back(a->second.key);
+  keys.push_back(b->second.key);
+  const double dt_sec = (b->first - a->first);
+  const double alpha = double(time - a->first)/dt_sec;
+  return Expression(keys, [dt_sec, alpha](const std::vector<Coefficient>& coefficients) {
+    return Coefficient::interpolate(coefficients[0], coefficients[1], dt_sec, alpha);
+  });
+}
 
 //gtsam::Expression<typename CubicHermiteSE3Curve::DerivativeType>
 //CubicHermiteSE3Curve::getDerivativeExpression(const Time& time, unsigned derivativeOrder) const {
@@ -576,18 +477,22 @@ void CubicHermiteSE3Curve::saveCurveTimesAndValues(const std::string& filename)
 }
 
 void CubicHermiteSE3Curve::saveCurveAtTimes(const std::string& filename, std::vector<Time> times) const {
-  Eigen::VectorXd v(7);
-
-  std::vector<Eigen::VectorXd> curveValues;
-  ValueType val;
-  for (size_t i = 0; i < times.size(); ++i) {
-    evaluate(val, times[i]);
-    v << val.getPosition().x(), val.getPosition().y(), val.getPosition().z(),
-        val.getRotation().w(), val.getRotation().x(), val.getRotation().y(), val.getRotation().z();
-    curveValues.push_back(v);
+  CsvCurveSampleSink<ValueType> sink(filename);
+  if (!CurveSampler<CubicHermiteSE3Curve>(*this).sampleAtTimes(times, &sink)) {
+    std::cerr << "CubicHermiteSE3Curve::saveCurveAtTimes: could not write all samples to " << filename << std::endl;
   }
+}
 
-  writeTimeVectorCSV(filename, times, curveValues);
+bool CubicHermiteSE3Curve::saveCurveBinary(const std::string& filename) const {
+  std::vector<Time> times;
+  std::vector<Coefficient> coefficients;
+  times.reserve(manager_.size());
+  coefficients.reserve(manager_.size());
+  for (CoefficientIter it = manager_.coefficientBegin(); it != manager_.coefficientEnd(); ++it) {
+    times.push_back(it->first);
+    coefficients.push_back(it->second.coefficient);
+  }
+  return writeHermiteSE3CurveFile(filename, times, coefficients);
 }
 
 void CubicHermiteSE3Curve::getCurveTimes(std::vector<Time>* outTimes) const {
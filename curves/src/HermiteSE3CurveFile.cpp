@@ -0,0 +1,263 @@
+/*
+ * HermiteSE3CurveFile.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "curves/HermiteSE3CurveFile.hpp"
+
+namespace curves {
+
+constexpr char HermiteSE3CurveFileHeader::kMagic[8];
+constexpr uint32_t HermiteSE3CurveFileHeader::kVersion;
+constexpr uint64_t HermiteSE3CurveFileHeader::kAlignment;
+
+namespace {
+
+const size_t kCoefficientStride = sizeof(HermiteSE3Coefficient);
+
+// The format is little-endian and arrays are read in place, so only little-endian hosts
+// can write or map it.
+bool isLittleEndian() {
+  const uint32_t one = 1;
+  unsigned char firstByte;
+  std::memcpy(&firstByte, &one, 1);
+  return firstByte == 1;
+}
+
+uint64_t alignOffset(uint64_t offset) {
+  const uint64_t alignment = HermiteSE3CurveFileHeader::kAlignment;
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+bool writePadding(FILE* fp, uint64_t from, uint64_t to) {
+  static const char zeros[HermiteSE3CurveFileHeader::kAlignment] = {0};
+  return to == from || fwrite(zeros, 1, to - from, fp) == to - from;
+}
+
+} // namespace
+
+bool writeHermiteSE3CurveFile(const std::string& filename,
+                              const std::vector<Time>& times,
+                              const std::vector<HermiteSE3Coefficient>& coefficients) {
+  if (times.size() != coefficients.size()) {
+    std::cerr << "[writeHermiteSE3CurveFile] Number of times and coefficients don't match." << std::endl;
+    return false;
+  }
+  if (!isLittleEndian()) {
+    std::cerr << "[writeHermiteSE3CurveFile] Only little-endian hosts are supported." << std::endl;
+    return false;
+  }
+
+  HermiteSE3CurveFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, HermiteSE3CurveFileHeader::kMagic, sizeof(header.magic));
+  header.version = HermiteSE3CurveFileHeader::kVersion;
+  header.headerSize = sizeof(HermiteSE3CurveFileHeader);
+  header.numKnots = times.size();
+  header.timesOffset = alignOffset(sizeof(HermiteSE3CurveFileHeader));
+  header.coefficientsOffset = alignOffset(header.timesOffset + times.size() * sizeof(Time));
+  header.coefficientStride = kCoefficientStride;
+  header.coefficientSize = HermiteSE3Coefficient::kSize;
+
+  FILE* fp = fopen(filename.c_str(), "wb");
+  if (fp == NULL) {
+    std::cerr << "[writeHermiteSE3CurveFile] Could not open file " << filename << std::endl;
+    return false;
+  }
+
+  bool success = fwrite(&header, sizeof(header), 1, fp) == 1;
+  success = success && writePadding(fp, sizeof(header), header.timesOffset);
+  success = success && (times.empty() || fwrite(times.data(), sizeof(Time), times.size(), fp) == times.size());
+  success = success && writePadding(fp, header.timesOffset + times.size() * sizeof(Time), header.coefficientsOffset);
+  char record[kCoefficientStride];
+  std::memset(record, 0, kCoefficientStride);
+  for (size_t i = 0; success && i < coefficients.size(); ++i) {
+    std::memcpy(record, coefficients[i].data(), HermiteSE3Coefficient::kSize * sizeof(double));
+    success = fwrite(record, kCoefficientStride, 1, fp) == 1;
+  }
+  success = (fclose(fp) == 0) && success;
+  if (!success) {
+    std::cerr << "[writeHermiteSE3CurveFile] Could not write file " << filename << std::endl;
+  }
+  return success;
+}
+
+MappedCubicHermiteSE3Curve::MappedCubicHermiteSE3Curve()
+    : mapping_(NULL),
+      mappingSize_(0),
+      times_(NULL),
+      coefficients_(NULL),
+      coefficientStride_(kCoefficientStride),
+      size_(0) {}
+
+MappedCubicHermiteSE3Curve::~MappedCubicHermiteSE3Curve() {
+  clear();
+}
+
+void MappedCubicHermiteSE3Curve::clear() {
+  if (mapping_ != NULL) {
+    munmap(mapping_, mappingSize_);
+  }
+  mapping_ = NULL;
+  mappingSize_ = 0;
+  times_ = NULL;
+  coefficients_ = NULL;
+  size_ = 0;
+}
+
+bool MappedCubicHermiteSE3Curve::load(const std::string& filename) {
+  clear();
+  if (!isLittleEndian()) {
+    std::cerr << "[MappedCubicHermiteSE3Curve::load] Only little-endian hosts are supported." << std::endl;
+    return false;
+  }
+
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    std::cerr << "[MappedCubicHermiteSE3Curve::load] Could not open file " << filename << std::endl;
+    return false;
+  }
+  struct stat fileStatus;
+  if (fstat(fd, &fileStatus) != 0 || fileStatus.st_size < static_cast<off_t>(sizeof(HermiteSE3CurveFileHeader))) {
+    std::cerr << "[MappedCubicHermiteSE3Curve::load] File " << filename << " is too small." << std::endl;
+    close(fd);
+    return false;
+  }
+  const size_t fileSize = static_cast<size_t>(fileStatus.st_size);
+  void* mapping = mmap(NULL, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    std::cerr << "[MappedCubicHermiteSE3Curve::load] Could not map file " << filename << std::endl;
+    return false;
+  }
+
+  HermiteSE3CurveFileHeader header;
+  std::memcpy(&header, mapping, sizeof(header));
+  const char* error = NULL;
+  if (std::memcmp(header.magic, HermiteSE3CurveFileHeader::kMagic, sizeof(header.magic)) != 0) {
+    error = "is not a Hermite SE3 curve file";
+  } else if (header.version != HermiteSE3CurveFileHeader::kVersion) {
+    error = "has an unsupported version";
+  } else if (header.headerSize != sizeof(HermiteSE3CurveFileHeader) ||
+             header.coefficientStride != kCoefficientStride ||
+             header.coefficientSize != HermiteSE3Coefficient::kSize ||
+             header.timesOffset % HermiteSE3CurveFileHeader::kAlignment != 0 ||
+             header.coefficientsOffset % HermiteSE3CurveFileHeader::kAlignment != 0) {
+    error = "has an unsupported layout";
+  } else if (header.timesOffset < header.headerSize || header.coefficientsOffset < header.headerSize) {
+    error = "has sections overlapping the header";
+  } else if (header.timesOffset > fileSize || header.coefficientsOffset > fileSize ||
+             header.numKnots > (fileSize - header.timesOffset) / sizeof(Time) ||
+             header.numKnots > (fileSize - header.coefficientsOffset) / kCoefficientStride) {
+    // Written without sums so that crafted offsets cannot wrap around.
+    error = "is truncated";
+  } else {
+    // getIndicesAt bisects the times.
+    const Time* times = reinterpret_cast<const Time*>(static_cast<const char*>(mapping) + header.timesOffset);
+    for (uint64_t i = 1; i < header.numKnots; ++i) {
+      if (!(times[i - 1] < times[i])) {
+        error = "has knot times which are not strictly increasing";
+        break;
+      }
+    }
+  }
+  if (error != NULL) {
+    std::cerr << "[MappedCubicHermiteSE3Curve::load] File " << filename << " " << error << "." << std::endl;
+    munmap(mapping, fileSize);
+    return false;
+  }
+
+  mapping_ = mapping;
+  mappingSize_ = fileSize;
+  times_ = reinterpret_cast<const Time*>(static_cast<const char*>(mapping) + header.timesOffset);
+  coefficients_ = static_cast<const char*>(mapping) + header.coefficientsOffset;
+  coefficientStride_ = header.coefficientStride;
+  size_ = header.numKnots;
+  return true;
+}
+
+Time MappedCubicHermiteSE3Curve::getMinTime() const {
+  return size_ == 0 ? 0.0 : times_[0];
+}
+
+Time MappedCubicHermiteSE3Curve::getMaxTime() const {
+  return size_ == 0 ? 0.0 : times_[size_ - 1];
+}
+
+bool MappedCubicHermiteSE3Curve::isEmpty() const {
+  return size_ == 0;
+}
+
+int MappedCubicHermiteSE3Curve::size() const {
+  return static_cast<int>(size_);
+}
+
+const MappedCubicHermiteSE3Curve::Coefficient& MappedCubicHermiteSE3Curve::getCoefficient(size_t i) const {
+  return *reinterpret_cast<const Coefficient*>(coefficients_ + i * coefficientStride_);
+}
+
+bool MappedCubicHermiteSE3Curve::getIndicesAt(Time time, size_t* a, size_t* b) const {
+  if (size_ < 2 || time < times_[0] || time > times_[size_ - 1]) {
+    return false;
+  }
+  size_t upper = std::upper_bound(times_, times_ + size_, time) - times_;
+  if (upper == size_) {
+    --upper;
+  }
+  *a = upper - 1;
+  *b = upper;
+  return true;
+}
+
+bool MappedCubicHermiteSE3Curve::evaluate(ValueType& value, Time time) const {
+  // Check if the curve is only defined at this one time
+  if (size_ == 1 && times_[0] == time) {
+    value = getCoefficient(0).getTransformation();
+    return true;
+  }
+  size_t a, b;
+  if (!getIndicesAt(time, &a, &b)) {
+    std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+    return false;
+  }
+  const double dt_sec = (times_[b] - times_[a]);
+  const double alpha = double(time - times_[a])/dt_sec;
+  value = Coefficient::interpolate(getCoefficient(a), getCoefficient(b), dt_sec, alpha);
+  return true;
+}
+
+bool MappedCubicHermiteSE3Curve::evaluateDerivative(DerivativeType& derivative, Time time,
+                                                    unsigned int derivativeOrder) const {
+  if (derivativeOrder != 1) {
+    std::cerr << "MappedCubicHermiteSE3Curve::evaluateDerivative: higher order derivatives are not implemented!";
+    return false;
+  }
+  // Check if the curve is only defined at this one time
+  if (size_ == 1 && times_[0] == time) {
+    derivative = getCoefficient(0).getTransformationDerivative();
+    return true;
+  }
+  size_t a, b;
+  if (!getIndicesAt(time, &a, &b)) {
+    std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+    return false;
+  }
+  const double dt_sec = (times_[b] - times_[a]);
+  const double alpha = double(time - times_[a])/dt_sec;
+  derivative = Coefficient::interpolateDerivative(getCoefficient(a), getCoefficient(b), dt_sec, alpha);
+  return true;
+}
+
+} // namespace curves
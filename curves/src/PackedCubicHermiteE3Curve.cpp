@@ -0,0 +1,278 @@
+/*
+ * PackedCubicHermiteE3Curve.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "curves/PackedCubicHermiteE3Curve.hpp"
+
+// stl
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+// curves
+#include "curves/cubic_hermite_kernels.hpp"
+
+namespace curves {
+
+namespace {
+
+// Samples per batch block, small enough for the gathered knots to stay in L1.
+const size_t kBlockSize = 256;
+
+// Forward steps of the cursor before falling back to a binary search.
+const size_t kMaxLinearSteps = 8;
+
+typedef Eigen::Array<double, Eigen::Dynamic, 1> BlockArray;
+typedef Eigen::Array<double, Eigen::Dynamic, 3> BlockMatrix;
+
+} // namespace
+
+PackedCubicHermiteE3Curve::PackedCubicHermiteE3Curve() {}
+
+PackedCubicHermiteE3Curve::PackedCubicHermiteE3Curve(const CubicHermiteE3Curve& curve) {
+  std::vector<Time> times;
+  std::vector<CubicHermiteE3Curve::Coefficient> coefficients;
+  curve.getKnots(&times, &coefficients);
+  times_ = times;
+  positions_.resize(times.size(), 3);
+  velocities_.resize(times.size(), 3);
+  for (size_t i = 0; i < times.size(); ++i) {
+    positions_.row(i) = coefficients[i].getPosition().transpose();
+    velocities_.row(i) = coefficients[i].getVelocity().transpose();
+  }
+}
+
+void PackedCubicHermiteE3Curve::fitCurveWithDerivatives(const std::vector<Time>& times,
+                                                        const std::vector<ValueType>& values,
+                                                        const DerivativeType& initialDerivative,
+                                                        const DerivativeType& finalDerivative) {
+  assert(times.size() == values.size());
+  std::vector<DerivativeType> velocities(times.size());
+  for (size_t i = 0; i < times.size(); ++i) {
+    if (i == 0) {
+      velocities[i] = initialDerivative;
+    } else if (i == times.size() - 1) {
+      velocities[i] = finalDerivative;
+    } else {
+      // Catmull-Rom tangent, as in CubicHermiteE3Curve::calculateSlope.
+      velocities[i] = (values[i + 1] - values[i - 1]) * (1.0 / double(times[i + 1] - times[i - 1]));
+    }
+  }
+  setKnots(times, values, velocities);
+}
+
+void PackedCubicHermiteE3Curve::fitCurve(const std::vector<Time>& times,
+                                         const std::vector<ValueType>& values) {
+  fitCurveWithDerivatives(times, values, DerivativeType::Zero(), DerivativeType::Zero());
+}
+
+void PackedCubicHermiteE3Curve::setKnots(const std::vector<Time>& times,
+                                         const std::vector<ValueType>& positions,
+                                         const std::vector<DerivativeType>& velocities) {
+  assert(times.size() == positions.size());
+  assert(times.size() == velocities.size());
+  times_ = times;
+  positions_.resize(times.size(), 3);
+  velocities_.resize(times.size(), 3);
+  for (size_t i = 0; i < times.size(); ++i) {
+    assert(i == 0 || times[i - 1] < times[i]);
+    positions_.row(i) = positions[i].transpose();
+    velocities_.row(i) = velocities[i].transpose();
+  }
+}
+
+Time PackedCubicHermiteE3Curve::getMinTime() const {
+  return times_.empty() ? 0 : times_.front();
+}
+
+Time PackedCubicHermiteE3Curve::getMaxTime() const {
+  return times_.empty() ? 0 : times_.back();
+}
+
+bool PackedCubicHermiteE3Curve::isEmpty() const {
+  return times_.empty();
+}
+
+int PackedCubicHermiteE3Curve::size() const {
+  return times_.size();
+}
+
+bool PackedCubicHermiteE3Curve::findInterval(Time time, size_t hint, size_t* interval) const {
+  if (times_.size() < 2 || !(time >= times_.front() && time <= times_.back())) {
+    return false;
+  }
+  const size_t lastInterval = times_.size() - 2;
+  hint = std::min(hint, lastInterval);
+  if (times_[hint] <= time) {
+    // Sorted samples usually stay in the same or a following interval.
+    for (size_t step = 0; step < kMaxLinearSteps; ++step, ++hint) {
+      if (hint == lastInterval || time < times_[hint + 1]) {
+        *interval = hint;
+        return true;
+      }
+    }
+    *interval = std::upper_bound(times_.begin() + hint, times_.end(), time) - times_.begin() - 1;
+  } else {
+    *interval = std::upper_bound(times_.begin(), times_.begin() + hint + 1, time) - times_.begin() - 1;
+  }
+  *interval = std::min(*interval, lastInterval);
+  return true;
+}
+
+bool PackedCubicHermiteE3Curve::evaluate(ValueType& value, Time time) const {
+  // Check if the curve is only defined at this one time
+  if (times_.size() == 1 && times_.front() == time) {
+    value = positions_.row(0).transpose();
+    return true;
+  }
+  size_t i;
+  if (!findInterval(time, 0, &i)) {
+    std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+    return false;
+  }
+  const double dt = times_[i + 1] - times_[i];
+  const double alpha = double(time - times_[i]) / dt;
+  value = hermite_kernels::evaluatePosition<double>(positions_.row(i).transpose(), velocities_.row(i).transpose(),
+                                                    positions_.row(i + 1).transpose(),
+                                                    velocities_.row(i + 1).transpose(), dt, alpha);
+  return true;
+}
+
+bool PackedCubicHermiteE3Curve::evaluateDerivative(DerivativeType& derivative, Time time,
+                                                   unsigned int derivativeOrder) const {
+  if (derivativeOrder == 2) {
+    return evaluateLinearAcceleration(derivative, time);
+  } else if (derivativeOrder != 1) {
+    std::cerr << "PackedCubicHermiteE3Curve::evaluateDerivative: higher order derivatives are not implemented!";
+    return false;
+  }
+  if (times_.size() == 1 && times_.front() == time) {
+    derivative = velocities_.row(0).transpose();
+    return true;
+  }
+  size_t i;
+  if (!findInterval(time, 0, &i)) {
+    std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+    return false;
+  }
+  const double dt = times_[i + 1] - times_[i];
+  const double alpha = double(time - times_[i]) / dt;
+  derivative = hermite_kernels::evaluateLinearVelocity<double>(
+      positions_.row(i).transpose(), velocities_.row(i).transpose(),
+      positions_.row(i + 1).transpose(), velocities_.row(i + 1).transpose(), dt, alpha);
+  return true;
+}
+
+bool PackedCubicHermiteE3Curve::evaluateLinearAcceleration(Acceleration& linearAcceleration, Time time) const {
+  size_t i;
+  if (!findInterval(time, 0, &i)) {
+    std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+    return false;
+  }
+  const double dt = times_[i + 1] - times_[i];
+  const double alpha = double(time - times_[i]) / dt;
+  linearAcceleration = hermite_kernels::evaluateLinearAcceleration<double>(
+      positions_.row(i).transpose(), velocities_.row(i).transpose(),
+      positions_.row(i + 1).transpose(), velocities_.row(i + 1).transpose(), dt, alpha);
+  return true;
+}
+
+bool PackedCubicHermiteE3Curve::evaluate(const std::vector<Time>& times, SampleMatrix* positions,
+                                         SampleMatrix* velocities, SampleMatrix* accelerations) const {
+  const size_t nSamples = times.size();
+  if (positions != NULL) positions->resize(nSamples, 3);
+  if (velocities != NULL) velocities->resize(nSamples, 3);
+  if (accelerations != NULL) accelerations->resize(nSamples, 3);
+
+  if (times_.size() == 1) {
+    // Only defined at one time, no interval to vectorize over.
+    for (size_t s = 0; s < nSamples; ++s) {
+      if (times[s] != times_.front()) {
+        std::cerr << "Unable to get the coefficients at time " << times[s] << std::endl;
+        return false;
+      }
+    }
+    if (positions != NULL) *positions = positions_.row(0).replicate(nSamples, 1);
+    if (velocities != NULL) *velocities = velocities_.row(0).replicate(nSamples, 1);
+    if (accelerations != NULL) accelerations->setZero();
+    return true;
+  }
+
+  BlockArray alpha, oneOverDt, dt;
+  BlockMatrix positionA, velocityA, positionB, velocityB;
+  size_t interval = 0;
+  for (size_t begin = 0; begin < nSamples; begin += kBlockSize) {
+    const size_t n = std::min(kBlockSize, nSamples - begin);
+    alpha.resize(n);
+    dt.resize(n);
+    positionA.resize(n, 3);
+    velocityA.resize(n, 3);
+    positionB.resize(n, 3);
+    velocityB.resize(n, 3);
+
+    // Locate the intervals and gather their knots.
+    for (size_t s = 0; s < n; ++s) {
+      const Time time = times[begin + s];
+      if (!findInterval(time, interval, &interval)) {
+        std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+        return false;
+      }
+      dt(s) = times_[interval + 1] - times_[interval];
+      alpha(s) = double(time - times_[interval]);
+      positionA.row(s) = positions_.row(interval);
+      velocityA.row(s) = velocities_.row(interval);
+      positionB.row(s) = positions_.row(interval + 1);
+      velocityB.row(s) = velocities_.row(interval + 1);
+    }
+    oneOverDt = dt.inverse();
+    alpha *= oneOverDt;
+    const BlockArray alpha2 = alpha.square();
+
+    // The basis functions are evaluated once per sample and shared by the three columns.
+    if (positions != NULL) {
+      const BlockArray alpha3 = alpha2 * alpha;
+      const BlockArray beta0 = 2.0 * alpha3 - 3.0 * alpha2 + 1.0;
+      const BlockArray beta1 = -2.0 * alpha3 + 3.0 * alpha2;
+      const BlockArray beta2 = (alpha3 - 2.0 * alpha2 + alpha) * dt;
+      const BlockArray beta3 = (alpha3 - alpha2) * dt;
+      positions->middleRows(begin, n) = (positionA.colwise() * beta0 + positionB.colwise() * beta1
+          + velocityA.colwise() * beta2 + velocityB.colwise() * beta3).matrix();
+    }
+    if (velocities != NULL) {
+      const BlockArray gamma0 = 6.0 * (alpha2 - alpha) * oneOverDt;
+      const BlockArray gamma1 = 3.0 * alpha2 - 4.0 * alpha + 1.0;
+      const BlockArray gamma3 = 3.0 * alpha2 - 2.0 * alpha;
+      velocities->middleRows(begin, n) = ((positionA - positionB).colwise() * gamma0
+          + velocityA.colwise() * gamma1 + velocityB.colwise() * gamma3).matrix();
+    }
+    if (accelerations != NULL) {
+      const BlockArray dGamma0 = 6.0 * (2.0 * alpha - 1.0) * oneOverDt.square();
+      const BlockArray dGamma1 = (6.0 * alpha - 4.0) * oneOverDt;
+      const BlockArray dGamma3 = (6.0 * alpha - 2.0) * oneOverDt;
+      accelerations->middleRows(begin, n) = ((positionA - positionB).colwise() * dGamma0
+          + velocityA.colwise() * dGamma1 + velocityB.colwise() * dGamma3).matrix();
+    }
+  }
+  return true;
+}
+
+bool PackedCubicHermiteE3Curve::evaluateDerivative(const std::vector<Time>& times,
+                                                   SampleMatrix* velocities) const {
+  return evaluate(times, NULL, velocities, NULL);
+}
+
+bool PackedCubicHermiteE3Curve::evaluateLinearAcceleration(const std::vector<Time>& times,
+                                                           SampleMatrix* accelerations) const {
+  return evaluate(times, NULL, NULL, accelerations);
+}
+
+void PackedCubicHermiteE3Curve::clear() {
+  times_.clear();
+  positions_.resize(0, 3);
+  velocities_.resize(0, 3);
+}
+
+} // namespace curves
@@ -0,0 +1,25 @@
+/*
+ * PolynomialSpline.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+// curves
+#include "curves/PolynomialSpline.hpp"
+
+namespace curves {
+
+template class PolynomialSpline<1, float>;
+template class PolynomialSpline<2, float>;
+template class PolynomialSpline<3, float>;
+template class PolynomialSpline<4, float>;
+template class PolynomialSpline<5, float>;
+template class PolynomialSpline<1, double>;
+template class PolynomialSpline<2, double>;
+template class PolynomialSpline<3, double>;
+template class PolynomialSpline<4, double>;
+template class PolynomialSpline<5, double>;
+template class PolynomialSpline<7, double>;
+
+}
@@ -0,0 +1,25 @@
+/*
+ * PolynomialSplineContainer.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+// curves
+#include "curves/PolynomialSplineContainer.hpp"
+
+namespace curves {
+
+template class PolynomialSplineContainer<1, float>;
+template class PolynomialSplineContainer<2, float>;
+template class PolynomialSplineContainer<3, float>;
+template class PolynomialSplineContainer<4, float>;
+template class PolynomialSplineContainer<5, float>;
+template class PolynomialSplineContainer<1, double>;
+template class PolynomialSplineContainer<2, double>;
+template class PolynomialSplineContainer<3, double>;
+template class PolynomialSplineContainer<4, double>;
+template class PolynomialSplineContainer<5, double>;
+template class PolynomialSplineContainer<7, double>;
+
+}
@@ -15,4 +15,6 @@ SE3Curve::SE3Curve(){}
 
 SE3Curve::~SE3Curve(){}
 
+void SE3Curve::foldInCorrections(Time /*begTime*/, Time /*endTime*/) {}
+
 }  // namespace
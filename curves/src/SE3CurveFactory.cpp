@@ -15,14 +15,16 @@ std::shared_ptr<SE3Curve> SE3CurveFactory::create_curve(const std::string& curve
 
   if(curveType == "slerp_curve") {
     curve = std::shared_ptr<SE3Curve>(new SlerpSE3Curve());
-  } else if(curveType == "discrete_curve") {
-    curve = std::shared_ptr<SE3Curve>(new DiscreteSE3Curve());
   } else if(curveType == "composition_curve") {
     curve = std::shared_ptr<SE3Curve>(new SE3CompositionCurve<SlerpSE3Curve, SlerpSE3Curve>());
+#ifdef CURVES_USE_GTSAM
+  } else if(curveType == "discrete_curve") {
+    curve = std::shared_ptr<SE3Curve>(new DiscreteSE3Curve());
   } else if(curveType == "discrete_composition_curve") {
     curve = std::shared_ptr<SE3Curve>(new SE3CompositionCurve<DiscreteSE3Curve, DiscreteSE3Curve>());
   } else if(curveType == "semi_discrete_composition_curve") {
     curve = std::shared_ptr<SE3Curve>(new SE3CompositionCurve<SemiDiscreteSE3Curve, SemiDiscreteSE3Curve>());
+#endif
   } else {
     CHECK(false) << "This curve is not implemented.";
   }
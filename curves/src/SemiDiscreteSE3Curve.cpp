@@ -5,10 +5,10 @@
  */
 
 #include <curves/SemiDiscreteSE3Curve.hpp>
+#include <curves/SlerpSE3Curve.hpp>
+#include <curves/cubic_hermite_kernels.hpp>
 #include <iostream>
 
-#include "gtsam/nonlinear/ExpressionFactor.h"
-
 namespace curves {
 
 SemiDiscreteSE3Curve::SemiDiscreteSE3Curve() : SE3Curve() {}
@@ -30,9 +30,12 @@ void SemiDiscreteSE3Curve::print(const std::string& str) const {
       " and " << manager_.getMaxTime() <<std::endl;
   double sum_dp = 0;
   Eigen::Vector3d p1, p2;
-  for(size_t i = 0; i < times.size()-1; ++i) {
-    p1 = evaluate(times[i]).getPosition();
-    p2 = evaluate(times[i+1]).getPosition();
+  ValueType value;
+  for(size_t i = 0; i + 1 < times.size(); ++i) {
+    evaluate(value, times[i]);
+    p1 = value.getPosition().vector();
+    evaluate(value, times[i+1]);
+    p2 = value.getPosition().vector();
     sum_dp += (p1-p2).norm();
   }
   std::cout << "average dt between coefficients: " << (manager_.getMaxTime() -manager_.getMinTime())  / (times.size()-1) << " ns." << std::endl;
@@ -40,7 +43,6 @@ void SemiDiscreteSE3Curve::print(const std::string& str) const {
   std::cout <<"=========================================" <<std::endl;
   for (size_t i = 0; i < manager_.size(); i++) {
     ss << "coefficient " << keys[i] << ": ";
-    gtsam::traits<Coefficient>::Print(manager_.getCoefficientByKey(keys[i]),ss.str());
     std::cout << " | time: " << times[i];
     std::cout << std::endl;
     ss.str("");
@@ -89,162 +91,146 @@ void SemiDiscreteSE3Curve::extend(const std::vector<Time>& times,
   discretePolicy_.extend<SemiDiscreteSE3Curve, ValueType>(times, values, this, outKeys);
 }
 
-typename SemiDiscreteSE3Curve::DerivativeType
-SemiDiscreteSE3Curve::evaluateDerivative(Time time,
-                                         unsigned derivativeOrder) const {
-
-  // time is out of bound --> error
-  CHECK_GE(time, this->getMinTime()) << "Time out of bounds";
-  CHECK_LE(time, this->getMaxTime()) << "Time out of bounds";
-
-  Eigen::VectorXd dCoeff;
-  Time dt;
-  CoefficientIter rval0, rval1;
-  bool success = manager_.getCoefficientsAt(time, &rval0, &rval1);
-  CHECK(success) << "Unable to get the coefficients at time " << time;
-  // first derivative
+bool SemiDiscreteSE3Curve::evaluateDerivative(DerivativeType& derivative, Time time,
+                                              unsigned derivativeOrder) const {
+  if (derivativeOrder == 0) {
+    std::cerr << "SemiDiscreteSE3Curve::evaluateDerivative: derivative order has to be positive!" << std::endl;
+    return false;
+  }
+  // Check if the curve is only defined at this one time
+  if (manager_.getMaxTime() == time && manager_.getMinTime() == time) {
+    derivative.setZero();
+    return true;
+  }
+  CoefficientIter a, b;
+  if (!manager_.getCoefficientsAt(time, &a, &b)) {
+    std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+    return false;
+  }
+  // Slope between the 2 coefficients expressed in the world frame, derivatives of order >1 are 0.
   if (derivativeOrder == 1) {
-    //todo Verify this
-    dCoeff = gtsam::traits<Coefficient>::Local(rval1->second.coefficient,rval0->second.coefficient);
-    dt = rval1->first - rval0->first;
-    return dCoeff/dt;
-    // order of derivative > 1 returns vector of zeros
+    const SE3 T_A_B = a->second.coefficient.inverted() * b->second.coefficient;
+    const Eigen::Matrix3d R_W_A = a->second.coefficient.getRotation().toImplementation().toRotationMatrix();
+    const double inverseDt = 1.0 / double(b->first - a->first);
+    derivative = DerivativeType(
+        Eigen::Vector3d(R_W_A * T_A_B.getPosition().toImplementation() * inverseDt),
+        Eigen::Vector3d(R_W_A * hermite_kernels::quaternionLog<double>(T_A_B.getRotation().toImplementation()) * inverseDt));
   } else {
-    const int dimension = gtsam::traits<Coefficient>::dimension;
-    return Eigen::VectorXd::Zero(dimension,1);
+    derivative.setZero();
   }
+  return true;
 }
 
-/// \brief forms slerp interpolation into a binary expression with 2 leafs and binds alpha into it,
-///        uses break down of expression into its operations
-///        \f[ T = A(A^{-1}B)^{\alpha} \f]
-gtsam::Expression<typename SemiDiscreteSE3Curve::ValueType>
-SemiDiscreteSE3Curve::getValueExpression(const Time& time) const {
-  typedef typename SemiDiscreteSE3Curve::ValueType ValueType;
-  using namespace gtsam;
+bool SemiDiscreteSE3Curve::evaluate(ValueType& value, Time time) const {
+  // Check if the curve is only defined at this one time
+  if (manager_.getMaxTime() == time && manager_.getMinTime() == time) {
+    value = manager_.coefficientBegin()->second.coefficient;
+    return true;
+  }
   CoefficientIter a, b;
-  bool success = manager_.getCoefficientsAt(time, &a, &b);
-  CHECK(success) << "Unable to get the coefficients at time " << time;
-  Expression<ValueType> leaf_a(a->second.key);
-  Expression<ValueType> leaf_b(b->second.key);
-
-  // If the time is closer to a
-  if (b->first - time >= time - a->first) {
-    return leaf_a;
-  } else {
-    return leaf_b;
+  if (!manager_.getCoefficientsAt(time, &a, &b)) {
+    std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+    return false;
   }
-
+  // Implementation of T_W_I = T_W_A*(T_W_A^-1*T_W_B)^alpha
+  const double alpha = double(time - a->first) / double(b->first - a->first);
+  value = composeTransformations(a->second.coefficient,
+                                 transformationPower(a->second.coefficient.inverted() * b->second.coefficient, alpha));
+  return true;
 }
 
-gtsam::Expression<typename SemiDiscreteSE3Curve::DerivativeType>
-SemiDiscreteSE3Curve::getDerivativeExpression(const Time& time, unsigned derivativeOrder) const {
-  // \todo Abel and Renaud
-  CHECK(false) << "Not implemented";
+bool SemiDiscreteSE3Curve::evaluate(const std::vector<Time>& times, std::vector<ValueType>* values) const {
+  CHECK_NOTNULL(values);
+  values->resize(times.size());
+  for (size_t i = 0; i < times.size(); ++i) {
+    if (!evaluate((*values)[i], times[i])) {
+      return false;
+    }
+  }
+  return true;
 }
 
-SE3 SemiDiscreteSE3Curve::evaluate(Time time) const {
+CoefficientExpression<SemiDiscreteSE3Curve::ValueType> SemiDiscreteSE3Curve::getValueExpression(const Time& time) const {
   // Check if the curve is only defined at this one time
   if (manager_.getMaxTime() == time && manager_.getMinTime() == time) {
-    return manager_.coefficientBegin()->second.coefficient;
-  } else {
-    if (time == manager_.getMaxTime()) {
-      // Efficient evaluation of a curve end
-      return (--manager_.coefficientEnd())->second.coefficient;
-    } else {
-      // Semi discrete
-      CoefficientIter a, b;
-      bool success = manager_.getCoefficientsAt(time, &a, &b);
-      CHECK(success) << "Unable to get the coefficients at time " << time;
-      SE3 T_W_A = a->second.coefficient;
-      SE3 T_W_B = b->second.coefficient;
-      double alpha = double(time - a->first)/double(b->first - a->first);
-
-      //Implementation of T_W_I = T_W_A*exp(alpha*log(inv(T_W_A)*T_W_B))
-      using namespace kindr::minimal;
-      SE3 T_A_B = invertAndComposeImplementation(T_W_A, T_W_B, boost::none, boost::none);
-      gtsam::Vector6 log_T_A_B = transformationLogImplementation(T_A_B, boost::none);
-      gtsam::Vector6 log_T_A_I = vectorScalingImplementation<int(6)>(log_T_A_B, alpha, boost::none, boost::none);
-      SE3 T_A_I = transformationExpImplementation(log_T_A_I, boost::none);
-      return composeImplementation(T_W_A, T_A_I, boost::none, boost::none);
-    }
+    return CoefficientExpression<ValueType>(manager_.coefficientBegin()->second.key);
   }
+  CoefficientIter a, b;
+  CHECK(manager_.getCoefficientsAt(time, &a, &b)) << "Unable to get the coefficients at time " << time;
+  std::vector<Key> keys;
+  keys.push_back(a->second.key);
+  keys.push_back(b->second.key);
+  const double alpha = double(time - a->first) / double(b->first - a->first);
+  return CoefficientExpression<ValueType>(keys, [alpha](const std::vector<ValueType>& coefficients) {
+    return composeTransformations(coefficients[0],
+                                  transformationPower(coefficients[0].inverted() * coefficients[1], alpha));
+  });
 }
 
-void SemiDiscreteSE3Curve::setTimeRange(Time minTime, Time maxTime) {
+void SemiDiscreteSE3Curve::setTimeRange(Time /*minTime*/, Time /*maxTime*/) {
   // \todo Abel and Renaud
   CHECK(false) << "Not implemented";
 }
 
 /// \brief Evaluate the angular velocity of Frame b as seen from Frame a, expressed in Frame a.
 Eigen::Vector3d SemiDiscreteSE3Curve::evaluateAngularVelocityA(Time time) {
-  CHECK(false) << "Not implemented";
+  return evaluateTwistA(time).tail<3>();
 }
 /// \brief Evaluate the angular velocity of Frame a as seen from Frame b, expressed in Frame b.
-Eigen::Vector3d SemiDiscreteSE3Curve::evaluateAngularVelocityB(Time time) {
+Eigen::Vector3d SemiDiscreteSE3Curve::evaluateAngularVelocityB(Time /*time*/) {
   CHECK(false) << "Not implemented";
 }
 /// \brief Evaluate the velocity of Frame b as seen from Frame a, expressed in Frame a.
 Eigen::Vector3d SemiDiscreteSE3Curve::evaluateLinearVelocityA(Time time) {
-  CHECK(false) << "Not implemented";
+  return evaluateTwistA(time).head<3>();
 }
 /// \brief Evaluate the velocity of Frame a as seen from Frame b, expressed in Frame b.
-Eigen::Vector3d SemiDiscreteSE3Curve::evaluateLinearVelocityB(Time time) {
+Eigen::Vector3d SemiDiscreteSE3Curve::evaluateLinearVelocityB(Time /*time*/) {
   CHECK(false) << "Not implemented";
 }
 /// \brief evaluate the velocity/angular velocity of Frame b as seen from Frame a,
 /// expressed in Frame a. The return value has the linear velocity (0,1,2),
 /// and the angular velocity (3,4,5).
 Vector6d SemiDiscreteSE3Curve::evaluateTwistA(Time time) {
-  CHECK(false) << "Not implemented";
+  DerivativeType derivative;
+  CHECK(evaluateDerivative(derivative, time, 1)) << "Unable to evaluate the twist at time " << time;
+  return derivative.getVector();
 }
 /// \brief evaluate the velocity/angular velocity of Frame a as seen from Frame b,
 /// expressed in Frame b. The return value has the linear velocity (0,1,2),
 /// and the angular velocity (3,4,5).
-Vector6d SemiDiscreteSE3Curve::evaluateTwistB(Time time) {
+Vector6d SemiDiscreteSE3Curve::evaluateTwistB(Time /*time*/) {
   CHECK(false) << "Not implemented";
 }
 /// \brief Evaluate the angular derivative of Frame b as seen from Frame a, expressed in Frame a.
-Eigen::Vector3d SemiDiscreteSE3Curve::evaluateAngularDerivativeA(unsigned derivativeOrder, Time time) {
+Eigen::Vector3d SemiDiscreteSE3Curve::evaluateAngularDerivativeA(unsigned /*derivativeOrder*/, Time /*time*/) {
   CHECK(false) << "Not implemented";
 }
 /// \brief Evaluate the angular derivative of Frame a as seen from Frame b, expressed in Frame b.
-Eigen::Vector3d SemiDiscreteSE3Curve::evaluateAngularDerivativeB(unsigned derivativeOrder, Time time) {
+Eigen::Vector3d SemiDiscreteSE3Curve::evaluateAngularDerivativeB(unsigned /*derivativeOrder*/, Time /*time*/) {
   CHECK(false) << "Not implemented";
 }
 /// \brief Evaluate the derivative of Frame b as seen from Frame a, expressed in Frame a.
-Eigen::Vector3d SemiDiscreteSE3Curve::evaluateLinearDerivativeA(unsigned derivativeOrder, Time time) {
+Eigen::Vector3d SemiDiscreteSE3Curve::evaluateLinearDerivativeA(unsigned /*derivativeOrder*/, Time /*time*/) {
   CHECK(false) << "Not implemented";
 }
 /// \brief Evaluate the derivative of Frame a as seen from Frame b, expressed in Frame b.
-Eigen::Vector3d SemiDiscreteSE3Curve::evaluateLinearDerivativeB(unsigned derivativeOrder, Time time) {
+Eigen::Vector3d SemiDiscreteSE3Curve::evaluateLinearDerivativeB(unsigned /*derivativeOrder*/, Time /*time*/) {
   CHECK(false) << "Not implemented";
 }
 /// \brief evaluate the velocity/angular derivative of Frame b as seen from Frame a,
 /// expressed in Frame a. The return value has the linear velocity (0,1,2),
 /// and the angular velocity (3,4,5).
-Vector6d SemiDiscreteSE3Curve::evaluateDerivativeA(unsigned derivativeOrder, Time time) {
+Vector6d SemiDiscreteSE3Curve::evaluateDerivativeA(unsigned /*derivativeOrder*/, Time /*time*/) {
   CHECK(false) << "Not implemented";
 }
 /// \brief evaluate the velocity/angular velocity of Frame a as seen from Frame b,
 /// expressed in Frame b. The return value has the linear velocity (0,1,2),
 /// and the angular velocity (3,4,5).
-Vector6d SemiDiscreteSE3Curve::evaluateDerivativeB(unsigned derivativeOrder, Time time) {
+Vector6d SemiDiscreteSE3Curve::evaluateDerivativeB(unsigned /*derivativeOrder*/, Time /*time*/) {
   CHECK(false) << "Not implemented";
 }
 
-void SemiDiscreteSE3Curve::initializeGTSAMValues(gtsam::KeySet keys, gtsam::Values* values) const {
-  manager_.initializeGTSAMValues(keys, values);
-}
-
-void SemiDiscreteSE3Curve::initializeGTSAMValues(gtsam::Values* values) const {
-  manager_.initializeGTSAMValues(values);
-}
-
-void SemiDiscreteSE3Curve::updateFromGTSAMValues(const gtsam::Values& values) {
-  manager_.updateFromGTSAMValues(values);
-}
-
 void SemiDiscreteSE3Curve::setMinSamplingPeriod(Time time) {
   discretePolicy_.setMinSamplingPeriod(time);
 }
@@ -258,42 +244,18 @@ void SemiDiscreteSE3Curve::clear() {
   manager_.clear();
 }
 
-void SemiDiscreteSE3Curve::addPriorFactors(gtsam::NonlinearFactorGraph* graph, Time priorTime) const {
-  Eigen::Matrix<double,6,1> noise;
-  noise(0) = 0.0000001;
-  noise(1) = 0.0000001;
-  noise(2) = 0.0000001;
-  noise(3) = 0.0000001;
-  noise(4) = 0.0000001;
-  noise(5) = 0.0000001;
-
-  gtsam::noiseModel::Diagonal::shared_ptr priorNoise = gtsam::noiseModel::Diagonal::
-      Sigmas(noise);
-
-  CoefficientIter rVal0, rVal1;
-  manager_.getCoefficientsAt(priorTime, &rVal0, &rVal1);
-
-  gtsam::ExpressionFactor<Coefficient> f0(priorNoise,
-                                          rVal0->second.coefficient,
-                                          gtsam::Expression<Coefficient>(rVal0->second.key));
-  gtsam::ExpressionFactor<Coefficient> f1(priorNoise,
-                                          rVal1->second.coefficient,
-                                          gtsam::Expression<Coefficient>(rVal1->second.key));
-  graph->push_back(f0);
-  graph->push_back(f1);
-
-}
-
 void SemiDiscreteSE3Curve::transformCurve(const ValueType T) {
   std::vector<Time> coefTimes;
   manager_.getTimes(&coefTimes);
   for (size_t i = 0; i < coefTimes.size(); ++i) {
     // Apply a rigid transformation to every coefficient (on the left side).
-    manager_.insertCoefficient(coefTimes[i],T*evaluate(coefTimes[i]));
+    ValueType value;
+    evaluate(value, coefTimes[i]);
+    manager_.insertCoefficient(coefTimes[i], T * value);
   }
 }
 
-Time SemiDiscreteSE3Curve::getTimeAtKey(gtsam::Key key) const {
+Time SemiDiscreteSE3Curve::getTimeAtKey(Key key) const {
   return manager_.getCoefficientTimeByKey(key);
 }
 
@@ -308,9 +270,10 @@ void SemiDiscreteSE3Curve::saveCurveAtTimes(const std::string& filename, std::ve
   Eigen::VectorXd v(7);
 
   std::vector<Eigen::VectorXd> curveValues;
-  ValueType val;
-  for (size_t i = 0; i < times.size(); ++i) {
-    val = evaluate(times[i]);
+  std::vector<ValueType> values;
+  evaluate(times, &values);
+  for (size_t i = 0; i < values.size(); ++i) {
+    const ValueType& val = values[i];
     v << val.getPosition().x(), val.getPosition().y(), val.getPosition().z(),
         val.getRotation().w(), val.getRotation().x(), val.getRotation().y(), val.getRotation().z();
     curveValues.push_back(v);
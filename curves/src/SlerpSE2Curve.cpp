@@ -34,9 +34,12 @@ void SlerpSE2Curve::print(const std::string& str) const {
       " and " << manager_.getMaxTime() <<std::endl;
   double sum_dp = 0;
   Eigen::Vector2d p1, p2;
-  for(size_t i = 0; i < times.size()-1; ++i) {
-    p1 = evaluate(times[i]).t().vector();
-    p2 = evaluate(times[i+1]).t().vector();
+  ValueType value;
+  for(size_t i = 0; i + 1 < times.size(); ++i) {
+    evaluate(value, times[i]);
+    p1 << value.x(), value.y();
+    evaluate(value, times[i+1]);
+    p2 << value.x(), value.y();
     sum_dp += (p1-p2).norm();
   }
   std::cout << "average dt between coefficients: " << (manager_.getMaxTime() -manager_.getMinTime())  / (times.size()-1) << " ns." << std::endl;
@@ -94,15 +97,35 @@ void SlerpSE2Curve::extend(const std::vector<Time>& times,
   slerpPolicy_.extend<SlerpSE2Curve, ValueType>(times, values, this, outKeys);
 }
 
-typename SlerpSE2Curve::DerivativeType
-SlerpSE2Curve::evaluateDerivative(Time time,
-                                  unsigned derivativeOrder) const {
-  CHECK(false) << "Not implemented";
+bool SlerpSE2Curve::evaluateDerivative(DerivativeType& derivative, Time time,
+                                       unsigned derivativeOrder) const {
+  if (derivativeOrder == 0) {
+    std::cerr << "SlerpSE2Curve::evaluateDerivative: derivative order has to be positive!" << std::endl;
+    return false;
+  }
+  // Check if the curve is only defined at this one time
+  if (manager_.getMaxTime() == time && manager_.getMinTime() == time) {
+    derivative.setZero();
+    return true;
+  }
+  CoefficientIter a, b;
+  if (!manager_.getCoefficientsAt(time, &a, &b)) {
+    std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+    return false;
+  }
+  // The twist of log(inv(T_W_A)*T_W_B) is constant on an interval, derivatives of order >1 are 0.
+  if (derivativeOrder == 1) {
+    const SE2 T_A_B = a->second.coefficient.inverse() * b->second.coefficient;
+    derivative = gtsam::Pose2::Logmap(T_A_B) / double(b->first - a->first);
+  } else {
+    derivative.setZero();
+  }
+  return true;
 }
 
 /// \brief \f[T^{\alpha}\f]
 SE2 transformationPower(SE2  T, double alpha) {
-  CHECK(false) << "Not implemented";
+  return gtsam::Pose2::Expmap(alpha * gtsam::Pose2::Logmap(T));
 }
 
 /// \brief \f[A*B\f]
@@ -135,64 +158,57 @@ SlerpSE2Curve::getValueExpression(const Time& time) const {
   } else if (alpha == 1) {
     return leaf2;
   } else {
-    std::cout << "Doing slerp" << std::endl;
-    std::cout << "alpha " << alpha << std::endl;
-    Pose2 P0 = evaluate(rval0->first);
-    std::cout << "Pose0 x " << P0.x() << " y " << P0.y() << " theta " << P0.theta() << std::endl;
-    Pose2 P1 = evaluate(rval1->first);
-    std::cout << "Pose1 x " << P1.x() << " y " << P1.y() << " theta " << P1.theta() << std::endl;
-    std::cout << "diff x " << P1.x() - P0.x() << " y " << P1.y() - P0.y() << " theta " << P1.theta() - P0.theta() << std::endl;
     return slerp(leaf1, leaf2, alpha);
   }
 }
 
-gtsam::Expression<typename SlerpSE2Curve::DerivativeType>
-SlerpSE2Curve::getDerivativeExpression(const Time& time, unsigned derivativeOrder) const {
-  // \todo Abel and Renaud
-  CHECK(false) << "Not implemented";
-}
-
-SE2 SlerpSE2Curve::evaluate(Time time) const {
+bool SlerpSE2Curve::evaluate(ValueType& value, Time time) const {
   // Check if the curve is only defined at this one time
   if (manager_.getMaxTime() == time && manager_.getMinTime() == time) {
-    return manager_.coefficientBegin()->second.coefficient;
-  } else {
-    if (time == manager_.getMaxTime()) {
-      // Efficient evaluation of a curve end
-      return (--manager_.coefficientEnd())->second.coefficient;
-    } else {
-      CoefficientIter a, b;
-      bool success = manager_.getCoefficientsAt(time, &a, &b);
-      CHECK(success) << "Unable to get the coefficients at time " << time;
-      SE2 T_W_A = a->second.coefficient;
-      SE2 T_W_B = b->second.coefficient;
-      double alpha = double(time - a->first)/double(b->first - a->first);
-
-      //Implementation of T_W_I = T_W_A*exp(alpha*log(inv(T_W_A)*T_W_B))
-      SE2 T_A_B = T_W_A.inverse() * T_W_B;
-      gtsam::Vector3 log_T_A_B = gtsam::Pose2::Logmap(T_A_B);
-      gtsam::Vector3 log_T_A_I = log_T_A_B*alpha;
-      SE2 T_A_I = gtsam::Pose2::Expmap(log_T_A_I);
-      return T_W_A * T_A_I;
-    }
+    value = manager_.coefficientBegin()->second.coefficient;
+    return true;
   }
+  CoefficientIter a, b;
+  if (!manager_.getCoefficientsAt(time, &a, &b)) {
+    std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+    return false;
+  }
+  const double alpha = double(time - a->first)/double(b->first - a->first);
+
+  //Implementation of T_W_I = T_W_A*exp(alpha*log(inv(T_W_A)*T_W_B))
+  value = composeTransformations(a->second.coefficient,
+                                 transformationPower(a->second.coefficient.inverse() * b->second.coefficient, alpha));
+  return true;
 }
 
-void SlerpSE2Curve::setTimeRange(Time minTime, Time maxTime) {
+void SlerpSE2Curve::setTimeRange(Time /*minTime*/, Time /*maxTime*/) {
   // \todo Abel and Renaud
   CHECK(false) << "Not implemented";
 }
 
 void SlerpSE2Curve::initializeGTSAMValues(gtsam::KeySet keys, gtsam::Values* values) const {
-  manager_.initializeGTSAMValues(keys, values);
+  CHECK_NOTNULL(values);
+  for (gtsam::KeySet::const_iterator it = keys.begin(); it != keys.end(); ++it) {
+    values->insert(*it, manager_.getCoefficientByKey(*it));
+  }
 }
 
 void SlerpSE2Curve::initializeGTSAMValues(gtsam::Values* values) const {
-  manager_.initializeGTSAMValues(values);
+  CHECK_NOTNULL(values);
+  std::vector<Key> keys;
+  manager_.getKeys(&keys);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    values->insert(keys[i], manager_.getCoefficientByKey(keys[i]));
+  }
 }
 
 void SlerpSE2Curve::updateFromGTSAMValues(const gtsam::Values& values) {
-  manager_.updateFromGTSAMValues(values);
+  // Only the coefficients of the curve are updated, the other values are ignored.
+  for (gtsam::Values::const_iterator it = values.begin(); it != values.end(); ++it) {
+    if (manager_.hasCoefficientWithKey(it->key)) {
+      manager_.updateCoefficientByKey(it->key, values.at<Coefficient>(it->key));
+    }
+  }
 }
 
 void SlerpSE2Curve::setMinSamplingPeriod(Time time) {
@@ -235,11 +251,13 @@ void SlerpSE2Curve::transformCurve(const ValueType T) {
   manager_.getTimes(&coefTimes);
   for (size_t i = 0; i < coefTimes.size(); ++i) {
     // Apply a rigid transformation to every coefficient (on the left side).
-    manager_.insertCoefficient(coefTimes[i],T*evaluate(coefTimes[i]));
+    ValueType value;
+    evaluate(value, coefTimes[i]);
+    manager_.insertCoefficient(coefTimes[i], T * value);
   }
 }
 
-Time SlerpSE2Curve::getTimeAtKey(gtsam::Key key) const {
+Time SlerpSE2Curve::getTimeAtKey(Key key) const {
   return manager_.getCoefficientTimeByKey(key);
 }
 
@@ -252,7 +270,7 @@ void SlerpSE2Curve::saveCurveTimesAndValues(const std::string& filename) const {
   std::vector<Eigen::VectorXd> curveValues;
   ValueType val;
   for (size_t i = 0; i < curveTimes.size(); ++i) {
-    val = evaluate(curveTimes[i]);
+    evaluate(val, curveTimes[i]);
     v << val.x(), val.y(), val.theta();
     curveValues.push_back(v);
   }
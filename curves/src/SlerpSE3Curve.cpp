@@ -7,10 +7,68 @@
  */
 
 #include <curves/SlerpSE3Curve.hpp>
+#include <curves/cubic_hermite_kernels.hpp>
 #include <iostream>
+#include <iterator>
 
 namespace curves {
 
+namespace {
+
+typedef LocalSupport2CoefficientManager<SlerpSE3Curve::Coefficient> SlerpManager;
+
+// Log of T_A_B = T_W_A^-1 * T_W_B on one interval, shared by all the samples within it.
+// The slerp interpolates the rotation on the geodesic and the position linearly.
+struct IntervalLog {
+  SlerpSE3Curve::CoefficientIter a;
+  SlerpSE3Curve::CoefficientIter b;
+  Eigen::Vector3d rotationVector;
+  Eigen::Vector3d translation;
+  double inverseDt;
+  bool valid;
+
+  IntervalLog() : inverseDt(0.0), valid(false) {}
+};
+
+// Points log at the interval containing time, it is only recomputed if time is outside
+// the interval it currently holds. As in getCoefficientsAt, a time on an inner knot
+// belongs to the interval starting at this knot.
+bool updateIntervalLog(const SlerpManager& manager, Time time, IntervalLog* log) {
+  if (log->valid && log->a->first <= time
+      && (time < log->b->first || (time == log->b->first && std::next(log->b) == manager.coefficientEnd()))) {
+    return true;
+  }
+  SlerpSE3Curve::CoefficientIter a, b;
+  if (!manager.getCoefficientsAt(time, &a, &b)) {
+    return false;
+  }
+  const SE3 T_A_B = a->second.coefficient.inverted() * b->second.coefficient;
+  log->a = a;
+  log->b = b;
+  log->rotationVector = hermite_kernels::quaternionLog<double>(T_A_B.getRotation().toImplementation());
+  log->translation = T_A_B.getPosition().toImplementation();
+  log->inverseDt = 1.0 / double(b->first - a->first);
+  log->valid = true;
+  return true;
+}
+
+// T_W_I = T_W_A * (T_W_A^-1 * T_W_B)^alpha
+SE3 interpolate(const IntervalLog& log, Time time) {
+  const double alpha = double(time - log.a->first) * log.inverseDt;
+  const Eigen::Quaterniond rotation = hermite_kernels::quaternionExp<double>(Eigen::Vector3d(alpha * log.rotationVector));
+  return log.a->second.coefficient * SE3(SE3::Position(Eigen::Vector3d(alpha * log.translation)),
+                                         SO3(rotation.w(), rotation.x(), rotation.y(), rotation.z()));
+}
+
+// The velocities are constant on an interval and expressed in the world frame.
+SlerpSE3Curve::DerivativeType intervalDerivative(const IntervalLog& log) {
+  const Eigen::Matrix3d R_W_A = log.a->second.coefficient.getRotation().toImplementation().toRotationMatrix();
+  return SlerpSE3Curve::DerivativeType(Eigen::Vector3d(R_W_A * log.translation * log.inverseDt),
+                                       Eigen::Vector3d(R_W_A * log.rotationVector * log.inverseDt));
+}
+
+} // namespace
+
 SlerpSE3Curve::SlerpSE3Curve() : SE3Curve() {}
 
 SlerpSE3Curve::~SlerpSE3Curve() {}
@@ -30,9 +88,12 @@ void SlerpSE3Curve::print(const std::string& str) const {
       " and " << manager_.getMaxTime() <<std::endl;
   double sum_dp = 0;
   Eigen::Vector3d p1, p2;
-  for(size_t i = 0; i < times.size()-1; ++i) {
-    p1 = evaluate(times[i]).getPosition().vector();
-    p2 = evaluate(times[i+1]).getPosition().vector();
+  ValueType value;
+  for(size_t i = 0; i + 1 < times.size(); ++i) {
+    evaluate(value, times[i]);
+    p1 = value.getPosition().vector();
+    evaluate(value, times[i+1]);
+    p2 = value.getPosition().vector();
     sum_dp += (p1-p2).norm();
   }
   std::cout << "average dt between coefficients: " << (manager_.getMaxTime() -manager_.getMinTime())  / (times.size()-1) << " ns." << std::endl;
@@ -91,47 +152,41 @@ void SlerpSE3Curve::extend(const std::vector<Time>& times,
   slerpPolicy_.extend<SlerpSE3Curve, ValueType>(times, values, this, outKeys);
 }
 
-typename SlerpSE3Curve::DerivativeType
-SlerpSE3Curve::evaluateDerivative(
-    Time /*time*/, unsigned /*derivativeOrder*/) const
+bool SlerpSE3Curve::evaluateDerivative(DerivativeType& derivative, Time time,
+                                       unsigned derivativeOrder) const
 {
-  CHECK(false) << "Not implemented";
-//  // time is out of bound --> error
-//  CHECK_GE(time, this->getMinTime()) << "Time out of bounds";
-//  CHECK_LE(time, this->getMaxTime()) << "Time out of bounds";
-//
-//  Eigen::VectorXd dCoeff;
-//  Time dt;
-//  CoefficientIter rval0, rval1;
-//  bool success = manager_.getCoefficientsAt(time, &rval0, &rval1);
-//  CHECK(success) << "Unable to get the coefficients at time " << time;
-//  // first derivative
-//  if (derivativeOrder == 1) {
-//    //todo Verify this
-//    dCoeff = gtsam::traits<Coefficient>::Local(rval1->second.coefficient,rval0->second.coefficient);
-//    dt = rval1->first - rval0->first;
-//    return dCoeff/dt;
-//    // order of derivative > 1 returns vector of zeros
-//  } else {
-//    // TODO
-//    const int dimension = gtsam::traits<Coefficient>::dimension;
-//    return Eigen::VectorXd::Zero(dimension,1);
-//  }
+  if (derivativeOrder == 0) {
+    std::cerr << "SlerpSE3Curve::evaluateDerivative: derivative order has to be positive!" << std::endl;
+    return false;
+  }
+  // Check if the curve is only defined at this one time
+  if (manager_.getMaxTime() == time && manager_.getMinTime() == time) {
+    derivative.setZero();
+    return true;
+  }
+  IntervalLog log;
+  if (!updateIntervalLog(manager_, time, &log)) {
+    std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+    return false;
+  }
+  // The curve is piecewise linear in the tangent space, derivatives of order >1 are 0.
+  if (derivativeOrder == 1) {
+    derivative = intervalDerivative(log);
+  } else {
+    derivative.setZero();
+  }
+  return true;
 }
 
 /// \brief \f[T^{\alpha}\f]
-SE3 transformationPower(SE3 /*T*/, double /*alpha*/)
+SE3 transformationPower(SE3 T, double alpha)
 {
-  CHECK(false) << "Not implemented";
-//  SO3 R(T.getRotation());
-//  SE3::Position t(T.getPosition());
-//
-//  AngleAxis angleAxis(R);
-//  angleAxis.setUnique();
-//  angleAxis.setAngle(angleAxis.angle() * alpha);
-//  angleAxis.setUnique();
-//
-//  return SE3(SO3(angleAxis),(t*alpha).eval());
+  // Scale the rotation angle and the translation.
+  const Eigen::Vector3d rotationVector =
+      alpha * hermite_kernels::quaternionLog<double>(T.getRotation().toImplementation());
+  const Eigen::Quaterniond rotation = hermite_kernels::quaternionExp<double>(rotationVector);
+  const Eigen::Vector3d translation = alpha * T.getPosition().toImplementation();
+  return SE3(SE3::Position(translation), SO3(rotation.w(), rotation.x(), rotation.y(), rotation.z()));
 }
 
 /// \brief \f[A*B\f]
@@ -141,10 +196,9 @@ SE3 composeTransformations(SE3 A, SE3 B)
 }
 
 /// \brief \f[T^{-1}\f]
-SE3 inverseTransformation(SE3 /*T*/)
+SE3 inverseTransformation(SE3 T)
 {
-  CHECK(false) << "Not implemented";
-//  return T.inverted();
+  return T.inverted();
 }
 
 SE3 invertAndComposeImplementation(SE3 A, SE3 B)
@@ -153,34 +207,74 @@ SE3 invertAndComposeImplementation(SE3 A, SE3 B)
   return result;
 }
 
-SE3 SlerpSE3Curve::evaluate(Time /*time*/) const
+bool SlerpSE3Curve::evaluate(ValueType& value, Time time) const
 {
-  CHECK(false) << "Not implemented";
+  // Check if the curve is only defined at this one time
+  if (manager_.getMaxTime() == time && manager_.getMinTime() == time) {
+    value = manager_.coefficientBegin()->second.coefficient;
+    return true;
+  }
+  IntervalLog log;
+  if (!updateIntervalLog(manager_, time, &log)) {
+    std::cerr << "Unable to get the coefficients at time " << time << std::endl;
+    return false;
+  }
+  value = interpolate(log, time);
+  return true;
+}
 
+bool SlerpSE3Curve::evaluate(const std::vector<Time>& times, std::vector<ValueType>* values) const
+{
+  CHECK_NOTNULL(values);
+  values->resize(times.size());
+  IntervalLog log;
+  for (size_t i = 0; i < times.size(); ++i) {
+    if (manager_.size() == 1 || !updateIntervalLog(manager_, times[i], &log)) {
+      if (!evaluate((*values)[i], times[i])) {
+        return false;
+      }
+      continue;
+    }
+    (*values)[i] = interpolate(log, times[i]);
+  }
+  return true;
+}
+
+CoefficientExpression<SlerpSE3Curve::ValueType> SlerpSE3Curve::getValueExpression(const Time& time) const
+{
   // Check if the curve is only defined at this one time
-//  if (manager_.getMaxTime() == time && manager_.getMinTime() == time) {
-//    return manager_.coefficientBegin()->second.coefficient;
-//  } else {
-//    if (time == manager_.getMaxTime()) {
-//      // Efficient evaluation of a curve end
-//      return (--manager_.coefficientEnd())->second.coefficient;
-//    } else {
-//      CoefficientIter a, b;
-//      bool success = manager_.getCoefficientsAt(time, &a, &b);
-//      CHECK(success) << "Unable to get the coefficients at time " << time;
-//      SE3 T_W_A = a->second.coefficient;
-//      SE3 T_W_B = b->second.coefficient;
-//      double alpha = double(time - a->first)/double(b->first - a->first);
-//
-//      //Implementation of T_W_I = T_W_A*exp(alpha*log(inv(T_W_A)*T_W_B))
-//      using namespace kindr::minimal;
-//      SE3 T_A_B = invertAndComposeImplementation(T_W_A, T_W_B, boost::none, boost::none);
-//      gtsam::Vector6 log_T_A_B = transformationLogImplementation(T_A_B, boost::none);
-//      gtsam::Vector6 log_T_A_I = vectorScalingImplementation<int(6)>(log_T_A_B, alpha, boost::none, boost::none);
-//      SE3 T_A_I = transformationExpImplementation(log_T_A_I, boost::none);
-//      return composeImplementation(T_W_A, T_A_I, boost::none, boost::none);
-//    }
-//  }
+  if (manager_.getMaxTime() == time && manager_.getMinTime() == time) {
+    return CoefficientExpression<ValueType>(manager_.coefficientBegin()->second.key);
+  }
+  CoefficientIter a, b;
+  CHECK(manager_.getCoefficientsAt(time, &a, &b)) << "Unable to get the coefficients at time " << time;
+  std::vector<Key> keys;
+  keys.push_back(a->second.key);
+  keys.push_back(b->second.key);
+  const double alpha = double(time - a->first) / double(b->first - a->first);
+  return CoefficientExpression<ValueType>(keys, [alpha](const std::vector<ValueType>& coefficients) {
+    return composeTransformations(coefficients[0],
+                                  transformationPower(invertAndComposeImplementation(coefficients[0], coefficients[1]),
+                                                      alpha));
+  });
+}
+
+bool SlerpSE3Curve::evaluateDerivative(const std::vector<Time>& times, unsigned derivativeOrder,
+                                       std::vector<DerivativeType>* derivatives) const
+{
+  CHECK_NOTNULL(derivatives);
+  derivatives->resize(times.size());
+  IntervalLog log;
+  for (size_t i = 0; i < times.size(); ++i) {
+    if (derivativeOrder != 1 || manager_.size() == 1 || !updateIntervalLog(manager_, times[i], &log)) {
+      if (!evaluateDerivative((*derivatives)[i], times[i], derivativeOrder)) {
+        return false;
+      }
+      continue;
+    }
+    (*derivatives)[i] = intervalDerivative(log);
+  }
+  return true;
 }
 
 void SlerpSE3Curve::setTimeRange(Time /*minTime*/, Time /*maxTime*/) {
@@ -189,16 +283,16 @@ void SlerpSE3Curve::setTimeRange(Time /*minTime*/, Time /*maxTime*/) {
 }
 
 /// \brief Evaluate the angular velocity of Frame b as seen from Frame a, expressed in Frame a.
-Eigen::Vector3d SlerpSE3Curve::evaluateAngularVelocityA(Time /*time*/) {
-  CHECK(false) << "Not implemented";
+Eigen::Vector3d SlerpSE3Curve::evaluateAngularVelocityA(Time time) {
+  return evaluateTwistA(time).tail<3>();
 }
 /// \brief Evaluate the angular velocity of Frame a as seen from Frame b, expressed in Frame b.
 Eigen::Vector3d SlerpSE3Curve::evaluateAngularVelocityB(Time /*time*/) {
   CHECK(false) << "Not implemented";
 }
 /// \brief Evaluate the velocity of Frame b as seen from Frame a, expressed in Frame a.
-Eigen::Vector3d SlerpSE3Curve::evaluateLinearVelocityA(Time /*time*/) {
-  CHECK(false) << "Not implemented";
+Eigen::Vector3d SlerpSE3Curve::evaluateLinearVelocityA(Time time) {
+  return evaluateTwistA(time).head<3>();
 }
 /// \brief Evaluate the velocity of Frame a as seen from Frame b, expressed in Frame b.
 Eigen::Vector3d SlerpSE3Curve::evaluateLinearVelocityB(Time /*time*/) {
@@ -207,8 +301,10 @@ Eigen::Vector3d SlerpSE3Curve::evaluateLinearVelocityB(Time /*time*/) {
 /// \brief evaluate the velocity/angular velocity of Frame b as seen from Frame a,
 /// expressed in Frame a. The return value has the linear velocity (0,1,2),
 /// and the angular velocity (3,4,5).
-Vector6d SlerpSE3Curve::evaluateTwistA(Time /*time*/) {
-  CHECK(false) << "Not implemented";
+Vector6d SlerpSE3Curve::evaluateTwistA(Time time) {
+  DerivativeType derivative;
+  CHECK(evaluateDerivative(derivative, time, 1)) << "Unable to evaluate the twist at time " << time;
+  return derivative.getVector();
 }
 /// \brief evaluate the velocity/angular velocity of Frame a as seen from Frame b,
 /// expressed in Frame b. The return value has the linear velocity (0,1,2),
@@ -263,7 +359,9 @@ void SlerpSE3Curve::transformCurve(const ValueType T) {
   manager_.getTimes(&coefTimes);
   for (size_t i = 0; i < coefTimes.size(); ++i) {
     // Apply a rigid transformation to every coefficient (on the left side).
-    manager_.insertCoefficient(coefTimes[i],T*evaluate(coefTimes[i]));
+    ValueType value;
+    evaluate(value, coefTimes[i]);
+    manager_.insertCoefficient(coefTimes[i], T * value);
   }
 }
 
@@ -278,9 +376,10 @@ void SlerpSE3Curve::saveCurveAtTimes(const std::string& filename, std::vector<Ti
   Eigen::VectorXd v(7);
 
   std::vector<Eigen::VectorXd> curveValues;
-  ValueType val;
-  for (size_t i = 0; i < times.size(); ++i) {
-    val = evaluate(times[i]);
+  std::vector<ValueType> values;
+  evaluate(times, &values);
+  for (size_t i = 0; i < values.size(); ++i) {
+    const ValueType& val = values[i];
     v << val.getPosition().x(), val.getPosition().y(), val.getPosition().z(),
         val.getRotation().w(), val.getRotation().x(), val.getRotation().y(), val.getRotation().z();
     curveValues.push_back(v);
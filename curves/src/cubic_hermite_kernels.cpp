@@ -0,0 +1,18 @@
+/*
+ * cubic_hermite_kernels.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+// curves
+#include "curves/cubic_hermite_kernels.hpp"
+
+namespace curves {
+namespace hermite_kernels {
+
+CURVES_HERMITE_KERNELS_DECLARE(, float)
+CURVES_HERMITE_KERNELS_DECLARE(, double)
+
+} // namespace hermite_kernels
+} // namespace curves
@@ -5,7 +5,13 @@
  */
 
 #include <curves/helpers.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <stdint.h>
+#include <boost/thread.hpp>
 #include <glog/logging.h>
 
 
@@ -15,6 +21,319 @@ template <typename T>
 std::string toString(const T& t) {
   std::ostringstream ss; ss<<t; return ss.str();
 }
+
+namespace {
+
+const size_t kCsvBufferSize = 1 << 20;
+const size_t kCsvRowsPerChunk = 1 << 14;
+const size_t kMaxFormattedDoubleLength = 32;
+// 17 significant digits identify every double, longer numbers may not fit kMaxFormattedDoubleLength.
+const int kMaxCsvPrecision = 17;
+
+const double kExactPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+bool isCsvSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+/// \brief Fall back to strtod for numbers that are not handled by parseDouble's fast path.
+bool parseDoubleWithStrtod(const char* begin, const char* end, double* out) {
+  const std::string token(begin, end);
+  char* parsedEnd = NULL;
+  *out = strtod(token.c_str(), &parsedEnd);
+  return parsedEnd == token.c_str() + token.size();
+}
+
+/// \brief Parse a decimal number in [begin, end). Mantissas up to 2^53 with a decimal exponent
+///        up to 22 in magnitude are converted with one exactly rounded multiplication or
+///        division, everything else (long mantissas, large exponents, inf, nan) uses strtod.
+bool parseDouble(const char* begin, const char* end, double* out) {
+  while (begin < end && isCsvSpace(*begin)) ++begin;
+  while (end > begin && isCsvSpace(end[-1])) --end;
+  if (begin == end) {
+    return false;
+  }
+  const char* p = begin;
+  const bool negative = (*p == '-');
+  if (*p == '-' || *p == '+') ++p;
+
+  uint64_t mantissa = 0;
+  int significantDigits = 0;
+  int exponent = 0;
+  bool hasDigits = false;
+  for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+    hasDigits = true;
+    if (mantissa != 0 || *p != '0') ++significantDigits;
+    mantissa = mantissa * 10 + (*p - '0');
+  }
+  if (p < end && *p == '.') {
+    for (++p; p < end && *p >= '0' && *p <= '9'; ++p) {
+      hasDigits = true;
+      if (mantissa != 0 || *p != '0') ++significantDigits;
+      mantissa = mantissa * 10 + (*p - '0');
+      --exponent;
+    }
+  }
+  if (hasDigits && p < end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    const bool negativeExponent = (p < end && *p == '-');
+    if (p < end && (*p == '-' || *p == '+')) ++p;
+    int explicitExponent = 0;
+    bool hasExponentDigits = false;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+      hasExponentDigits = true;
+      if (explicitExponent < 10000) explicitExponent = explicitExponent * 10 + (*p - '0');
+    }
+    if (!hasExponentDigits) {
+      return parseDoubleWithStrtod(begin, end, out);
+    }
+    exponent += negativeExponent ? -explicitExponent : explicitExponent;
+  }
+  if (!hasDigits || p != end || significantDigits > 19 ||
+      mantissa > (uint64_t(1) << 53) || exponent < -22 || exponent > 22) {
+    return parseDoubleWithStrtod(begin, end, out);
+  }
+  double value = static_cast<double>(mantissa);
+  value = exponent < 0 ? value / kExactPowersOfTen[-exponent] : value * kExactPowersOfTen[exponent];
+  *out = negative ? -value : value;
+  return true;
+}
+
+/// \brief Format v with the given number of significant digits (at most kMaxCsvPrecision) into
+///        out, which must hold kMaxFormattedDoubleLength characters, and return the length. Integers are written
+///        directly; precision 0 tries 15 digits first and uses 17 only if 15 do not read back exactly.
+size_t formatDouble(double v, int precision, char* out) {
+  // The range check comes first, casting nan, inf or large values to int64_t is undefined.
+  if (std::abs(v) < 1e15 && v == static_cast<double>(static_cast<int64_t>(v)) &&
+      !(v == 0.0 && std::signbit(v))) {
+    int64_t integer = static_cast<int64_t>(v);
+    char digits[20];
+    size_t nDigits = 0;
+    const bool negative = integer < 0;
+    uint64_t magnitude = negative ? uint64_t(-integer) : uint64_t(integer);
+    do {
+      digits[nDigits++] = char('0' + magnitude % 10);
+      magnitude /= 10;
+    } while (magnitude != 0);
+    size_t length = 0;
+    if (negative) out[length++] = '-';
+    while (nDigits > 0) out[length++] = digits[--nDigits];
+    return length;
+  }
+  if (precision > 0) {
+    const int length = snprintf(out, kMaxFormattedDoubleLength, "%.*g", precision, v);
+    CHECK(length >= 0 && length < static_cast<int>(kMaxFormattedDoubleLength)) << "cannot format " << v;
+    return length;
+  }
+  const int length = snprintf(out, kMaxFormattedDoubleLength, "%.15g", v);
+  double readBack;
+  if (parseDouble(out, out + length, &readBack) && readBack == v) {
+    return length;
+  }
+  return snprintf(out, kMaxFormattedDoubleLength, "%.17g", v);
+}
+
+/// \brief Append rows [begin, end) as "time,value0,value1,...\n" to buffer.
+void formatTimeVectorRows(const Time* times, const double* values, size_t dimension, int precision,
+                          size_t begin, size_t end, std::vector<char>* buffer) {
+  buffer->resize((end - begin) * (dimension + 1) * (kMaxFormattedDoubleLength + 1));
+  char* out = buffer->data();
+  for (size_t i = begin; i < end; ++i) {
+    out += formatDouble(times[i], precision, out);
+    const double* row = values + i * dimension;
+    for (size_t j = 0; j < dimension; ++j) {
+      *out++ = ',';
+      out += formatDouble(row[j], precision, out);
+    }
+    *out++ = '\n';
+  }
+  buffer->resize(out - buffer->data());
+}
+
+/// \brief Read a numeric CSV file block-wise and pass every non-empty row to handler(fields, n).
+template <typename RowHandler>
+void parseNumericCSV(const std::string& fileName, RowHandler& handler) {
+  FILE* fp = fopen(fileName.c_str(), "rb");
+  CHECK(fp != NULL) << "error opening input file " << fileName;
+  std::vector<char> buffer(kCsvBufferSize);
+  std::vector<double> row;
+  size_t begin = 0;
+  size_t filled = 0;
+  size_t lineNumber = 0;
+  bool endOfFile = false;
+  while (!endOfFile) {
+    // Move the incomplete last line to the front and refill the buffer behind it.
+    if (begin > 0) {
+      std::memmove(buffer.data(), buffer.data() + begin, filled - begin);
+      filled -= begin;
+      begin = 0;
+    }
+    if (filled == buffer.size()) {
+      buffer.resize(2 * buffer.size());
+    }
+    const size_t read = fread(buffer.data() + filled, 1, buffer.size() - filled, fp);
+    filled += read;
+    endOfFile = (read == 0);
+
+    const char* data = buffer.data();
+    while (begin < filled) {
+      const char* lineBegin = data + begin;
+      const char* lineEnd = static_cast<const char*>(std::memchr(lineBegin, '\n', filled - begin));
+      if (lineEnd == NULL) {
+        if (!endOfFile) {
+          break;
+        }
+        lineEnd = data + filled;
+      }
+      begin = std::min(static_cast<size_t>(lineEnd - data) + 1, filled);
+      ++lineNumber;
+
+      const char* fieldBegin = lineBegin;
+      while (fieldBegin < lineEnd && isCsvSpace(*fieldBegin)) ++fieldBegin;
+      if (fieldBegin == lineEnd) {
+        continue;
+      }
+      row.clear();
+      while (true) {
+        const char* fieldEnd = static_cast<const char*>(std::memchr(fieldBegin, ',', lineEnd - fieldBegin));
+        if (fieldEnd == NULL) {
+          fieldEnd = lineEnd;
+        }
+        double value;
+        CHECK(parseDouble(fieldBegin, fieldEnd, &value)) << "could not parse field " << row.size()
+            << " in line " << lineNumber << " of " << fileName;
+        row.push_back(value);
+        if (fieldEnd == lineEnd) {
+          break;
+        }
+        fieldBegin = fieldEnd + 1;
+      }
+      handler(row.data(), row.size());
+    }
+  }
+  fclose(fp);
+}
+
+/// \brief Appends rows to a row-major array.
+struct NumericRowHandler {
+  explicit NumericRowHandler(std::vector<double>* data) : data_(data), columns_(0) {}
+  void operator()(const double* fields, size_t n) {
+    if (columns_ == 0) {
+      columns_ = n;
+    }
+    CHECK_EQ(columns_, n) << "all rows must have the same number of fields.";
+    data_->insert(data_->end(), fields, fields + n);
+  }
+  std::vector<double>* data_;
+  size_t columns_;
+};
+
+/// \brief Splits rows into numTimes time columns and the vector entries.
+struct TimeVectorRowHandler {
+  TimeVectorRowHandler(std::vector<Time>* times0, std::vector<Time>* times1, std::vector<double>* values)
+      : times0_(times0), times1_(times1), values_(values), columns_(0) {}
+  void operator()(const double* fields, size_t n) {
+    const size_t numTimes = (times1_ == NULL) ? 1 : 2;
+    if (columns_ == 0) {
+      CHECK_GT(n, numTimes) << "CSV does not have the expected number of fields (atleast "
+          << numTimes << " time(s) and 1 value).";
+      columns_ = n;
+    }
+    CHECK_EQ(columns_, n) << "all rows must have the same number of fields.";
+    times0_->push_back(fields[0]);
+    if (times1_ != NULL) {
+      times1_->push_back(fields[1]);
+    }
+    values_->insert(values_->end(), fields + numTimes, fields + n);
+  }
+  std::vector<Time>* times0_;
+  std::vector<Time>* times1_;
+  std::vector<double>* values_;
+  size_t columns_;
+};
+
+} // namespace
+
+void writeTimeVectorCSV(FILE* file, const curves::Time* times, const double* values,
+                        size_t numRows, size_t dimension, int precision, unsigned numThreads) {
+  CHECK(file != NULL);
+  CHECK(numRows == 0 || (times != NULL && (values != NULL || dimension == 0)));
+  CHECK(precision >= 0 && precision <= kMaxCsvPrecision) << "precision " << precision << " is not in [0, 17]";
+  if (numThreads == 0) {
+    numThreads = std::max(1u, boost::thread::hardware_concurrency());
+  }
+  std::vector<std::vector<char> > buffers(numThreads);
+  for (size_t batchBegin = 0; batchBegin < numRows; batchBegin += numThreads * kCsvRowsPerChunk) {
+    // Format one chunk per thread, then write the chunks in order.
+    const size_t nChunks = std::min<size_t>(numThreads, (numRows - batchBegin + kCsvRowsPerChunk - 1) / kCsvRowsPerChunk);
+    boost::thread_group workers;
+    for (size_t c = 0; c < nChunks; ++c) {
+      const size_t begin = batchBegin + c * kCsvRowsPerChunk;
+      const size_t end = std::min(numRows, begin + kCsvRowsPerChunk);
+      if (c + 1 == nChunks) {
+        formatTimeVectorRows(times, values, dimension, precision, begin, end, &buffers[c]);
+      } else {
+        std::vector<char>* buffer = &buffers[c];
+        workers.create_thread([=]() {
+          formatTimeVectorRows(times, values, dimension, precision, begin, end, buffer);
+        });
+      }
+    }
+    workers.join_all();
+    for (size_t c = 0; c < nChunks; ++c) {
+      CHECK_EQ(buffers[c].size(), fwrite(buffers[c].data(), 1, buffers[c].size(), file))
+          << "error writing CSV output";
+    }
+  }
+}
+
+void writeTimeVectorCSV(const std::string& fileName, const curves::Time* times, const double* values,
+                        size_t numRows, size_t dimension, int precision, unsigned numThreads) {
+  FILE* fp = fopen(fileName.c_str(), "wb");
+  CHECK(fp != NULL) << "error opening output file " << fileName;
+  writeTimeVectorCSV(fp, times, values, numRows, dimension, precision, numThreads);
+  CHECK_EQ(0, fclose(fp)) << "error writing output file " << fileName;
+}
+
+size_t loadNumericCSV(const std::string& fileName, std::vector<double>* outData) {
+  CHECK_NOTNULL(outData);
+  outData->clear();
+  NumericRowHandler handler(outData);
+  parseNumericCSV(fileName, handler);
+  return handler.columns_;
+}
+
+void loadTimeVectorCSV(const std::string& fileName, std::vector<curves::Time>* outTimes,
+                       std::vector<double>* outValues, size_t* outDimension) {
+  CHECK_NOTNULL(outTimes);
+  outTimes->clear();
+  CHECK_NOTNULL(outValues);
+  outValues->clear();
+  CHECK_NOTNULL(outDimension);
+  TimeVectorRowHandler handler(outTimes, NULL, outValues);
+  parseNumericCSV(fileName, handler);
+  CHECK_GE(outTimes->size(), 1) << "CSV " << fileName << "was empty.";
+  *outDimension = handler.columns_ - 1;
+}
+
+void loadTimeTimeVectorCSV(const std::string& fileName, std::vector<curves::Time>* outTimes0,
+                           std::vector<curves::Time>* outTimes1, std::vector<double>* outValues,
+                           size_t* outDimension) {
+  CHECK_NOTNULL(outTimes0);
+  outTimes0->clear();
+  CHECK_NOTNULL(outTimes1);
+  outTimes1->clear();
+  CHECK_NOTNULL(outValues);
+  outValues->clear();
+  CHECK_NOTNULL(outDimension);
+  TimeVectorRowHandler handler(outTimes0, outTimes1, outValues);
+  parseNumericCSV(fileName, handler);
+  CHECK_GE(outTimes0->size(), 1) << "CSV " << fileName << "was empty.";
+  *outDimension = handler.columns_ - 2;
+}
+
 /// \brief Helper function to read CSV files into 'matrix' of strings
 std::vector<std::vector<std::string> > loadCSV(std::string fileName) {
   // Open file stream and check that it is error free
@@ -51,31 +370,20 @@ void writeCSV(std::string fileName, const std::vector<std::vector<std::string> >
     for (unsigned i = 1; i < fields; i++) {
       outFileStream << "," << itRow->at(i);
     }
-    outFileStream << std::endl;
+    outFileStream << '\n';
   }
   outFileStream.close();
 }
 /// \brief Helper function to read CSV files formatted in: time, vectorEntry0, vectorEntry1, ...
 void loadTimeVectorCSV(std::string fileName, std::vector<curves::Time>* outTimes, std::vector<Eigen::VectorXd>* outValues) {
-  // Initialize outputs
-  CHECK_NOTNULL(outTimes);
-  outTimes->clear();
   CHECK_NOTNULL(outValues);
   outValues->clear();
-  // Load CSV to matrix of strings
-  std::vector<std::vector<std::string> > temp = loadCSV(fileName);
-  CHECK_GE(temp.size(), 1) << "CSV " << fileName << "was empty.";
-  CHECK_GE(temp.at(0).size(), 2) << "CSV does not have the expected number of fields (atleast time and 1 value).";
-  // Iterate over the rows of the CSV and use comma-separated fields to popular outputs
-  const unsigned vOffset = 1;
-  const unsigned vDim = temp.at(0).size() - vOffset;
-  Eigen::VectorXd tempVec(vDim);
-  for (std::vector<std::vector<std::string> >::iterator it = temp.begin() ; it != temp.end(); ++it) {
-    outTimes->push_back((curves::Time)atof(it->at(1).c_str()));
-    for (unsigned vIdx = 0; vIdx < vDim; vIdx++) {
-      tempVec[vIdx] = atof(it->at(vIdx + vOffset).c_str());
-    }
-    outValues->push_back(tempVec);
+  std::vector<double> values;
+  size_t vDim;
+  loadTimeVectorCSV(fileName, outTimes, &values, &vDim);
+  outValues->reserve(outTimes->size());
+  for (size_t i = 0; i < outTimes->size(); ++i) {
+    outValues->push_back(Eigen::Map<const Eigen::VectorXd>(values.data() + i * vDim, vDim));
   }
 }
 /// \brief Helper function to write CSV file formatted in: time, vectorEntry0, vectorEntry1, ...
@@ -83,49 +391,26 @@ void writeTimeVectorCSV(std::string fileName, const std::vector<curves::Time>& t
   // Check inputs and initialize sizes
   CHECK_EQ(times.size(), values.size()) << "Length of times and values is not equal.";
   CHECK_GE(times.size(), 1) << "No entries to write";
-  const unsigned vOffset = 1;
   const unsigned vDim = values.at(0).rows();
-  // Fill string matrix
-  std::vector<std::vector<std::string> > strMatrix;
-  strMatrix.reserve(times.size());
-  std::vector<std::string> strRow;
-  strRow.reserve(vOffset + vDim);
+  // Pack the vectors contiguously
+  std::vector<double> data(times.size() * vDim);
   for (unsigned i = 0; i < times.size(); i++) {
     CHECK_EQ(vDim, values.at(i).rows()) << "all vectors must be of the same dimension.";
-    strRow.clear();
-    strRow.push_back(toString<Time>(times[i]));
-    for (unsigned v = 0; v < vDim; v++) {
-      strRow.push_back(toString<double>(values[i][v]));
-    };
-    strMatrix.push_back(strRow);
+    Eigen::Map<Eigen::VectorXd>(data.data() + i * vDim, vDim) = values[i];
   }
   // Write
-  writeCSV(fileName, strMatrix);
+  writeTimeVectorCSV(fileName, times.data(), data.data(), times.size(), vDim);
 }
 /// \brief Helper function to read CSV files formatted in: time0, time1, vectorEntry0, vectorEntry1, ...
 void loadTimeTimeVectorCSV(std::string fileName, std::vector<curves::Time>* outTimes0, std::vector<curves::Time>* outTimes1, std::vector<Eigen::VectorXd>* outValues) {
-  // Initialize outputs
-  CHECK_NOTNULL(outTimes0);
-  outTimes0->clear();
-  CHECK_NOTNULL(outTimes1);
-  outTimes1->clear();
   CHECK_NOTNULL(outValues);
   outValues->clear();
-  // Load CSV to matrix of strings
-  std::vector<std::vector<std::string> > temp = loadCSV(fileName);
-  CHECK_GE(temp.size(), 1) << "CSV " << fileName << "was empty.";
-  CHECK_GE(temp.at(0).size(), 3) << "CSV does not have the expected number of fields (atleast 2 times and 1 value).";
-  // Iterate over the rows of the CSV and use comma-separated fields to popular outputs
-  const unsigned vOffset = 2;
-  const unsigned vDim = temp.at(0).size() - vOffset;
-  Eigen::VectorXd tempVec(vDim);
-  for (std::vector<std::vector<std::string> >::iterator it = temp.begin() ; it != temp.end(); ++it) {
-    outTimes0->push_back((curves::Time)atof(it->at(1).c_str()));
-    outTimes1->push_back((curves::Time)atof(it->at(2).c_str()));
-    for (unsigned vIdx = 0; vIdx < vDim; vIdx++) {
-      tempVec[vIdx] = atof(it->at(vIdx + vOffset).c_str());
-    }
-    outValues->push_back(tempVec);
+  std::vector<double> values;
+  size_t vDim;
+  loadTimeTimeVectorCSV(fileName, outTimes0, outTimes1, &values, &vDim);
+  outValues->reserve(outTimes0->size());
+  for (size_t i = 0; i < outTimes0->size(); ++i) {
+    outValues->push_back(Eigen::Map<const Eigen::VectorXd>(values.data() + i * vDim, vDim));
   }
 }
 
@@ -14,15 +14,17 @@ namespace spline_traits {
 template<typename Core_, int SplineOrder_>
 constexpr unsigned int spline_rep<Core_, SplineOrder_>::numCoefficients;
 
-using spline3 = spline_rep<double, 3>;
-constexpr std::array<double, spline3::numCoefficients> spline3::tauZero;
-constexpr std::array<double, spline3::numCoefficients> spline3::dtauZero;
-constexpr std::array<double, spline3::numCoefficients> spline3::ddtauZero;
-
-using spline5 = spline_rep<double, 5>;
-constexpr std::array<double, spline5::numCoefficients> spline5::tauZero;
-constexpr std::array<double, spline5::numCoefficients> spline5::dtauZero;
-constexpr std::array<double, spline5::numCoefficients> spline5::ddtauZero;
+template struct spline_rep<float, 1>;
+template struct spline_rep<float, 2>;
+template struct spline_rep<float, 3>;
+template struct spline_rep<float, 4>;
+template struct spline_rep<float, 5>;
+template struct spline_rep<double, 1>;
+template struct spline_rep<double, 2>;
+template struct spline_rep<double, 3>;
+template struct spline_rep<double, 4>;
+template struct spline_rep<double, 5>;
+template struct spline_rep<double, 7>;
 
 }
 }
@@ -0,0 +1,206 @@
+/*
+ * ConcurrentCubicHermiteSE3CurveTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+#include <boost/thread.hpp>
+
+#include "curves/ConcurrentCubicHermiteSE3Curve.hpp"
+#include "curves/CubicHermiteSE3Curve.hpp"
+
+using namespace curves;
+
+typedef ConcurrentCubicHermiteSE3Curve::ValueType ValueType;
+typedef ConcurrentCubicHermiteSE3Curve::DerivativeType DerivativeType;
+
+namespace {
+
+void makeTrajectory(size_t nKnots, std::vector<Time>* times, std::vector<ValueType>* values) {
+  for (size_t i = 0; i < nKnots; ++i) {
+    const double t = 0.01 * i;
+    times->push_back(t);
+    values->push_back(ValueType(ValueType::Position(std::sin(t), std::cos(2.0 * t), t),
+                                ValueType::Rotation(kindr::EulerAnglesZyxD(0.5 * t, 0.1 * std::sin(t), 0.2))));
+  }
+}
+
+} // namespace
+
+TEST(ConcurrentCubicHermiteSE3Curve, MatchesFittedCurve)
+{
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  makeTrajectory(600, &times, &values);
+
+  CubicHermiteSE3Curve reference;
+  reference.fitCurve(times, values);
+
+  ConcurrentCubicHermiteSE3Curve curve;
+  for (size_t i = 0; i < times.size(); i += 7) {
+    const size_t end = std::min(times.size(), i + 7);
+    curve.extend(std::vector<Time>(times.begin() + i, times.begin() + end),
+                 std::vector<ValueType>(values.begin() + i, values.begin() + end));
+    // The last appended knot stays pending.
+    ASSERT_EQ(end - 1, static_cast<size_t>(curve.size()));
+  }
+  curve.finalize();
+  ASSERT_EQ(times.size(), static_cast<size_t>(curve.size()));
+  EXPECT_EQ(reference.getMinTime(), curve.getMinTime());
+  EXPECT_EQ(reference.getMaxTime(), curve.getMaxTime());
+
+  for (Time t = times.front(); t <= times.back(); t += 0.0037) {
+    ValueType expected, value;
+    DerivativeType expectedDerivative, derivative;
+    ASSERT_TRUE(reference.evaluate(expected, t));
+    ASSERT_TRUE(curve.evaluate(value, t));
+    ASSERT_TRUE(reference.evaluateDerivative(expectedDerivative, t, 1));
+    ASSERT_TRUE(curve.evaluateDerivative(derivative, t, 1));
+    EXPECT_EQ(expected.getPosition().vector(), value.getPosition().vector());
+    EXPECT_EQ(expected.getRotation().vector(), value.getRotation().vector());
+    EXPECT_EQ(expectedDerivative.getVector(), derivative.getVector());
+  }
+}
+
+TEST(ConcurrentCubicHermiteSE3Curve, OneWriterManyReaders)
+{
+  const size_t nKnots = 70000;  // spans more than one chunk table
+  const size_t nReaders = 6;
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  makeTrajectory(nKnots, &times, &values);
+
+  // Filled up front, MatchesFittedCurve checks it against CubicHermiteSE3Curve.
+  ConcurrentCubicHermiteSE3Curve reference;
+  reference.extend(times, values);
+  reference.finalize();
+
+  ConcurrentCubicHermiteSE3Curve curve;
+  std::atomic<bool> done(false);
+  std::vector<size_t> evaluations(nReaders, 0);
+  std::vector<size_t> failures(nReaders, 0);
+
+  boost::thread_group readers;
+  for (size_t r = 0; r < nReaders; ++r) {
+    readers.create_thread([&, r]() {
+      unsigned int seed = 17 + r;
+      do {
+        boost::this_thread::yield();
+        if (curve.size() < 2) {
+          continue;
+        }
+        const Time minTime = curve.getMinTime();
+        const Time maxTime = curve.getMaxTime();
+        seed = seed * 1103515245u + 12345u;
+        // Bias half of the queries towards the most recently published interval.
+        const double u = double(seed >> 8) / double(1u << 24);
+        const Time t = (r % 2 == 0) ? minTime + u * (maxTime - minTime) : std::max(minTime, maxTime - u * 0.05);
+        ValueType value, expected;
+        DerivativeType derivative, expectedDerivative;
+        if (!curve.evaluate(value, t) || !curve.evaluateDerivative(derivative, t, 1)) {
+          ++failures[r];
+          continue;
+        }
+        reference.evaluate(expected, t);
+        reference.evaluateDerivative(expectedDerivative, t, 1);
+        if (value.getPosition().vector() != expected.getPosition().vector() ||
+            value.getRotation().vector() != expected.getRotation().vector() ||
+            derivative.getVector() != expectedDerivative.getVector()) {
+          ++failures[r];
+        }
+        ++evaluations[r];
+      } while (!done.load());
+    });
+  }
+
+  for (size_t i = 0; i < nKnots; i += 3) {
+    const size_t end = std::min(nKnots, i + 3);
+    curve.extend(std::vector<Time>(times.begin() + i, times.begin() + end),
+                 std::vector<ValueType>(values.begin() + i, values.begin() + end));
+  }
+  curve.finalize();
+  done.store(true);
+  readers.join_all();
+
+  EXPECT_EQ(nKnots, static_cast<size_t>(curve.size()));
+  for (size_t r = 0; r < nReaders; ++r) {
+    EXPECT_EQ(0u, failures[r]) << "reader " << r;
+    EXPECT_LT(0u, evaluations[r]) << "reader " << r;
+  }
+}
+
+TEST(ConcurrentCubicHermiteSE3Curve, Snapshot)
+{
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  makeTrajectory(1000, &times, &values);
+
+  ConcurrentCubicHermiteSE3Curve::SnapshotPtr snapshot;
+  ConcurrentCubicHermiteSE3Curve::SnapshotPtr emptySnapshot;
+  {
+    ConcurrentCubicHermiteSE3Curve curve;
+    emptySnapshot = curve.snapshot();
+    curve.extend(std::vector<Time>(times.begin(), times.begin() + 500),
+                 std::vector<ValueType>(values.begin(), values.begin() + 500));
+    snapshot = curve.snapshot();
+    // The pending knot is not part of the snapshot.
+    ASSERT_EQ(499, snapshot->size());
+    EXPECT_EQ(times[498], snapshot->getMaxTime());
+
+    curve.extend(std::vector<Time>(times.begin() + 500, times.end()),
+                 std::vector<ValueType>(values.begin() + 500, values.end()));
+    curve.finalize();
+    EXPECT_EQ(499, snapshot->size());
+    EXPECT_EQ(times[498], snapshot->getMaxTime());
+
+    for (Time t = snapshot->getMinTime(); t <= snapshot->getMaxTime(); t += 0.0123) {
+      ValueType expected, value;
+      ASSERT_TRUE(curve.evaluate(expected, t));
+      ASSERT_TRUE(snapshot->evaluate(value, t));
+      EXPECT_EQ(expected.getPosition().vector(), value.getPosition().vector());
+      EXPECT_EQ(expected.getRotation().vector(), value.getRotation().vector());
+    }
+  }
+
+  // The snapshot keeps the shared knots alive after the curve is gone.
+  ValueType value;
+  DerivativeType derivative;
+  EXPECT_TRUE(snapshot->evaluate(value, times[200]));
+  EXPECT_TRUE(snapshot->evaluateDerivative(derivative, times[200], 1));
+  EXPECT_NEAR(values[200].getPosition().x(), value.getPosition().x(), 1e-12);
+  EXPECT_FALSE(snapshot->evaluate(value, times[600]));
+  EXPECT_TRUE(emptySnapshot->isEmpty());
+}
+
+TEST(ConcurrentCubicHermiteSE3Curve, Capacity)
+{
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  makeTrajectory(10, &times, &values);
+
+  EXPECT_EQ(ConcurrentCubicHermiteSE3Curve::KnotStorage::kMaxCapacity,
+            ConcurrentCubicHermiteSE3Curve().capacity());
+
+  ConcurrentCubicHermiteSE3Curve curve(4);
+  ASSERT_EQ(4u, curve.capacity());
+  // Five knots publish four and keep the fifth pending.
+  EXPECT_TRUE(curve.extend(std::vector<Time>(times.begin(), times.begin() + 5),
+                           std::vector<ValueType>(values.begin(), values.begin() + 5)));
+  EXPECT_EQ(4, curve.size());
+  // A full curve rejects further knots and keeps the published ones.
+  EXPECT_FALSE(curve.extend(std::vector<Time>(times.begin() + 5, times.end()),
+                            std::vector<ValueType>(values.begin() + 5, values.end())));
+  EXPECT_FALSE(curve.finalize());
+  EXPECT_EQ(4, curve.size());
+  EXPECT_EQ(times[3], curve.getMaxTime());
+  ValueType value;
+  EXPECT_TRUE(curve.evaluate(value, 0.5 * (times[2] + times[3])));
+}
@@ -0,0 +1,86 @@
+/*
+ * CubicHermiteE3CurveTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "curves/CubicHermiteE3Curve.hpp"
+
+using namespace curves;
+
+typedef CubicHermiteE3Curve::ValueType ValueType;
+typedef CubicHermiteE3Curve::Coefficient Coefficient;
+
+namespace {
+
+void makeValues(size_t n, std::vector<Time>* times, std::vector<ValueType>* values) {
+  for (size_t i = 0; i < n; ++i) {
+    const double t = 0.1 * i + 0.01 * (i % 3);
+    times->push_back(t);
+    values->push_back(ValueType(std::sin(t), std::cos(t), t));
+  }
+}
+
+} // namespace
+
+TEST(CubicHermiteE3Curve, ExtendMatchesFit)
+{
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  makeValues(40, &times, &values);
+  CubicHermiteE3Curve fitted;
+  fitted.fitCurve(times, values);
+
+  // Append one value and then the rest in chunks.
+  CubicHermiteE3Curve extended;
+  std::vector<Key> keys;
+  extended.extend(std::vector<Time>(1, times[0]), std::vector<ValueType>(1, values[0]), &keys);
+  for (size_t begin = 1; begin < times.size(); begin += 5) {
+    const size_t end = std::min(times.size(), begin + 5);
+    extended.extend(std::vector<Time>(times.begin() + begin, times.begin() + end),
+                    std::vector<ValueType>(values.begin() + begin, values.begin() + end), &keys);
+  }
+  EXPECT_EQ(times.size(), keys.size());
+
+  std::vector<Time> fittedTimes, extendedTimes;
+  std::vector<Coefficient> fittedKnots, extendedKnots;
+  fitted.getKnots(&fittedTimes, &fittedKnots);
+  extended.getKnots(&extendedTimes, &extendedKnots);
+  ASSERT_EQ(fittedTimes, extendedTimes);
+  for (size_t i = 0; i < fittedKnots.size(); ++i) {
+    EXPECT_EQ(fittedKnots[i].getPosition(), extendedKnots[i].getPosition());
+    EXPECT_TRUE(fittedKnots[i].getVelocity().isApprox(extendedKnots[i].getVelocity(), 1e-12)) << i;
+  }
+
+  // Refitting replaces the knots.
+  fitted.fitCurve(std::vector<Time>(times.begin(), times.begin() + 3),
+                  std::vector<ValueType>(values.begin(), values.begin() + 3));
+  EXPECT_EQ(3, fitted.size());
+}
+
+TEST(CubicHermiteE3Curve, ExtendTruncates)
+{
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  makeValues(100, &times, &values);
+  CubicHermiteE3Curve curve;
+  curve.setMaxNumberOfCoefficients(10);
+  for (size_t i = 0; i < times.size(); ++i) {
+    curve.extend(std::vector<Time>(1, times[i]), std::vector<ValueType>(1, values[i]));
+    EXPECT_EQ(std::min<int>(i + 1, 10), curve.size());
+    EXPECT_EQ(times[i], curve.getMaxTime());
+  }
+  EXPECT_EQ(times[90], curve.getMinTime());
+
+  ValueType value;
+  ASSERT_TRUE(curve.evaluate(value, times[99]));
+  EXPECT_EQ(values[99], value);
+  EXPECT_FALSE(curve.evaluate(value, times[89]));
+}
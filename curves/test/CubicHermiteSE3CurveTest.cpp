@@ -9,6 +9,7 @@
 #include <gtest/gtest.h>
 
 #include "curves/CubicHermiteSE3Curve.hpp"
+#include "curves/cubic_hermite_kernels.hpp"
 #include <kindr/Core>
 #include <kindr/common/gtest_eigen.hpp>
 #include <limits>
@@ -373,3 +374,164 @@ TEST(GetTime, Simple)
   EXPECT_EQ(times[0], curve.getMinTime());
   EXPECT_EQ(times[2], curve.getMaxTime());
 }
+
+TEST(Evaluate, FloatKernels)
+{
+  const Eigen::Vector3d positionA(0.1, -0.4, 1.2), positionB(0.8, 0.3, 1.0);
+  const Eigen::Vector3d velocityA(0.2, 0.1, -0.3), velocityB(-0.1, 0.4, 0.2);
+  const Eigen::Quaterniond rotationA(Eigen::AngleAxisd(0.3, Eigen::Vector3d(1.0, 2.0, 3.0).normalized()));
+  const Eigen::Quaterniond rotationB(Eigen::AngleAxisd(-0.8, Eigen::Vector3d(-1.0, 0.5, 0.2).normalized()));
+  const Eigen::Vector3d angularVelocityA(0.3, -0.2, 0.5), angularVelocityB(-0.4, 0.1, 0.2);
+  const double dt = 0.7;
+
+  for (double alpha = 0.0; alpha <= 1.0; alpha += 0.125) {
+    const Eigen::Vector3d position = hermite_kernels::evaluatePosition<double>(
+        positionA, velocityA, positionB, velocityB, dt, alpha);
+    const Eigen::Vector3f positionFloat = hermite_kernels::evaluatePosition<float>(
+        positionA.cast<float>(), velocityA.cast<float>(), positionB.cast<float>(), velocityB.cast<float>(),
+        static_cast<float>(dt), static_cast<float>(alpha));
+    KINDR_ASSERT_DOUBLE_MX_EQ(position, positionFloat.cast<double>(), 1e-3, "position");
+
+    const Eigen::Quaterniond rotation = hermite_kernels::evaluateRotation<double>(
+        rotationA, angularVelocityA, rotationB, angularVelocityB, dt, alpha);
+    const Eigen::Quaternionf rotationFloat = hermite_kernels::evaluateRotation<float>(
+        rotationA.cast<float>(), angularVelocityA.cast<float>(), rotationB.cast<float>(), angularVelocityB.cast<float>(),
+        static_cast<float>(dt), static_cast<float>(alpha));
+    EXPECT_NEAR(0.0, rotation.angularDistance(rotationFloat.cast<double>()), 1e-3);
+  }
+}
+
+namespace {
+
+typedef Eigen::Matrix<double, 13, 1> CoefficientVector;
+
+void evaluateFromVectors(const CoefficientVector& a, const CoefficientVector& b, double dt, double alpha,
+                         Eigen::Vector3d* position, Eigen::Quaterniond* rotation) {
+  const Eigen::Quaterniond rotationA = Eigen::Quaterniond(a(3), a(4), a(5), a(6)).normalized();
+  const Eigen::Quaterniond rotationB = Eigen::Quaterniond(b(3), b(4), b(5), b(6)).normalized();
+  *position = hermite_kernels::evaluatePosition<double>(a.segment<3>(0), a.segment<3>(7),
+                                                        b.segment<3>(0), b.segment<3>(7), dt, alpha);
+  *rotation = hermite_kernels::evaluateRotation<double>(rotationA, a.segment<3>(10),
+                                                        rotationB, b.segment<3>(10), dt, alpha);
+}
+
+Eigen::Matrix<double, 6, 13> numericalJacobian(const CoefficientVector& a, const CoefficientVector& b,
+                                               double dt, double alpha, bool withRespectToA) {
+  const double h = 1e-7;
+  Eigen::Matrix<double, 6, 13> jacobian;
+  Eigen::Vector3d position, positionPlus, positionMinus;
+  Eigen::Quaterniond rotation, rotationPlus, rotationMinus;
+  for (int i = 0; i < 13; ++i) {
+    CoefficientVector aPlus = a, aMinus = a, bPlus = b, bMinus = b;
+    if (withRespectToA) {
+      aPlus(i) += h;
+      aMinus(i) -= h;
+    } else {
+      bPlus(i) += h;
+      bMinus(i) -= h;
+    }
+    evaluateFromVectors(aPlus, bPlus, dt, alpha, &positionPlus, &rotationPlus);
+    evaluateFromVectors(aMinus, bMinus, dt, alpha, &positionMinus, &rotationMinus);
+    jacobian.block<3, 1>(0, i) = (positionPlus - positionMinus) / (2.0 * h);
+    jacobian.block<3, 1>(3, i) = hermite_kernels::quaternionLog<double>(rotationPlus * rotationMinus.conjugate()) / (2.0 * h);
+  }
+  return jacobian;
+}
+
+} // namespace
+
+TEST(Evaluate, CoefficientJacobians)
+{
+  CoefficientVector a, b;
+  const Eigen::Quaterniond rotationA(Eigen::AngleAxisd(0.7, Eigen::Vector3d(1.0, -2.0, 0.5).normalized()));
+  const Eigen::Quaterniond rotationB(Eigen::AngleAxisd(-1.1, Eigen::Vector3d(0.3, 0.4, -1.0).normalized()));
+  a << 0.1, -0.4, 1.2, rotationA.w(), rotationA.x(), rotationA.y(), rotationA.z(), 0.2, 0.1, -0.3, 0.5, -0.2, 0.8;
+  b << 0.8, 0.3, 1.0, rotationB.w(), rotationB.x(), rotationB.y(), rotationB.z(), -0.1, 0.4, 0.2, -0.6, 0.3, 0.4;
+  const double dt = 0.9;
+
+  for (double alpha = 0.0; alpha <= 1.0; alpha += 0.2) {
+    Eigen::Vector3d position;
+    Eigen::Quaterniond rotation;
+    Eigen::Matrix<double, 6, 13> jacobianA, jacobianB;
+    hermite_kernels::evaluatePoseWithJacobians<double>(
+        a.segment<3>(0), rotationA, a.segment<3>(7), a.segment<3>(10),
+        b.segment<3>(0), rotationB, b.segment<3>(7), b.segment<3>(10),
+        dt, alpha, &position, &rotation, &jacobianA, &jacobianB);
+
+    Eigen::Vector3d expectedPosition;
+    Eigen::Quaterniond expectedRotation;
+    evaluateFromVectors(a, b, dt, alpha, &expectedPosition, &expectedRotation);
+    KINDR_ASSERT_DOUBLE_MX_EQ(expectedPosition, position, 1e-10, "position");
+    EXPECT_NEAR(0.0, expectedRotation.angularDistance(rotation), 1e-10);
+
+    KINDR_ASSERT_DOUBLE_MX_EQ(numericalJacobian(a, b, dt, alpha, true), jacobianA, 1e-5, "jacobianA");
+    KINDR_ASSERT_DOUBLE_MX_EQ(numericalJacobian(a, b, dt, alpha, false), jacobianB, 1e-5, "jacobianB");
+  }
+}
+
+TEST(Evaluate, CurveCoefficientJacobians)
+{
+  CubicHermiteSE3Curve curve;
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  for (int i = 0; i < 4; ++i) {
+    times.push_back(0.5 * i);
+    values.push_back(ValueType(ValueType::Position(0.3 * i, -0.2 * i * i, 1.0),
+                               ValueType::Rotation(kindr::EulerAnglesZyxD(0.4 * i, -0.1 * i, 0.2 * i * i))));
+  }
+  std::vector<Key> keys;
+  curve.fitCurve(times, values, &keys);
+
+  ValueType value, expectedValue;
+  CubicHermiteSE3Curve::CoefficientJacobian jacobianA, jacobianB;
+  Key keyA, keyB;
+  ASSERT_TRUE(curve.evaluate(value, 0.7, &jacobianA, &jacobianB, &keyA, &keyB));
+  ASSERT_TRUE(curve.evaluate(expectedValue, 0.7));
+  EXPECT_EQ(keys[1], keyA);
+  EXPECT_EQ(keys[2], keyB);
+  KINDR_ASSERT_DOUBLE_MX_EQ(expectedValue.getPosition().vector(), value.getPosition().vector(), 1e-12, "position");
+  EXPECT_NEAR(0.0, expectedValue.getRotation().getDisparityAngle(value.getRotation()), 1e-12);
+  // Position rows only depend on the position and linear velocity of the coefficients.
+  const double positionRotationCoupling = jacobianA.block<3, 4>(0, 3).norm() + jacobianA.block<3, 3>(0, 10).norm();
+  EXPECT_NEAR(0.0, positionRotationCoupling, 1e-12);
+  const double positionWeightSum = (jacobianA.block<3, 3>(0, 0) + jacobianB.block<3, 3>(0, 0)).trace() / 3.0;
+  EXPECT_NEAR(1.0, positionWeightSum, 1e-12);
+}
+
+TEST(Evaluate, ValueExpression)
+{
+  CubicHermiteSE3Curve curve;
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  for (int i = 0; i < 4; ++i) {
+    times.push_back(0.5 * i);
+    values.push_back(ValueType(ValueType::Position(0.3 * i, -0.2 * i * i, 1.0),
+                               ValueType::Rotation(kindr::EulerAnglesZyxD(0.4 * i, -0.1 * i, 0.2 * i * i))));
+  }
+  std::vector<Key> keys;
+  curve.fitCurve(times, values, &keys);
+
+  const CoefficientExpression<ValueType, CubicHermiteSE3Curve::Coefficient> expression = curve.getValueExpression(0.7);
+  ASSERT_EQ(2u, expression.keys().size());
+  EXPECT_EQ(keys[1], expression.keys()[0]);
+  EXPECT_EQ(keys[2], expression.keys()[1]);
+
+  // The expression evaluates the interval for any coefficients with these keys.
+  CoefficientVector a, b;
+  const Eigen::Quaterniond rotationA(Eigen::AngleAxisd(0.7, Eigen::Vector3d(1.0, -2.0, 0.5).normalized()));
+  const Eigen::Quaterniond rotationB(Eigen::AngleAxisd(-1.1, Eigen::Vector3d(0.3, 0.4, -1.0).normalized()));
+  a << 0.1, -0.4, 1.2, rotationA.w(), rotationA.x(), rotationA.y(), rotationA.z(), 0.2, 0.1, -0.3, 0.5, -0.2, 0.8;
+  b << 0.8, 0.3, 1.0, rotationB.w(), rotationB.x(), rotationB.y(), rotationB.z(), -0.1, 0.4, 0.2, -0.6, 0.3, 0.4;
+  CoefficientExpression<ValueType, CubicHermiteSE3Curve::Coefficient>::CoefficientMap coefficients;
+  Eigen::Map<CoefficientVector>(coefficients[keys[1]].data()) = a;
+  Eigen::Map<CoefficientVector>(coefficients[keys[2]].data()) = b;
+
+  Eigen::Vector3d expectedPosition;
+  Eigen::Quaterniond expectedRotation;
+  evaluateFromVectors(a, b, 0.5, 0.4, &expectedPosition, &expectedRotation);
+  const ValueType value = expression.value(coefficients);
+  KINDR_ASSERT_DOUBLE_MX_EQ(expectedPosition, value.getPosition().vector(), 1e-12, "position");
+  const Eigen::Quaterniond rotation(value.getRotation().w(), value.getRotation().x(),
+                                    value.getRotation().y(), value.getRotation().z());
+  EXPECT_NEAR(0.0, expectedRotation.angularDistance(rotation), 1e-12);
+}
@@ -0,0 +1,136 @@
+/*
+ * CurveSamplerTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "curves/CubicHermiteSE3Curve.hpp"
+#include "curves/CurveSampler.hpp"
+#include "curves/helpers.hpp"
+
+using namespace curves;
+
+typedef CubicHermiteSE3Curve::ValueType ValueType;
+
+namespace {
+
+void fitTestCurve(CubicHermiteSE3Curve* curve) {
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  for (size_t i = 0; i < 20; ++i) {
+    const double t = 0.5 * i;
+    times.push_back(t);
+    values.push_back(ValueType(ValueType::Position(std::sin(t), t, 0.1 * t * t),
+                               ValueType::Rotation(kindr::EulerAnglesZyxD(0.3 * t, 0.1, -0.2 * t))));
+  }
+  curve->fitCurve(times, values);
+}
+
+} // namespace
+
+TEST(CurveSampler, SampleAtRate)
+{
+  CubicHermiteSE3Curve curve;
+  fitTestCurve(&curve);
+
+  // Chunks that do not divide the number of samples, split over several threads.
+  CurveSampler<CubicHermiteSE3Curve> sampler(curve, 37, 3);
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  size_t nChunks = 0;
+  CallbackCurveSampleSink<ValueType> sink([&](const Time* t, const ValueType* v, size_t n) {
+    EXPECT_LE(n, 37u);
+    times.insert(times.end(), t, t + n);
+    values.insert(values.end(), v, v + n);
+    ++nChunks;
+    return true;
+  });
+  ASSERT_TRUE(sampler.sampleAtRate(100.0, &sink));
+
+  // 9.5 s at 100 Hz, both ends included.
+  ASSERT_EQ(951u, times.size());
+  EXPECT_EQ(26u, nChunks);
+  EXPECT_EQ(curve.getMinTime(), times.front());
+  EXPECT_EQ(curve.getMaxTime(), times.back());
+  for (size_t i = 0; i < times.size(); ++i) {
+    EXPECT_EQ(curve.getMinTime() + double(i) / 100.0, times[i]);
+    ValueType expected;
+    ASSERT_TRUE(curve.evaluate(expected, times[i]));
+    EXPECT_EQ(expected.getPosition().vector(), values[i].getPosition().vector());
+    EXPECT_EQ(expected.getRotation().vector(), values[i].getRotation().vector());
+  }
+}
+
+TEST(CurveSampler, FileSinks)
+{
+  CubicHermiteSE3Curve curve;
+  fitTestCurve(&curve);
+  std::vector<Time> times;
+  for (size_t i = 0; i < 500; ++i) {
+    times.push_back(curve.getMinTime() + 0.019 * i);
+  }
+  CurveSampler<CubicHermiteSE3Curve> sampler(curve, 64, 2);
+
+  const std::string csvFile = "CurveSamplerTest.csv";
+  {
+    CsvCurveSampleSink<ValueType> sink(csvFile);
+    ASSERT_TRUE(sink.isOpen());
+    ASSERT_TRUE(sampler.sampleAtTimes(times, &sink));
+  }
+  std::vector<Time> loadedTimes;
+  std::vector<double> loadedValues;
+  size_t dimension;
+  loadTimeVectorCSV(csvFile, &loadedTimes, &loadedValues, &dimension);
+  ASSERT_EQ(7u, dimension);
+  EXPECT_EQ(times, loadedTimes);
+
+  const std::string binaryFile = "CurveSamplerTest.bin";
+  {
+    BinaryCurveSampleSink<ValueType> sink(binaryFile);
+    ASSERT_TRUE(sampler.sampleAtTimes(times, &sink));
+  }
+  std::vector<double> rows(times.size() * 8);
+  FILE* fp = fopen(binaryFile.c_str(), "rb");
+  ASSERT_TRUE(fp != NULL);
+  EXPECT_EQ(rows.size(), fread(rows.data(), sizeof(double), rows.size(), fp));
+  EXPECT_EQ(0u, fread(rows.data(), sizeof(double), 1, fp));
+  fclose(fp);
+
+  for (size_t i = 0; i < times.size(); ++i) {
+    ValueType expected;
+    ASSERT_TRUE(curve.evaluate(expected, times[i]));
+    EXPECT_EQ(times[i], rows[8 * i]);
+    EXPECT_EQ(expected.getPosition().x(), rows[8 * i + 1]);
+    EXPECT_EQ(expected.getRotation().z(), rows[8 * i + 7]);
+    EXPECT_EQ(expected.getPosition().x(), loadedValues[7 * i]);
+    EXPECT_EQ(expected.getRotation().w(), loadedValues[7 * i + 3]);
+  }
+  std::remove(csvFile.c_str());
+  std::remove(binaryFile.c_str());
+}
+
+TEST(CurveSampler, StopsOnFailure)
+{
+  CubicHermiteSE3Curve curve;
+  fitTestCurve(&curve);
+  CurveSampler<CubicHermiteSE3Curve> sampler(curve, 4, 2);
+  size_t consumed = 0;
+  CallbackCurveSampleSink<ValueType> sink([&](const Time*, const ValueType*, size_t n) {
+    consumed += n;
+    return consumed < 8;
+  });
+  std::vector<Time> times(20, 1.0);
+  EXPECT_FALSE(sampler.sampleAtTimes(times, &sink));
+  EXPECT_EQ(8u, consumed);
+
+  times.back() = curve.getMaxTime() + 1.0;
+  consumed = 0;
+  EXPECT_FALSE(sampler.sampleAtTimes(times, &sink));
+}
@@ -0,0 +1,128 @@
+/*
+ * HelpersTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+#include "curves/helpers.hpp"
+
+using namespace curves;
+
+TEST(Helpers, LoadNumericCSV)
+{
+  const std::string filename = "HelpersTest_numeric.csv";
+  const char* fields[] = {"0", "-1.5", " 2.25 ", "1e-3", "-4.2E+2", "0.1", "+7",
+                          "123456789012345678901234", "1.7976931348623157e308", "4.9e-324",
+                          "3.141592653589793", ".5"};
+  const size_t nFields = sizeof(fields) / sizeof(fields[0]);
+  {
+    std::ofstream out(filename.c_str());
+    // Windows line endings, an empty line and no newline at the end of the file.
+    out << fields[0] << "," << fields[1] << "," << fields[2] << "\r\n";
+    out << "\n";
+    out << fields[3] << "," << fields[4] << "," << fields[5] << "\n";
+    out << fields[6] << "," << fields[7] << "," << fields[8] << "\n";
+    out << fields[9] << "," << fields[10] << "," << fields[11];
+  }
+
+  std::vector<double> data;
+  ASSERT_EQ(3u, loadNumericCSV(filename, &data));
+  ASSERT_EQ(nFields, data.size());
+  for (size_t i = 0; i < nFields; ++i) {
+    EXPECT_EQ(strtod(fields[i], NULL), data[i]) << fields[i];
+  }
+  std::remove(filename.c_str());
+}
+
+TEST(Helpers, TimeVectorCSVRoundTrip)
+{
+  const std::string filename = "HelpersTest_timeVector.csv";
+  std::vector<Time> times;
+  std::vector<Eigen::VectorXd> values;
+  for (size_t i = 0; i < 1000; ++i) {
+    times.push_back(0.125 * i);
+    Eigen::VectorXd value(3);
+    value << 0.5 * i, -0.25 * i, 2.0;
+    values.push_back(value);
+  }
+  writeTimeVectorCSV(filename, times, values);
+
+  std::vector<Time> loadedTimes;
+  std::vector<double> loadedData;
+  size_t dimension;
+  loadTimeVectorCSV(filename, &loadedTimes, &loadedData, &dimension);
+  ASSERT_EQ(3u, dimension);
+  ASSERT_EQ(times.size(), loadedTimes.size());
+  ASSERT_EQ(times.size() * dimension, loadedData.size());
+
+  std::vector<Eigen::VectorXd> loadedValues;
+  loadTimeVectorCSV(filename, &loadedTimes, &loadedValues);
+  ASSERT_EQ(times.size(), loadedValues.size());
+  for (size_t i = 0; i < times.size(); ++i) {
+    EXPECT_EQ(times[i], loadedTimes[i]);
+    EXPECT_EQ(values[i], loadedValues[i]);
+    EXPECT_EQ(values[i], Eigen::Map<const Eigen::VectorXd>(loadedData.data() + i * dimension, dimension));
+  }
+
+  std::vector<Time> loadedTimes1;
+  loadTimeTimeVectorCSV(filename, &loadedTimes, &loadedTimes1, &loadedValues);
+  ASSERT_EQ(times.size(), loadedValues.size());
+  ASSERT_EQ(2, loadedValues[0].size());
+  EXPECT_EQ(times[10], loadedTimes[10]);
+  EXPECT_EQ(values[10](0), loadedTimes1[10]);
+  EXPECT_EQ(values[10](2), loadedValues[10](1));
+  std::remove(filename.c_str());
+}
+
+TEST(Helpers, WriteTimeVectorCSVParallel)
+{
+  const std::string filename = "HelpersTest_parallel.csv";
+  const size_t numRows = 100000;
+  const size_t dimension = 4;
+  std::vector<Time> times(numRows);
+  std::vector<double> values(numRows * dimension);
+  for (size_t i = 0; i < numRows; ++i) {
+    times[i] = 0.001 * i;
+    values[i * dimension] = std::sin(0.1 * i);
+    values[i * dimension + 1] = -1.0 / (i + 1.0);
+    values[i * dimension + 2] = double(i);
+    values[i * dimension + 3] = (i % 2 == 0) ? 1e-300 * i : -0.0;
+  }
+
+  // Round-trip precision, chunks formatted on several threads must come out in order.
+  writeTimeVectorCSV(filename, times.data(), values.data(), numRows, dimension, 0, 3);
+  std::vector<Time> loadedTimes;
+  std::vector<double> loadedValues;
+  size_t loadedDimension;
+  loadTimeVectorCSV(filename, &loadedTimes, &loadedValues, &loadedDimension);
+  ASSERT_EQ(dimension, loadedDimension);
+  EXPECT_EQ(times, loadedTimes);
+  EXPECT_EQ(values, loadedValues);
+
+  // Fixed precision.
+  writeTimeVectorCSV(filename, times.data(), values.data(), 2, dimension, 3, 1);
+  std::ifstream in(filename.c_str());
+  std::string line;
+  std::getline(in, line);
+  EXPECT_EQ("0,0,-1,0,0", line);
+  std::getline(in, line);
+  EXPECT_EQ("0.001,0.0998,-0.5,1,-0", line);
+
+  // The longest numbers at the highest precision.
+  const std::vector<double> extremes = {-1.2345678901234567e-300, -1.2345678901234567e+300};
+  writeTimeVectorCSV(filename, extremes.data(), extremes.data() + 1, 1, 1, 17, 1);
+  loadTimeVectorCSV(filename, &loadedTimes, &loadedValues, &loadedDimension);
+  EXPECT_EQ(extremes[0], loadedTimes[0]);
+  EXPECT_EQ(extremes[1], loadedValues[0]);
+  EXPECT_DEATH(writeTimeVectorCSV(filename, extremes.data(), extremes.data() + 1, 1, 1, 30, 1), "precision");
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,65 @@
+/*
+ * HermiteSE3CoefficientTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include "curves/HermiteSE3Coefficient.hpp"
+#include <kindr/Core>
+#include <kindr/common/gtest_eigen.hpp>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace curves;
+
+typedef HermiteSE3Coefficient::Transform Transform;
+typedef HermiteSE3Coefficient::Twist Twist;
+
+TEST(HermiteSE3Coefficient, Layout)
+{
+  EXPECT_EQ(16u, alignof(HermiteSE3Coefficient));
+  EXPECT_GE(sizeof(HermiteSE3Coefficient), 13u * sizeof(double));
+  EXPECT_LT(sizeof(HermiteSE3Coefficient), 13u * sizeof(double) + 16u);
+
+  std::vector<HermiteSE3Coefficient> coefficients(3);
+  for (const HermiteSE3Coefficient& coefficient : coefficients) {
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(coefficient.data()) % 16u);
+  }
+}
+
+TEST(HermiteSE3Coefficient, DefaultIsIdentity)
+{
+  const HermiteSE3Coefficient coefficient;
+  KINDR_ASSERT_DOUBLE_MX_EQ(Eigen::Vector3d::Zero(), coefficient.getPosition(), 1e-12, "position");
+  KINDR_ASSERT_DOUBLE_MX_EQ(Eigen::Vector4d(1.0, 0.0, 0.0, 0.0), coefficient.getQuaternion(), 1e-12, "quaternion");
+  KINDR_ASSERT_DOUBLE_MX_EQ(Eigen::Vector3d::Zero(), coefficient.getLinearVelocity(), 1e-12, "linear velocity");
+  KINDR_ASSERT_DOUBLE_MX_EQ(Eigen::Vector3d::Zero(), coefficient.getAngularVelocity(), 1e-12, "angular velocity");
+}
+
+TEST(HermiteSE3Coefficient, RoundTripAndCopy)
+{
+  const Transform transform(Transform::Position(1.0, 2.0, 3.0),
+                            Transform::Rotation(kindr::EulerAnglesZyxD(0.3, -0.2, 0.1)));
+  const Twist twist(Eigen::Vector3d(0.4, 0.5, 0.6), Eigen::Vector3d(-0.1, 0.2, -0.3));
+  const HermiteSE3Coefficient coefficient(transform, twist);
+
+  const double* data = coefficient.data();
+  EXPECT_EQ(1.0, data[HermiteSE3Coefficient::kPositionOffset]);
+  EXPECT_EQ(transform.getRotation().w(), data[HermiteSE3Coefficient::kQuaternionOffset]);
+  EXPECT_EQ(0.4, data[HermiteSE3Coefficient::kLinearVelocityOffset]);
+  EXPECT_EQ(-0.3, data[HermiteSE3Coefficient::kAngularVelocityOffset + 2]);
+
+  KINDR_ASSERT_DOUBLE_MX_EQ(transform.getPosition().vector(), coefficient.getTransformation().getPosition().vector(), 1e-12, "position");
+  KINDR_ASSERT_DOUBLE_MX_EQ(transform.getRotation().vector(), coefficient.getTransformation().getRotation().vector(), 1e-12, "rotation");
+  KINDR_ASSERT_DOUBLE_MX_EQ(twist.getVector(), coefficient.getTransformationDerivative().getVector(), 1e-12, "twist");
+
+  HermiteSE3Coefficient copy;
+  std::memcpy(&copy, &coefficient, sizeof(HermiteSE3Coefficient));
+  EXPECT_TRUE(copy == coefficient);
+  copy.getAngularVelocity()(0) = 1.0;
+  EXPECT_TRUE(copy != coefficient);
+}
@@ -0,0 +1,124 @@
+/*
+ * HermiteSE3CurveFileTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "curves/CubicHermiteSE3Curve.hpp"
+#include "curves/HermiteSE3CurveFile.hpp"
+
+using namespace curves;
+
+typedef CubicHermiteSE3Curve::ValueType ValueType;
+typedef CubicHermiteSE3Curve::DerivativeType DerivativeType;
+
+TEST(HermiteSE3CurveFile, WriteAndMap)
+{
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  for (size_t i = 0; i < 50; ++i) {
+    const double t = 0.1 * i;
+    times.push_back(t);
+    values.push_back(ValueType(ValueType::Position(std::sin(t), 2.0 * t, std::cos(t)),
+                               ValueType::Rotation(kindr::EulerAnglesZyxD(0.4 * t, 0.2, -0.1 * t))));
+  }
+  CubicHermiteSE3Curve curve;
+  curve.fitCurve(times, values);
+
+  const std::string filename = "HermiteSE3CurveFileTest.bin";
+  ASSERT_TRUE(curve.saveCurveBinary(filename));
+
+  MappedCubicHermiteSE3Curve mapped;
+  ASSERT_TRUE(mapped.load(filename));
+  ASSERT_EQ(curve.size(), mapped.size());
+  EXPECT_EQ(curve.getMinTime(), mapped.getMinTime());
+  EXPECT_EQ(curve.getMaxTime(), mapped.getMaxTime());
+
+  for (Time t = curve.getMinTime(); t <= curve.getMaxTime(); t += 0.013) {
+    ValueType expected, value;
+    DerivativeType expectedDerivative, derivative;
+    ASSERT_TRUE(curve.evaluate(expected, t));
+    ASSERT_TRUE(mapped.evaluate(value, t));
+    ASSERT_TRUE(curve.evaluateDerivative(expectedDerivative, t, 1));
+    ASSERT_TRUE(mapped.evaluateDerivative(derivative, t, 1));
+    EXPECT_EQ(expected.getPosition().vector(), value.getPosition().vector());
+    EXPECT_EQ(expected.getRotation().vector(), value.getRotation().vector());
+    EXPECT_EQ(expectedDerivative.getVector(), derivative.getVector());
+  }
+  ValueType value;
+  EXPECT_FALSE(mapped.evaluate(value, curve.getMaxTime() + 1.0));
+
+  mapped.clear();
+  EXPECT_TRUE(mapped.isEmpty());
+  std::remove(filename.c_str());
+}
+
+TEST(HermiteSE3CurveFile, RejectsInvalidFiles)
+{
+  MappedCubicHermiteSE3Curve mapped;
+  EXPECT_FALSE(mapped.load("HermiteSE3CurveFileTest_missing.bin"));
+
+  const std::string filename = "HermiteSE3CurveFileTest_invalid.bin";
+  std::vector<Time> times(3, 0.0);
+  times[1] = 1.0;
+  times[2] = 2.0;
+  ASSERT_TRUE(writeHermiteSE3CurveFile(filename, times, std::vector<HermiteSE3Coefficient>(3)));
+  ASSERT_TRUE(mapped.load(filename));
+  EXPECT_EQ(3, mapped.size());
+
+  // Truncate the coefficient array.
+  std::vector<char> bytes;
+  {
+    std::ifstream in(filename.c_str(), std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream out(filename.c_str(), std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), bytes.size() - 1);
+  }
+  EXPECT_FALSE(mapped.load(filename));
+  EXPECT_TRUE(mapped.isEmpty());
+
+  // Unknown version.
+  HermiteSE3CurveFileHeader header;
+  std::memcpy(&header, bytes.data(), sizeof(header));
+  header.version = HermiteSE3CurveFileHeader::kVersion + 1;
+  std::memcpy(bytes.data(), &header, sizeof(header));
+  {
+    std::ofstream out(filename.c_str(), std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), bytes.size());
+  }
+  EXPECT_FALSE(mapped.load(filename));
+
+  // Offsets which wrap around, or point into the header.
+  const HermiteSE3CurveFileHeader validHeader = header;
+  const uint64_t wrappingOffsets[2] = {~uint64_t(0) - HermiteSE3CurveFileHeader::kAlignment + 1, 0u};
+  for (int i = 0; i < 2; ++i) {
+    for (int section = 0; section < 2; ++section) {
+      header = validHeader;
+      header.version = HermiteSE3CurveFileHeader::kVersion;
+      (section == 0 ? header.timesOffset : header.coefficientsOffset) = wrappingOffsets[i];
+      std::memcpy(bytes.data(), &header, sizeof(header));
+      {
+        std::ofstream out(filename.c_str(), std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), bytes.size());
+      }
+      EXPECT_FALSE(mapped.load(filename)) << i << " " << section;
+    }
+  }
+
+  // Knot times which are not increasing.
+  times[2] = 1.0;
+  ASSERT_TRUE(writeHermiteSE3CurveFile(filename, times, std::vector<HermiteSE3Coefficient>(3)));
+  EXPECT_FALSE(mapped.load(filename));
+  std::remove(filename.c_str());
+}
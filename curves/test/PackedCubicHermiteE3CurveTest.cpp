@@ -0,0 +1,114 @@
+/*
+ * PackedCubicHermiteE3CurveTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "curves/CubicHermiteE3Curve.hpp"
+#include "curves/PackedCubicHermiteE3Curve.hpp"
+
+using namespace curves;
+
+typedef PackedCubicHermiteE3Curve::ValueType ValueType;
+typedef PackedCubicHermiteE3Curve::SampleMatrix SampleMatrix;
+
+namespace {
+
+const double kTolerance = 1e-12;
+
+void makeKnots(std::vector<Time>* times, std::vector<ValueType>* values) {
+  for (size_t i = 0; i < 50; ++i) {
+    // Uneven knot spacing.
+    const double t = 0.3 * i + 0.05 * std::sin(double(i));
+    times->push_back(t);
+    values->push_back(ValueType(std::sin(t), std::cos(2.0 * t), 0.1 * t * t));
+  }
+}
+
+} // namespace
+
+TEST(PackedCubicHermiteE3Curve, MatchesMapCurve)
+{
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  makeKnots(&times, &values);
+  CubicHermiteE3Curve curve;
+  curve.fitCurveWithDerivatives(times, values, ValueType(1.0, 0.0, -1.0), ValueType(0.5, 0.5, 0.5));
+  PackedCubicHermiteE3Curve packed;
+  packed.fitCurveWithDerivatives(times, values, ValueType(1.0, 0.0, -1.0), ValueType(0.5, 0.5, 0.5));
+  const PackedCubicHermiteE3Curve copied(curve);
+  ASSERT_EQ(curve.size(), packed.size());
+  ASSERT_EQ(curve.size(), copied.size());
+  EXPECT_EQ(curve.getMinTime(), packed.getMinTime());
+  EXPECT_EQ(curve.getMaxTime(), packed.getMaxTime());
+  EXPECT_EQ(copied.getPositions(), packed.getPositions());
+  EXPECT_EQ(copied.getVelocities(), packed.getVelocities());
+
+  // Sorted samples including all knots and both ends.
+  std::vector<Time> sampleTimes;
+  for (size_t i = 0; i + 1 < times.size(); ++i) {
+    for (size_t j = 0; j < 7; ++j) {
+      sampleTimes.push_back(times[i] + (times[i + 1] - times[i]) * j / 7.0);
+    }
+  }
+  sampleTimes.push_back(curve.getMaxTime());
+
+  SampleMatrix positions, velocities, accelerations;
+  ASSERT_TRUE(packed.evaluate(sampleTimes, &positions, &velocities, &accelerations));
+  ASSERT_EQ(int(sampleTimes.size()), positions.rows());
+  for (size_t s = 0; s < sampleTimes.size(); ++s) {
+    ValueType expected, value;
+    ASSERT_TRUE(curve.evaluate(expected, sampleTimes[s]));
+    ASSERT_TRUE(packed.evaluate(value, sampleTimes[s]));
+    EXPECT_TRUE(expected.isApprox(value, kTolerance));
+    EXPECT_TRUE(expected.isApprox(positions.row(s).transpose(), kTolerance)) << sampleTimes[s];
+
+    ASSERT_TRUE(curve.evaluateDerivative(expected, sampleTimes[s], 1));
+    ASSERT_TRUE(packed.evaluateDerivative(value, sampleTimes[s], 1));
+    EXPECT_TRUE(expected.isApprox(value, kTolerance));
+    EXPECT_TRUE(expected.isApprox(velocities.row(s).transpose(), kTolerance)) << sampleTimes[s];
+
+    ASSERT_TRUE(curve.evaluateLinearAcceleration(expected, sampleTimes[s]));
+    ASSERT_TRUE(packed.evaluateDerivative(value, sampleTimes[s], 2));
+    EXPECT_TRUE(expected.isApprox(value, kTolerance));
+    EXPECT_TRUE(expected.isApprox(accelerations.row(s).transpose(), kTolerance)) << sampleTimes[s];
+  }
+
+  // Unsorted samples and single outputs give the same rows.
+  std::vector<Time> reversedTimes(sampleTimes.rbegin(), sampleTimes.rend());
+  SampleMatrix reversedVelocities;
+  ASSERT_TRUE(packed.evaluateDerivative(reversedTimes, &reversedVelocities));
+  EXPECT_TRUE(reversedVelocities.colwise().reverse().isApprox(velocities, kTolerance));
+}
+
+TEST(PackedCubicHermiteE3Curve, OutsideAndDegenerate)
+{
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  makeKnots(&times, &values);
+  PackedCubicHermiteE3Curve packed;
+  packed.fitCurve(times, values);
+
+  SampleMatrix positions;
+  std::vector<Time> sampleTimes(1, packed.getMinTime());
+  sampleTimes.push_back(packed.getMaxTime() + 1e-3);
+  EXPECT_FALSE(packed.evaluate(sampleTimes, &positions));
+
+  // A curve with one knot is only defined at its time.
+  packed.fitCurve(std::vector<Time>(1, 2.0), std::vector<ValueType>(1, ValueType(1.0, 2.0, 3.0)));
+  sampleTimes.assign(3, 2.0);
+  ASSERT_TRUE(packed.evaluate(sampleTimes, &positions));
+  EXPECT_EQ(ValueType(1.0, 2.0, 3.0), ValueType(positions.row(2).transpose()));
+  sampleTimes.push_back(2.5);
+  EXPECT_FALSE(packed.evaluate(sampleTimes, &positions));
+
+  packed.clear();
+  EXPECT_TRUE(packed.isEmpty());
+  EXPECT_FALSE(packed.evaluate(sampleTimes, &positions));
+}
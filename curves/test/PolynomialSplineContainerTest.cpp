@@ -9,6 +9,9 @@
 // gtest
 #include <gtest/gtest.h>
 
+// stl
+#include <cmath>
+
 // curves
 #include "curves/polynomial_splines_containers.hpp"
 
@@ -111,3 +114,544 @@ TEST(PolynomialSplineContainer, getState)
   EXPECT_EQ(polyContainer.getVelocity(), polyContainer.getVelocityAtTime(containerTime));
   EXPECT_EQ(polyContainer.getAcceleration(), polyContainer.getAccelerationAtTime(containerTime));
 }
+
+TEST(PolynomialSplineContainer, evalFloat) {
+  const std::vector<double> knotPos = {0.0, 1.0, 2.0};
+  const std::vector<double> knotVal = {0.0, 1.0, 2.0};
+  const std::vector<float> knotPosFloat(knotPos.begin(), knotPos.end());
+  const std::vector<float> knotValFloat(knotVal.begin(), knotVal.end());
+
+  curves::PolynomialSplineContainerQuintic polyContainer;
+  curves::PolynomialSplineContainer<5, float> polyContainerFloat;
+  ASSERT_TRUE(polyContainer.setData(knotPos, knotVal, 0.1, 0.2, 0.3, 0.4));
+  ASSERT_TRUE(polyContainerFloat.setData(knotPosFloat, knotValFloat, 0.1f, 0.2f, 0.3f, 0.4f));
+
+  for (double t = 0.0; t <= 2.0; t += 0.1) {
+    const float tf = static_cast<float>(t);
+    EXPECT_NEAR(polyContainer.getPositionAtTime(t), polyContainerFloat.getPositionAtTime(tf), 1e-4);
+    EXPECT_NEAR(polyContainer.getVelocityAtTime(t), polyContainerFloat.getVelocityAtTime(tf), 1e-3);
+    EXPECT_NEAR(polyContainer.getAccelerationAtTime(t), polyContainerFloat.getAccelerationAtTime(tf), 1e-2);
+  }
+}
+
+TEST(PolynomialSplineContainer, setDataMultipleContainers) {
+  using Container = curves::PolynomialSplineContainerQuintic;
+  const std::vector<double> knotDurations = {0.0, 0.4, 1.1, 1.5, 2.4};
+  Container::MatrixX knotPositions(5, 3);
+  knotPositions << 0.0,  1.0, -2.0,
+                   0.3,  0.8, -1.5,
+                   0.1,  1.2, -0.7,
+                  -0.4,  1.1,  0.2,
+                   0.2,  0.6,  0.4;
+  Container::VectorX initialVelocities(3), initialAccelerations(3), finalVelocities(3), finalAccelerations(3);
+  initialVelocities << 0.1, -0.2, 0.3;
+  initialAccelerations << 0.0, 0.5, -0.1;
+  finalVelocities << -0.3, 0.0, 0.2;
+  finalAccelerations << 0.2, 0.1, 0.0;
+
+  std::vector<Container> containers;
+  ASSERT_TRUE(Container::setData(knotDurations, knotPositions, initialVelocities, initialAccelerations,
+                                 finalVelocities, finalAccelerations, &containers));
+  ASSERT_EQ(3u, containers.size());
+
+  for (int dim = 0; dim < 3; ++dim) {
+    const std::vector<double> positions(knotPositions.col(dim).data(), knotPositions.col(dim).data() + 5);
+    Container container;
+    ASSERT_TRUE(container.setData(knotDurations, positions, initialVelocities(dim), initialAccelerations(dim),
+                                  finalVelocities(dim), finalAccelerations(dim)));
+    EXPECT_EQ(container.getSplines().size(), containers[dim].getSplines().size());
+    EXPECT_NEAR(container.getContainerDuration(), containers[dim].getContainerDuration(), 1e-12);
+    for (double t = 0.0; t <= 2.4; t += 0.05) {
+      EXPECT_NEAR(container.getPositionAtTime(t), containers[dim].getPositionAtTime(t), 1e-9);
+      EXPECT_NEAR(container.getVelocityAtTime(t), containers[dim].getVelocityAtTime(t), 1e-8);
+      EXPECT_NEAR(container.getAccelerationAtTime(t), containers[dim].getAccelerationAtTime(t), 1e-7);
+    }
+  }
+
+  // Mismatching number of knots.
+  EXPECT_FALSE(Container::setData(std::vector<double>(knotDurations.begin(), knotDurations.end() - 1), knotPositions,
+                                  initialVelocities, initialAccelerations, finalVelocities, finalAccelerations,
+                                  &containers));
+}
+
+TEST(PolynomialSplineContainer, factorizationCache) {
+  const std::vector<double> knotDurations = {0.0, 0.3, 0.8, 1.0};
+  const std::vector<double> shiftedKnotDurations = {0.0, 0.5, 0.8, 1.0};
+  const std::vector<std::vector<double>> knotPositionsPerCycle = {
+      {0.0, 0.1, 0.3, 0.2}, {0.2, -0.1, 0.4, 0.0}, {0.0, 0.5, 0.1, -0.3}};
+
+  curves::PolynomialSplineContainerQuintic polyContainer;
+  for (size_t cycle = 0; cycle < knotPositionsPerCycle.size(); ++cycle) {
+    const std::vector<double>& knotPositions = knotPositionsPerCycle[cycle];
+    ASSERT_TRUE(polyContainer.setData(knotDurations, knotPositions, 0.1, 0.0, -0.2, 0.3));
+    EXPECT_EQ(cycle, polyContainer.getFactorizationCacheHits());
+    EXPECT_EQ(1u, polyContainer.getFactorizationCacheMisses());
+
+    curves::PolynomialSplineContainerQuintic freshContainer;
+    ASSERT_TRUE(freshContainer.setData(knotDurations, knotPositions, 0.1, 0.0, -0.2, 0.3));
+    for (double t = 0.0; t <= 1.0; t += 0.05) {
+      EXPECT_NEAR(freshContainer.getPositionAtTime(t), polyContainer.getPositionAtTime(t), 1e-12);
+      EXPECT_NEAR(freshContainer.getAccelerationAtTime(t), polyContainer.getAccelerationAtTime(t), 1e-9);
+    }
+  }
+
+  // Other boundary conditions or timing need a new factorization.
+  ASSERT_TRUE(polyContainer.setData(knotDurations, knotPositionsPerCycle[0], 0.1, -0.2));
+  EXPECT_EQ(2u, polyContainer.getFactorizationCacheMisses());
+  ASSERT_TRUE(polyContainer.setData(shiftedKnotDurations, knotPositionsPerCycle[0], 0.1, -0.2));
+  EXPECT_EQ(3u, polyContainer.getFactorizationCacheMisses());
+  ASSERT_TRUE(polyContainer.setData(shiftedKnotDurations, knotPositionsPerCycle[1], 0.0, 0.0));
+  EXPECT_EQ(3u, polyContainer.getFactorizationCacheMisses());
+  EXPECT_EQ(3u, polyContainer.getFactorizationCacheHits());
+  curves::PolynomialSplineContainerQuintic freshContainer;
+  ASSERT_TRUE(freshContainer.setData(shiftedKnotDurations, knotPositionsPerCycle[1], 0.0, 0.0));
+  EXPECT_NEAR(freshContainer.getVelocityAtTime(0.6), polyContainer.getVelocityAtTime(0.6), 1e-12);
+
+  polyContainer.clearFactorizationCache();
+  EXPECT_EQ(0u, polyContainer.getFactorizationCacheHits());
+  ASSERT_TRUE(polyContainer.setData(shiftedKnotDurations, knotPositionsPerCycle[1], 0.0, 0.0));
+  EXPECT_EQ(1u, polyContainer.getFactorizationCacheMisses());
+}
+
+TEST(PolynomialSplineContainer, hermite) {
+  const std::vector<double> knotDurations = {0.0, 0.4, 1.1, 1.5};
+  const std::vector<double> knotPositions = {0.0, 0.3, -0.2, 0.5};
+  const std::vector<double> knotVelocities = {0.1, -0.4, 0.2, 0.0};
+  const std::vector<double> knotAccelerations = {0.0, 1.0, -2.0, 0.5};
+
+  curves::PolynomialSplineContainerQuintic polyContainer;
+  ASSERT_TRUE(polyContainer.setDataHermite(knotDurations, knotPositions, knotVelocities, knotAccelerations));
+  ASSERT_EQ(3u, polyContainer.getSplines().size());
+  for (size_t splineId = 0; splineId < 3; ++splineId) {
+    // Same as the spline fitted to the boundary conditions of the segment.
+    const double duration = knotDurations[splineId + 1] - knotDurations[splineId];
+    const curves::PolynomialSplineQuintic spline(curves::SplineOptions(
+        duration, knotPositions[splineId], knotPositions[splineId + 1], knotVelocities[splineId],
+        knotVelocities[splineId + 1], knotAccelerations[splineId], knotAccelerations[splineId + 1]));
+    for (size_t i = 0; i < spline.getCoefficients().size(); ++i) {
+      EXPECT_NEAR(spline.getCoefficients()[i], polyContainer.getSplines()[splineId].getCoefficients()[i], 1e-9);
+    }
+  }
+  for (size_t knotId = 0; knotId < knotDurations.size(); ++knotId) {
+    const double t = knotDurations[knotId];
+    EXPECT_NEAR(knotPositions[knotId], polyContainer.getPositionAtTime(t), 1e-12);
+    EXPECT_NEAR(knotVelocities[knotId], polyContainer.getVelocityAtTime(t), 1e-9);
+    EXPECT_NEAR(knotAccelerations[knotId], polyContainer.getAccelerationAtTime(t), 1e-9);
+  }
+
+  // Cubic Hermite splines only match positions and velocities.
+  curves::PolynomialSplineContainerCubic cubicContainer;
+  ASSERT_TRUE(cubicContainer.setDataHermite(knotDurations, knotPositions, knotVelocities));
+  for (size_t knotId = 0; knotId < knotDurations.size(); ++knotId) {
+    EXPECT_NEAR(knotPositions[knotId], cubicContainer.getPositionAtTime(knotDurations[knotId]), 1e-12);
+    EXPECT_NEAR(knotVelocities[knotId], cubicContainer.getVelocityAtTime(knotDurations[knotId]), 1e-9);
+  }
+  EXPECT_FALSE(cubicContainer.setDataHermite(knotDurations, knotPositions, knotVelocities, knotAccelerations));
+  EXPECT_FALSE(polyContainer.setDataHermite(knotDurations, knotPositions, std::vector<double>(2, 0.0)));
+}
+
+TEST(PolynomialSplineContainer, hermiteLarge) {
+  // Enough splines to be built in several chunks.
+  const size_t numKnots = 40000;
+  std::vector<double> knotDurations(numKnots), knotPositions(numKnots), knotVelocities(numKnots),
+      knotAccelerations(numKnots);
+  for (size_t knotId = 0; knotId < numKnots; ++knotId) {
+    knotDurations[knotId] = 0.01 * knotId;
+    knotPositions[knotId] = std::sin(0.37 * knotId);
+    knotVelocities[knotId] = std::cos(0.11 * knotId);
+    knotAccelerations[knotId] = std::sin(0.05 * knotId);
+  }
+
+  curves::PolynomialSplineContainerQuintic polyContainer;
+  ASSERT_TRUE(polyContainer.setDataHermite(knotDurations, knotPositions, knotVelocities, knotAccelerations));
+  ASSERT_EQ(numKnots - 1, polyContainer.getSplines().size());
+  EXPECT_NEAR(knotDurations.back(), polyContainer.getContainerDuration(), 1e-9);
+  for (size_t splineId = 0; splineId < numKnots - 1; ++splineId) {
+    const curves::PolynomialSplineQuintic& spline = polyContainer.getSplines()[splineId];
+    const double duration = knotDurations[splineId + 1] - knotDurations[splineId];
+    ASSERT_NEAR(knotPositions[splineId], spline.getPositionAtTime(0.0), 1e-12);
+    ASSERT_NEAR(knotPositions[splineId + 1], spline.getPositionAtTime(duration), 1e-9);
+    ASSERT_NEAR(knotVelocities[splineId + 1], spline.getVelocityAtTime(duration), 1e-6);
+  }
+
+  knotDurations[numKnots / 2] = knotDurations[numKnots / 2 - 1];
+  EXPECT_FALSE(polyContainer.setDataHermite(knotDurations, knotPositions, knotVelocities, knotAccelerations));
+  EXPECT_TRUE(polyContainer.getSplines().empty());
+}
+
+TEST(PolynomialSplineContainer, pchipAndAkima) {
+  const std::vector<double> knotDurations = {0.0, 0.5, 0.8, 1.5, 2.0, 2.2, 3.0, 3.5};
+  const std::vector<double> knotPositions = {0.0, 0.1, 0.1, 0.9, 1.0, 1.0, 2.5, 2.6};
+
+  curves::PolynomialSplineContainerCubic pchip, akima;
+  ASSERT_TRUE(pchip.setDataPchip(knotDurations, knotPositions));
+  ASSERT_TRUE(akima.setDataAkima(knotDurations, knotPositions));
+  for (size_t knotId = 0; knotId < knotDurations.size(); ++knotId) {
+    EXPECT_NEAR(knotPositions[knotId], pchip.getPositionAtTime(knotDurations[knotId]), 1e-12);
+    EXPECT_NEAR(knotPositions[knotId], akima.getPositionAtTime(knotDurations[knotId]), 1e-12);
+  }
+
+  // PCHIP keeps monotonic data monotonic, flat pieces stay flat.
+  double previousPosition = pchip.getPositionAtTime(0.0);
+  for (double t = 0.01; t <= 3.5; t += 0.01) {
+    const double position = pchip.getPositionAtTime(t);
+    EXPECT_GE(position, previousPosition - 1e-12) << t;
+    previousPosition = position;
+  }
+  EXPECT_NEAR(0.1, pchip.getPositionAtTime(0.65), 1e-12);
+
+  // Linear data is reproduced.
+  const std::vector<double> linearPositions = {1.0, 2.0, 2.6, 4.0, 5.0, 5.4, 7.0, 8.0};
+  ASSERT_TRUE(pchip.setDataPchip(knotDurations, linearPositions));
+  ASSERT_TRUE(akima.setDataAkima(knotDurations, linearPositions));
+  for (double t = 0.0; t <= 3.5; t += 0.05) {
+    EXPECT_NEAR(1.0 + 2.0 * t, pchip.getPositionAtTime(t), 1e-9);
+    EXPECT_NEAR(1.0 + 2.0 * t, akima.getPositionAtTime(t), 1e-9);
+  }
+
+  // Changing one knot only changes the nearby splines.
+  std::vector<double> changedPositions(knotPositions);
+  changedPositions[6] = 3.0;
+  curves::PolynomialSplineContainerCubic changedPchip, changedAkima;
+  ASSERT_TRUE(pchip.setDataPchip(knotDurations, knotPositions));
+  ASSERT_TRUE(akima.setDataAkima(knotDurations, knotPositions));
+  ASSERT_TRUE(changedPchip.setDataPchip(knotDurations, changedPositions));
+  ASSERT_TRUE(changedAkima.setDataAkima(knotDurations, changedPositions));
+  for (size_t splineId = 0; splineId < 3; ++splineId) {
+    EXPECT_EQ(pchip.getSplines()[splineId].getCoefficients(), changedPchip.getSplines()[splineId].getCoefficients());
+    EXPECT_EQ(akima.getSplines()[splineId].getCoefficients(), changedAkima.getSplines()[splineId].getCoefficients());
+  }
+
+  curves::PolynomialSplineContainerLinear linearContainer;
+  EXPECT_FALSE(linearContainer.setDataPchip(knotDurations, knotPositions));
+  EXPECT_FALSE(pchip.setDataAkima(std::vector<double>(1, 0.0), std::vector<double>(1, 0.0)));
+}
+
+TEST(PolynomialSplineContainer, periodic) {
+  const std::vector<double> knotDurations = {0.0, 0.2, 0.5, 0.6, 0.9, 1.2};
+  const std::vector<double> knotPositions = {0.1, 0.4, -0.3, 0.0, 0.2, 0.1};
+  const double period = knotDurations.back();
+
+  curves::PolynomialSplineContainerQuintic polyContainer;
+  ASSERT_TRUE(polyContainer.setDataPeriodic(knotDurations, knotPositions));
+  EXPECT_TRUE(polyContainer.isPeriodic());
+  for (size_t knotId = 0; knotId < knotDurations.size(); ++knotId) {
+    EXPECT_NEAR(knotPositions[knotId], polyContainer.getPositionAtTime(knotDurations[knotId]), 1e-12);
+  }
+
+  // C2 across the knots and across the wrap-around.
+  const double eps = 1e-9;
+  for (size_t knotId = 0; knotId < knotDurations.size(); ++knotId) {
+    const double t = knotDurations[knotId];
+    EXPECT_NEAR(polyContainer.getVelocityAtTime(t - eps), polyContainer.getVelocityAtTime(t + eps), 1e-6) << t;
+    EXPECT_NEAR(polyContainer.getAccelerationAtTime(t - eps), polyContainer.getAccelerationAtTime(t + eps), 1e-6) << t;
+  }
+
+  // Evaluation with wrapped time.
+  for (double t = 0.0; t < period; t += 0.07) {
+    EXPECT_NEAR(polyContainer.getPositionAtTime(t), polyContainer.getPositionAtTime(t + 3.0 * period), 1e-9);
+    EXPECT_NEAR(polyContainer.getVelocityAtTime(t), polyContainer.getVelocityAtTime(t - period), 1e-9);
+    EXPECT_NEAR(polyContainer.getAccelerationAtTime(t), polyContainer.getAccelerationAtTime(t + period), 1e-9);
+  }
+
+  // Advancing loops the container.
+  polyContainer.resetTime();
+  for (int i = 0; i < 70; ++i) {
+    ASSERT_TRUE(polyContainer.advance(0.05));
+  }
+  EXPECT_NEAR(polyContainer.getPositionAtTime(3.5 - 2.0 * period), polyContainer.getPosition(), 1e-9);
+  EXPECT_NEAR(3.5 - 2.0 * period, polyContainer.getContainerTime(), 1e-9);
+
+  // Two splines and the non-periodic reset.
+  ASSERT_TRUE(polyContainer.setDataPeriodic({0.0, 0.3, 1.0}, {0.0, 1.0, 0.0}));
+  EXPECT_NEAR(polyContainer.getVelocityAtTime(0.0), polyContainer.getVelocityAtTime(1.0 - eps), 1e-6);
+  EXPECT_NEAR(polyContainer.getAccelerationAtTime(0.0), polyContainer.getAccelerationAtTime(1.0 - eps), 1e-6);
+  EXPECT_FALSE(polyContainer.setDataPeriodic({0.0, 0.3, 1.0}, {0.0, 1.0, 0.5}));
+  ASSERT_TRUE(polyContainer.setData({0.0, 0.3, 1.0}, {0.0, 1.0, 0.5}, 0.0, 0.0, 0.0, 0.0));
+  EXPECT_FALSE(polyContainer.isPeriodic());
+}
+
+TEST(PolynomialSplineContainer, smoothing) {
+  const std::vector<double> knotDurations = {0.0, 0.3, 0.5, 1.0, 1.2, 1.7, 2.0, 2.6};
+  const std::vector<double> knotPositions = {0.0, 0.5, 0.2, 0.9, 0.4, 1.1, 0.8, 1.4};
+  const int n = knotDurations.size();
+  const double smoothingParameter = 0.05;
+
+  // Dense reference, minimize |y - g|^2 + lambda * g^T * K * g with K = Q * R^-1 * Q^T.
+  Eigen::MatrixXd Q = Eigen::MatrixXd::Zero(n, n - 2), R = Eigen::MatrixXd::Zero(n - 2, n - 2);
+  for (int j = 0; j < n - 2; ++j) {
+    const double h0 = knotDurations[j + 1] - knotDurations[j];
+    const double h1 = knotDurations[j + 2] - knotDurations[j + 1];
+    Q(j, j) = 1.0 / h0;
+    Q(j + 1, j) = -1.0 / h0 - 1.0 / h1;
+    Q(j + 2, j) = 1.0 / h1;
+    R(j, j) = (h0 + h1) / 3.0;
+    if (j + 1 < n - 2) {
+      R(j, j + 1) = R(j + 1, j) = h1 / 6.0;
+    }
+  }
+  const Eigen::VectorXd y = Eigen::Map<const Eigen::VectorXd>(knotPositions.data(), n);
+  const Eigen::MatrixXd K = Q * R.inverse() * Q.transpose();
+  const Eigen::VectorXd g = (Eigen::MatrixXd::Identity(n, n) + smoothingParameter * K).ldlt().solve(y);
+
+  curves::PolynomialSplineContainerQuintic polyContainer;
+  ASSERT_TRUE(polyContainer.setDataSmoothing(knotDurations, knotPositions, smoothingParameter));
+  for (int i = 0; i < n; ++i) {
+    EXPECT_NEAR(g(i), polyContainer.getPositionAtTime(knotDurations[i]), 1e-9);
+  }
+  // Natural cubic spline, C2 and zero acceleration at the ends.
+  const double eps = 1e-9;
+  for (int i = 1; i < n - 1; ++i) {
+    EXPECT_NEAR(polyContainer.getAccelerationAtTime(knotDurations[i] - eps),
+                polyContainer.getAccelerationAtTime(knotDurations[i] + eps), 1e-6);
+  }
+  EXPECT_NEAR(0.0, polyContainer.getAccelerationAtTime(0.0), 1e-9);
+  EXPECT_NEAR(0.0, polyContainer.getAccelerationAtTime(knotDurations.back()), 1e-9);
+
+  // No smoothing interpolates, heavy smoothing approaches the least-squares line.
+  ASSERT_TRUE(polyContainer.setDataSmoothing(knotDurations, knotPositions, 0.0));
+  for (int i = 0; i < n; ++i) {
+    EXPECT_NEAR(knotPositions[i], polyContainer.getPositionAtTime(knotDurations[i]), 1e-12);
+  }
+  ASSERT_TRUE(polyContainer.setDataSmoothing(knotDurations, knotPositions, 1e9));
+  Eigen::MatrixXd A(n, 2);
+  A.col(0) = Eigen::Map<const Eigen::VectorXd>(knotDurations.data(), n);
+  A.col(1).setOnes();
+  const Eigen::Vector2d line = A.colPivHouseholderQr().solve(y);
+  for (double t = 0.0; t <= 2.6; t += 0.1) {
+    EXPECT_NEAR(line(0) * t + line(1), polyContainer.getPositionAtTime(t), 1e-6);
+  }
+
+  EXPECT_FALSE(polyContainer.setDataSmoothing(knotDurations, knotPositions, -1.0));
+  curves::PolynomialSplineContainerLinear linearContainer;
+  EXPECT_FALSE(linearContainer.setDataSmoothing(knotDurations, knotPositions, 0.1));
+}
+
+namespace {
+
+// Dense reference for setDataMinimumDerivative, minimizes the integral of the squared r-th derivative
+// with continuous derivatives up to 2r-2 in a KKT system with all constraints. The boundary derivatives
+// that are not given are left free. Returns the coefficients [a(2r-1) ... a0] of every spline.
+Eigen::VectorXd minimumDerivativeReference(const std::vector<double>& knotDurations,
+                                           const std::vector<double>& knotPositions, int r,
+                                           const std::vector<double>& initialDerivatives,
+                                           const std::vector<double>& finalDerivatives) {
+  const int numSplines = knotDurations.size() - 1;
+  const int numCoefficients = 2 * r;
+  const int numVariables = numCoefficients * numSplines;
+  auto fallingFactorial = [](int power, int derivative) {
+    double factor = 1.0;
+    for (int k = power - derivative + 1; k <= power; ++k) factor *= k;
+    return factor;
+  };
+  auto row = [&](int splineId, int derivative, double t) {
+    Eigen::VectorXd timeRow = Eigen::VectorXd::Zero(numVariables);
+    for (int power = derivative; power < numCoefficients; ++power) {
+      timeRow(numCoefficients * (splineId + 1) - 1 - power) = fallingFactorial(power, derivative) * std::pow(t, power - derivative);
+    }
+    return timeRow;
+  };
+  Eigen::MatrixXd H = Eigen::MatrixXd::Zero(numVariables, numVariables);
+  std::vector<Eigen::VectorXd> constraintRows;
+  std::vector<double> constraintValues;
+  for (int splineId = 0; splineId < numSplines; ++splineId) {
+    const double duration = knotDurations[splineId + 1] - knotDurations[splineId];
+    const int offset = numCoefficients * (splineId + 1) - 1;
+    for (int i = r; i < numCoefficients; ++i) {
+      for (int j = r; j < numCoefficients; ++j) {
+        H(offset - i, offset - j) = fallingFactorial(i, r) * fallingFactorial(j, r)
+            * std::pow(duration, i + j - 2 * r + 1) / (i + j - 2 * r + 1);
+      }
+    }
+    constraintRows.push_back(row(splineId, 0, 0.0));
+    constraintValues.push_back(knotPositions[splineId]);
+    constraintRows.push_back(row(splineId, 0, duration));
+    constraintValues.push_back(knotPositions[splineId + 1]);
+    if (splineId + 1 < numSplines) {
+      for (int derivative = 1; derivative <= 2 * r - 2; ++derivative) {
+        constraintRows.push_back(row(splineId, derivative, duration) - row(splineId + 1, derivative, 0.0));
+        constraintValues.push_back(0.0);
+      }
+    }
+  }
+  for (size_t i = 0; i < initialDerivatives.size(); ++i) {
+    constraintRows.push_back(row(0, i + 1, 0.0));
+    constraintValues.push_back(initialDerivatives[i]);
+  }
+  for (size_t i = 0; i < finalDerivatives.size(); ++i) {
+    constraintRows.push_back(row(numSplines - 1, i + 1, knotDurations.back() - knotDurations[numSplines - 1]));
+    constraintValues.push_back(finalDerivatives[i]);
+  }
+  const int numConstraints = constraintRows.size();
+  Eigen::MatrixXd kkt = Eigen::MatrixXd::Zero(numVariables + numConstraints, numVariables + numConstraints);
+  Eigen::VectorXd kktRhs = Eigen::VectorXd::Zero(numVariables + numConstraints);
+  kkt.topLeftCorner(numVariables, numVariables) = 2.0 * H;
+  for (int i = 0; i < numConstraints; ++i) {
+    kkt.block(numVariables + i, 0, 1, numVariables) = constraintRows[i].transpose();
+    kkt.block(0, numVariables + i, numVariables, 1) = constraintRows[i];
+    kktRhs(numVariables + i) = constraintValues[i];
+  }
+  return kkt.fullPivLu().solve(kktRhs).head(numVariables);
+}
+
+// Compares the coefficients of the splines of order 2r-1 to the reference, the container order may be higher.
+template <typename Container>
+void expectMinimumDerivativeReference(const Container& container, const Eigen::VectorXd& reference, int r,
+                                      double tolerance) {
+  const int numCoefficients = 2 * r;
+  const int splineCoefficients = container.getSplines().front().getCoefficients().size();
+  ASSERT_EQ(static_cast<size_t>(reference.size() / numCoefficients), container.getSplines().size());
+  for (size_t splineId = 0; splineId < container.getSplines().size(); ++splineId) {
+    const auto& coefficients = container.getSplines()[splineId].getCoefficients();
+    for (int i = 0; i < splineCoefficients - numCoefficients; ++i) {
+      EXPECT_EQ(0.0, coefficients[i]);
+    }
+    for (int i = 0; i < numCoefficients; ++i) {
+      EXPECT_NEAR(reference(numCoefficients * splineId + i), coefficients[splineCoefficients - numCoefficients + i],
+                  tolerance) << splineId << " " << i;
+    }
+  }
+}
+
+} // namespace
+
+TEST(PolynomialSplineContainer, minimumJerk) {
+  const std::vector<double> knotDurations = {0.0, 0.4, 0.7, 1.5, 1.8, 2.5};
+  const std::vector<double> knotPositions = {0.0, 0.6, 0.2, -0.4, 0.3, 1.0};
+  const std::vector<double> initialDerivatives = {0.5, -1.0};
+  const std::vector<double> finalDerivatives = {0.0, 0.2};
+  const int numSplines = knotDurations.size() - 1;
+
+  curves::PolynomialSplineContainerQuintic polyContainer;
+  ASSERT_TRUE(polyContainer.setDataMinimumDerivative(knotDurations, knotPositions, 3,
+                                                     initialDerivatives, finalDerivatives));
+  expectMinimumDerivativeReference(
+      polyContainer, minimumDerivativeReference(knotDurations, knotPositions, 3, initialDerivatives, finalDerivatives),
+      3, 1e-6);
+  EXPECT_NEAR(0.5, polyContainer.getVelocityAtTime(0.0), 1e-9);
+  EXPECT_NEAR(0.2, polyContainer.getAccelerationAtTime(2.5), 1e-9);
+
+  // Free boundary derivatives, the accelerations at both ends are left to the optimization.
+  ASSERT_TRUE(polyContainer.setDataMinimumDerivative(knotDurations, knotPositions, 3, {0.5}, {0.0}));
+  expectMinimumDerivativeReference(
+      polyContainer, minimumDerivativeReference(knotDurations, knotPositions, 3, {0.5}, {0.0}), 3, 1e-6);
+  EXPECT_NEAR(0.0, polyContainer.getSplines().front().getCoefficients()[2], 1e-9);
+
+  // Minimum snap needs septic splines, minimum acceleration works with cubic ones.
+  EXPECT_FALSE(polyContainer.setDataMinimumDerivative(knotDurations, knotPositions, 4));
+  curves::PolynomialSplineContainerCubic cubicContainer;
+  ASSERT_TRUE(cubicContainer.setDataMinimumDerivative(knotDurations, knotPositions, 2, {0.5}, {0.0}));
+  expectMinimumDerivativeReference(
+      cubicContainer, minimumDerivativeReference(knotDurations, knotPositions, 2, {0.5}, {0.0}), 2, 1e-6);
+  const double eps = 1e-9;
+  for (int knotId = 1; knotId < numSplines; ++knotId) {
+    const double t = knotDurations[knotId];
+    EXPECT_NEAR(knotPositions[knotId], cubicContainer.getPositionAtTime(t), 1e-12);
+    EXPECT_NEAR(cubicContainer.getAccelerationAtTime(t - eps), cubicContainer.getAccelerationAtTime(t + eps), 1e-6);
+  }
+
+  // Without boundary derivatives these are natural cubic splines, zero acceleration at both ends.
+  ASSERT_TRUE(cubicContainer.setDataMinimumDerivative(knotDurations, knotPositions, 2));
+  EXPECT_NEAR(0.0, cubicContainer.getAccelerationAtTime(0.0), 1e-9);
+  EXPECT_NEAR(0.0, cubicContainer.getAccelerationAtTime(2.5), 1e-9);
+}
+
+TEST(PolynomialSplineContainer, minimumSnap) {
+  const std::vector<double> knotDurations = {0.0, 0.4, 0.7, 1.5, 1.8, 2.5};
+  const std::vector<double> knotPositions = {0.0, 0.6, 0.2, -0.4, 0.3, 1.0};
+  const std::vector<double> initialDerivatives = {0.5, -1.0, 0.3};
+  const std::vector<double> finalDerivatives = {0.0, 0.2, -0.1};
+
+  curves::PolynomialSplineContainerSeptic polyContainer;
+  ASSERT_TRUE(polyContainer.setDataMinimumDerivative(knotDurations, knotPositions, 4,
+                                                     initialDerivatives, finalDerivatives));
+  expectMinimumDerivativeReference(
+      polyContainer, minimumDerivativeReference(knotDurations, knotPositions, 4, initialDerivatives, finalDerivatives),
+      4, 1e-6);
+  EXPECT_NEAR(0.5, polyContainer.getVelocityAtTime(0.0), 1e-9);
+  EXPECT_NEAR(0.2, polyContainer.getAccelerationAtTime(2.5), 1e-9);
+
+  // Rest at the start, free derivatives at the end.
+  ASSERT_TRUE(polyContainer.setDataMinimumDerivative(knotDurations, knotPositions, 4, {0.0, 0.0, 0.0}));
+  expectMinimumDerivativeReference(
+      polyContainer, minimumDerivativeReference(knotDurations, knotPositions, 4, {0.0, 0.0, 0.0}, {}), 4, 1e-6);
+  for (size_t knotId = 0; knotId < knotDurations.size(); ++knotId) {
+    EXPECT_NEAR(knotPositions[knotId], polyContainer.getPositionAtTime(knotDurations[knotId]), 1e-9);
+  }
+
+  // Minimum jerk on septic splines, the highest coefficients are zero.
+  ASSERT_TRUE(polyContainer.setDataMinimumDerivative(knotDurations, knotPositions, 3, {0.5}, {0.0, 0.2}));
+  expectMinimumDerivativeReference(
+      polyContainer, minimumDerivativeReference(knotDurations, knotPositions, 3, {0.5}, {0.0, 0.2}), 3, 1e-6);
+}
+
+TEST(PolynomialSplineContainer, deferredSolve) {
+  const std::vector<double> knotDurations = {0.0, 0.3, 0.8, 1.0};
+  const std::vector<std::vector<double>> candidates = {
+      {0.0, 0.1, 0.3, 0.2}, {0.2, -0.1, 0.4, 0.0}, {0.0, 0.5, 0.1, -0.3}};
+
+  curves::PolynomialSplineContainerQuintic deferred;
+  deferred.setDeferredSolve(true);
+  ASSERT_TRUE(deferred.isSolveDeferred());
+
+  // Rejected candidates are only recorded.
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    ASSERT_TRUE(deferred.setData(knotDurations, candidates[i], 0.1, 0.0, -0.2, 0.3));
+    EXPECT_TRUE(deferred.hasPendingSolve());
+  }
+  EXPECT_EQ(0u, deferred.getFactorizationCacheMisses());
+
+  // The first evaluation solves the last candidate.
+  curves::PolynomialSplineContainerQuintic immediate;
+  ASSERT_TRUE(immediate.setData(knotDurations, candidates.back(), 0.1, 0.0, -0.2, 0.3));
+  EXPECT_NEAR(immediate.getPositionAtTime(0.6), deferred.getPositionAtTime(0.6), 1e-12);
+  EXPECT_FALSE(deferred.hasPendingSolve());
+  EXPECT_EQ(1u, deferred.getFactorizationCacheMisses());
+  EXPECT_EQ(immediate.getContainerDuration(), deferred.getContainerDuration());
+  for (double t = 0.0; t <= 1.0; t += 0.05) {
+    EXPECT_NEAR(immediate.getVelocityAtTime(t), deferred.getVelocityAtTime(t), 1e-12);
+  }
+
+  // setContainerTime and getSpline solve as well.
+  ASSERT_TRUE(deferred.setData(knotDurations, candidates[0], 0.1, 0.0, -0.2, 0.3));
+  ASSERT_TRUE(deferred.setContainerTime(0.5));
+  EXPECT_FALSE(deferred.hasPendingSolve());
+  ASSERT_TRUE(immediate.setData(knotDurations, candidates[0], 0.1, 0.0, -0.2, 0.3));
+  EXPECT_NEAR(immediate.getPositionAtTime(0.5), deferred.getPosition(), 1e-12);
+  ASSERT_TRUE(deferred.setData(knotDurations, candidates[2], 0.1, 0.0, -0.2, 0.3));
+  ASSERT_NE(nullptr, deferred.getSpline(1));
+  EXPECT_NEAR(candidates[2][1], deferred.getSpline(1)->getPositionAtTime(0.0), 1e-12);
+
+  // Explicit finalize, also for the velocity-only and linear modes.
+  ASSERT_TRUE(deferred.setData(knotDurations, candidates[0], 0.1, -0.2));
+  ASSERT_TRUE(immediate.setData(knotDurations, candidates[0], 0.1, -0.2));
+  ASSERT_TRUE(deferred.finalize());
+  EXPECT_FALSE(deferred.hasPendingSolve());
+  EXPECT_TRUE(deferred.isSolveDeferred());
+  EXPECT_NEAR(immediate.getAccelerationAtTime(0.4), deferred.getAccelerationAtTime(0.4), 1e-9);
+  ASSERT_TRUE(deferred.setData(knotDurations, candidates[1]));
+  ASSERT_TRUE(deferred.finalize());
+  ASSERT_EQ(3u, deferred.getSplines().size());
+  EXPECT_NEAR(candidates[1][2], deferred.getPositionAtTime(0.8), 1e-12);
+
+  // The non-const advance finalizes on its own.
+  ASSERT_TRUE(deferred.setData(knotDurations, candidates[0], 0.1, -0.2));
+  ASSERT_TRUE(deferred.advance(0.4));
+  EXPECT_FALSE(deferred.hasPendingSolve());
+  EXPECT_NEAR(immediate.getPositionAtTime(0.4), deferred.getPosition(), 1e-9);
+
+  // Knots which can never be solved are rejected when recorded.
+  EXPECT_FALSE(deferred.setData({0.0, 0.5, 0.5, 1.0}, candidates[1], 0.0, 0.0, 0.0, 0.0));
+  EXPECT_FALSE(deferred.setData(knotDurations, {0.0, 0.1}));
+  EXPECT_FALSE(deferred.setData({0.0}, {0.0}, 0.0, 0.0));
+  EXPECT_FALSE(deferred.hasPendingSolve());
+
+  // Other modes and reset drop the pending data.
+  ASSERT_TRUE(deferred.setData(knotDurations, candidates[1], 0.0, 0.0, 0.0, 0.0));
+  ASSERT_TRUE(deferred.setDataHermite(knotDurations, candidates[2], {0.0, 0.0, 0.0, 0.0}));
+  EXPECT_FALSE(deferred.hasPendingSolve());
+  EXPECT_NEAR(candidates[2][1], deferred.getPositionAtTime(0.3), 1e-12);
+  ASSERT_TRUE(deferred.setData(knotDurations, candidates[1], 0.0, 0.0, 0.0, 0.0));
+  ASSERT_TRUE(deferred.reset());
+  EXPECT_TRUE(deferred.isEmpty());
+}
@@ -8,6 +8,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <random>
+
 #include "curves/PolynomialSplineScalarCurve.hpp"
 
 using namespace curves;
@@ -169,3 +172,32 @@ TEST(PolynomialSplineQuinticScalarCurveTest, invarianceUnderOffset)
     EXPECT_NEAR(value1, value2 - offset, 1.0e-7);
   }
 }
+
+TEST(PolynomialSplineQuinticScalarCurveTest, smoothingGcv)
+{
+  std::mt19937 generator(42);
+  std::vector<Time> times;
+  std::vector<ValueType> values, trueValues;
+  for (int i = 0; i < 200; ++i) {
+    times.push_back(1.0 + 0.01 * i);
+    trueValues.push_back(std::sin(3.0 * times.back()));
+    const double noise = 0.2 * (static_cast<double>(generator()) / generator.max() - 0.5);
+    values.push_back(trueValues.back() + noise);
+  }
+
+  PolynomialSplineQuinticScalarCurve interpolating, smoothing;
+  interpolating.fitCurve(times, values);
+  ASSERT_TRUE(smoothing.fitSmoothingCurve(times, values));
+  EXPECT_NEAR(1.0, smoothing.getMinTime(), 1e-12);
+  EXPECT_NEAR(2.99, smoothing.getMaxTime(), 1e-9);
+
+  double interpolatingError = 0.0, smoothingError = 0.0;
+  for (size_t i = 0; i < times.size(); ++i) {
+    ValueType value;
+    ASSERT_TRUE(interpolating.evaluate(value, times[i]));
+    interpolatingError += (value - trueValues[i]) * (value - trueValues[i]);
+    ASSERT_TRUE(smoothing.evaluate(value, times[i]));
+    smoothingError += (value - trueValues[i]) * (value - trueValues[i]);
+  }
+  EXPECT_LT(smoothingError, 0.2 * interpolatingError);
+}
@@ -10,10 +10,14 @@
 
 // curves
 #include "curves/polynomial_splines.hpp"
+#include "curves/PolynomialSplineContainer.hpp"
 
 // random number generation
 #include <random>
 
+// stl
+#include <type_traits>
+
 
 // Construct a random number generator
 std::random_device randomDevice;
@@ -59,3 +63,124 @@ TEST(PolynomialSplines, PolynomialSplinesQuintic)
   EXPECT_NEAR(spline.getAccelerationAtTime(0.0), opts.acc0_, 1e-5);
   EXPECT_NEAR(spline.getAccelerationAtTime(opts.tf_), opts.accT_, 1e-5);
 }
+
+TEST(PolynomialSplines, PolynomialSplinesQuinticFloat)
+{
+  curves::PolynomialSplineQuintic spline;
+  curves::PolynomialSpline<5, float> splineFloat;
+
+  curves::SplineOptions opts(1.0 + std::abs(uniformDistribution(randomEngine)) / 10.0,
+                             uniformDistribution(randomEngine), uniformDistribution(randomEngine),
+                             uniformDistribution(randomEngine), uniformDistribution(randomEngine),
+                             uniformDistribution(randomEngine), uniformDistribution(randomEngine));
+
+  spline.computeCoefficients(opts);
+  splineFloat.computeCoefficients(opts);
+
+  for (double t = 0.0; t <= opts.tf_; t += 0.1) {
+    const float tf = static_cast<float>(t);
+    EXPECT_NEAR(spline.getPositionAtTime(t), splineFloat.getPositionAtTime(tf), 1e-2);
+    EXPECT_NEAR(spline.getVelocityAtTime(t), splineFloat.getVelocityAtTime(tf), 1e-2);
+    EXPECT_NEAR(spline.getAccelerationAtTime(t), splineFloat.getAccelerationAtTime(tf), 1e-1);
+  }
+}
+
+TEST(PolynomialSplines, GenericTimeVectors)
+{
+  using Rep = curves::spline_traits::spline_rep<double, 7>;
+  static_assert(Rep::derivativeFactor(0, 0) == 1.0, "t^7");
+  static_assert(Rep::derivativeFactor(3, 0) == 210.0, "7*6*5");
+  static_assert(Rep::derivativeFactor(4, 3) == 24.0, "4!");
+  static_assert(Rep::derivativeFactor(5, 3) == 0.0, "fifth derivative of t^4");
+  constexpr Rep::TimeVectorType septicDdtau = Rep::dktau<2>(2.0);
+  constexpr Rep::TimeVectorType dddtauZero = Rep::dktauZero<3>();
+  EXPECT_EQ(12.0, septicDdtau[4]);
+  EXPECT_EQ(6.0, dddtauZero[4]);
+  EXPECT_EQ(0.0, dddtauZero[3]);
+
+  // The generic tables agree with the closed form of the cubic.
+  const double t = 0.7;
+  using Cubic = curves::spline_traits::spline_rep<double, 3>;
+  const Cubic::TimeVectorType tau{{ t*t*t, t*t, t, 1.0 }};
+  const Cubic::TimeVectorType dtau{{ 3.0*t*t, 2.0*t, 1.0, 0.0 }};
+  const Cubic::TimeVectorType ddtau{{ 6.0*t, 2.0, 0.0, 0.0 }};
+  const Cubic::TimeVectorType ddtauZero{{ 0.0, 2.0, 0.0, 0.0 }};
+  EXPECT_EQ(tau, Cubic::tau(t));
+  EXPECT_EQ(dtau, Cubic::dtau(t));
+  EXPECT_EQ(ddtau, Cubic::ddtau(t));
+  EXPECT_EQ(ddtauZero, Cubic::ddtauZero());
+
+  // Higher orders match the boundary conditions and zero the higher derivatives at the ends.
+  curves::PolynomialSpline<7> spline;
+  curves::SplineOptions opts(1.5, 0.2, -1.0, 0.5, 0.3, -2.0, 1.0);
+  ASSERT_TRUE(spline.computeCoefficients(opts));
+  EXPECT_NEAR(opts.pos0_, spline.getPositionAtTime(0.0), 1e-9);
+  EXPECT_NEAR(opts.vel0_, spline.getVelocityAtTime(0.0), 1e-9);
+  EXPECT_NEAR(opts.acc0_, spline.getAccelerationAtTime(0.0), 1e-9);
+  EXPECT_NEAR(0.0, spline.getDerivativeAtTime<3>(0.0), 1e-9);
+  EXPECT_NEAR(opts.posT_, spline.getPositionAtTime(opts.tf_), 1e-9);
+  EXPECT_NEAR(opts.velT_, spline.getVelocityAtTime(opts.tf_), 1e-9);
+  EXPECT_NEAR(opts.accT_, spline.getAccelerationAtTime(opts.tf_), 1e-9);
+  EXPECT_NEAR(0.0, spline.getDerivativeAtTime<3>(opts.tf_), 1e-9);
+  EXPECT_EQ(0.0, spline.getDerivativeAtTime<8>(0.3));
+
+  const double h = 1e-5;
+  EXPECT_NEAR((spline.getDerivativeAtTime<3>(t+h) - spline.getDerivativeAtTime<3>(t-h)) / (2.0*h),
+              spline.getDerivativeAtTime<4>(t), 1e-4);
+}
+
+TEST(PolynomialSplines, CompactLayout)
+{
+  using Quintic = curves::PolynomialSplineQuintic;
+  using QuinticFloat = curves::PolynomialSpline<5, float>;
+  static_assert(std::is_trivially_copyable<Quintic>::value, "splines are copied with memcpy");
+  static_assert(std::is_standard_layout<Quintic>::value, "splines are standard layout");
+  static_assert(!std::is_polymorphic<Quintic>::value, "splines have no vtable");
+  static_assert(sizeof(Quintic) == 7 * sizeof(double), "six coefficients and the duration");
+  static_assert(sizeof(QuinticFloat) == 7 * sizeof(float), "six coefficients and the duration");
+  static_assert(sizeof(curves::PolynomialSplineCubic) == 5 * sizeof(double), "four coefficients and the duration");
+
+  curves::PolynomialSplineContainer<5> container;
+  ASSERT_TRUE(container.setData({0.0, 0.5, 1.0}, {0.0, 1.0, -1.0}, 0.0, 0.0, 0.0, 0.0));
+  const curves::PolynomialSplineContainer<5>::SplineList& splines = container.getSplines();
+  ASSERT_EQ(2u, splines.size());
+  EXPECT_EQ(reinterpret_cast<const char*>(&splines[0]) + sizeof(Quintic), reinterpret_cast<const char*>(&splines[1]));
+}
+
+template<int splineOrder, unsigned int k>
+void expectKernelsMatchTimeVector() {
+  using Rep = curves::spline_traits::spline_rep<double, splineOrder>;
+  typename Rep::SplineCoefficients coefficients;
+  for (auto& coefficient : coefficients) {
+    coefficient = uniformDistribution(randomEngine);
+  }
+  for (double t = -1.0; t <= 2.0; t += 0.125) {
+    const typename Rep::TimeVectorType timeVector = Rep::template dktau<k>(t);
+    double expected = 0.0;
+    for (unsigned int i = 0; i < Rep::numCoefficients; ++i) {
+      expected += coefficients[i] * timeVector[i];
+    }
+    const double tolerance = 1e-12 * (1.0 + std::abs(expected)) * Rep::numCoefficients * 100.0;
+    EXPECT_NEAR(expected, Rep::template evaluateHorner<k>(coefficients, t), tolerance) << splineOrder << " " << k;
+    EXPECT_NEAR(expected, Rep::template evaluateEstrin<k>(coefficients, t), tolerance) << splineOrder << " " << k;
+  }
+}
+
+template<int splineOrder>
+void expectKernelsMatchTimeVector() {
+  expectKernelsMatchTimeVector<splineOrder, 0>();
+  expectKernelsMatchTimeVector<splineOrder, 1>();
+  expectKernelsMatchTimeVector<splineOrder, 2>();
+  expectKernelsMatchTimeVector<splineOrder, 3>();
+}
+
+TEST(PolynomialSplines, EvaluationKernels)
+{
+  expectKernelsMatchTimeVector<1>();
+  expectKernelsMatchTimeVector<2>();
+  expectKernelsMatchTimeVector<3>();
+  expectKernelsMatchTimeVector<4>();
+  expectKernelsMatchTimeVector<5>();
+  expectKernelsMatchTimeVector<6>();
+  expectKernelsMatchTimeVector<7>();
+}
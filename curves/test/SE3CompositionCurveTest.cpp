@@ -0,0 +1,197 @@
+/*
+ * SE3CompositionCurveTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "curves/SlerpSE3Curve.hpp"
+
+using namespace curves;
+
+typedef SE3CompositionCurve<SlerpSE3Curve, SlerpSE3Curve> CompositionCurve;
+typedef CompositionCurve::ValueType ValueType;
+
+namespace {
+
+ValueType makePose(double t) {
+  const Eigen::Quaterniond q(Eigen::AngleAxisd(0.8 * t, Eigen::Vector3d(1.0, 2.0, 3.0).normalized()));
+  return ValueType(ValueType::Position(std::sin(t), std::cos(t), 0.5 * t),
+                   ValueType::Rotation(q.w(), q.x(), q.y(), q.z()));
+}
+
+void expectNear(const ValueType& expected, const ValueType& actual, double tol, Time time) {
+  EXPECT_TRUE(expected.getPosition().toImplementation().isApprox(actual.getPosition().toImplementation(), tol))
+      << "time " << time;
+  const Eigen::Quaterniond qExpected = expected.getRotation().toImplementation();
+  const Eigen::Quaterniond qActual = actual.getRotation().toImplementation();
+  EXPECT_NEAR(1.0, std::abs(qExpected.dot(qActual)), tol) << "time " << time;
+}
+
+// Builds a composition curve with a correction knot every third base knot and
+// non-identity corrections, together with reference base and correction curves.
+void makeCurves(CompositionCurve* curve, SlerpSE3Curve* base, SlerpSE3Curve* correction) {
+  curve->setSamplingRatio(3);
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  for (int i = 0; i < 20; ++i) {
+    times.push_back(0.1 * i);
+    values.push_back(makePose(0.1 * i));
+    curve->extend(std::vector<Time>(1, times.back()), std::vector<ValueType>(1, values.back()));
+  }
+  base->fitCurve(times, values);
+
+  std::vector<Time> correctionTimes;
+  std::vector<ValueType> correctionValues;
+  curve->getCurveTimes(&correctionTimes);
+  for (size_t i = 0; i < correctionTimes.size(); ++i) {
+    const Eigen::Quaterniond q(Eigen::AngleAxisd(0.05 * i, Eigen::Vector3d::UnitZ()));
+    correctionValues.push_back(ValueType(ValueType::Position(0.01 * i, -0.02 * i, 0.0),
+                                         ValueType::Rotation(q.w(), q.x(), q.y(), q.z())));
+    curve->setCorrectionCoefficientAtTime(correctionTimes[i], correctionValues.back());
+  }
+  correction->fitCurve(correctionTimes, correctionValues);
+}
+
+} // namespace
+
+TEST(SE3CompositionCurve, EvaluateMatchesComposition)
+{
+  CompositionCurve curve;
+  SlerpSE3Curve base, correction;
+  makeCurves(&curve, &base, &correction);
+  ASSERT_LT(curve.correctionSize(), curve.baseSize());
+
+  std::vector<Time> times;
+  curve.getBaseCurveTimes(&times);
+#if COMPOSITION_STRATEGY == 1
+  // corr(t) * base(t) holds everywhere, not only at the base knots.
+  for (Time t = curve.getMinTime(); t < curve.getMaxTime(); t += 0.013) {
+    times.push_back(t);
+  }
+#endif
+  for (size_t i = 0; i < times.size(); ++i) {
+    ValueType value, baseValue, correctionValue;
+    ASSERT_TRUE(curve.evaluate(value, times[i]));
+    ASSERT_TRUE(base.evaluate(baseValue, times[i]));
+    ASSERT_TRUE(correction.evaluate(correctionValue, times[i]));
+    expectNear(correctionValue * baseValue, value, 1e-9, times[i]);
+  }
+}
+
+TEST(SE3CompositionCurve, BatchMatchesSingle)
+{
+  CompositionCurve curve;
+  SlerpSE3Curve base, correction;
+  makeCurves(&curve, &base, &correction);
+
+  std::vector<Time> times;
+  curve.getBaseCurveTimes(&times);
+  for (Time t = curve.getMinTime(); t < curve.getMaxTime(); t += 0.007) {
+    times.push_back(t);
+  }
+  std::sort(times.begin(), times.end());
+  std::vector<Time> shuffled(times.rbegin(), times.rend());
+  std::rotate(shuffled.begin(), shuffled.begin() + shuffled.size() / 3, shuffled.end());
+
+  std::vector<ValueType> sortedValues, shuffledValues;
+  ASSERT_TRUE(curve.evaluate(times, &sortedValues));
+  ASSERT_TRUE(curve.evaluate(shuffled, &shuffledValues));
+  ASSERT_EQ(times.size(), sortedValues.size());
+  ASSERT_EQ(shuffled.size(), shuffledValues.size());
+  for (size_t i = 0; i < times.size(); ++i) {
+    ValueType value;
+    ASSERT_TRUE(curve.evaluate(value, times[i]));
+    expectNear(value, sortedValues[i], 1e-12, times[i]);
+    ASSERT_TRUE(curve.evaluate(value, shuffled[i]));
+    expectNear(value, shuffledValues[i], 1e-12, shuffled[i]);
+  }
+
+  ValueType value;
+  std::vector<ValueType> values;
+  EXPECT_FALSE(curve.evaluate(value, curve.getMaxTime() + 0.1));
+  EXPECT_FALSE(curve.evaluate(std::vector<Time>(1, curve.getMinTime() - 0.1), &values));
+}
+
+TEST(SE3CompositionCurve, FoldInCorrectionsWindow)
+{
+  CompositionCurve curve;
+  SlerpSE3Curve base, correction;
+  makeCurves(&curve, &base, &correction);
+
+  std::vector<Time> baseTimes, correctionTimes;
+  curve.getBaseCurveTimes(&baseTimes);
+  curve.getCurveTimes(&correctionTimes);
+  std::vector<ValueType> composedValues;
+  ASSERT_TRUE(curve.evaluate(baseTimes, &composedValues));
+
+  // Fold an interior window, the curve only changes between the correction knots around it.
+  ASSERT_LE(6u, correctionTimes.size());
+  {
+    CompositionCurve interior;
+    makeCurves(&interior, &base, &correction);
+    interior.foldInCorrections(correctionTimes[2] - 0.01, correctionTimes[3]);
+    std::vector<Time> times;
+    interior.getBaseCurveTimes(&times);
+    ASSERT_EQ(baseTimes, times);
+    interior.getCurveTimes(&times);
+    ASSERT_EQ(correctionTimes, times);
+    ValueType value, expected;
+    for (size_t i = 0; i < baseTimes.size(); ++i) {
+      ASSERT_TRUE(interior.evaluate(value, baseTimes[i]));
+      expectNear(composedValues[i], value, 1e-9, baseTimes[i]);
+    }
+    for (Time t = curve.getMinTime(); t < curve.getMaxTime(); t += 0.013) {
+      if (t > correctionTimes[1] && t < correctionTimes[4]) {
+        continue;
+      }
+      ASSERT_TRUE(interior.evaluate(value, t));
+      ASSERT_TRUE(curve.evaluate(expected, t));
+      expectNear(expected, value, 1e-12, t);
+    }
+  }
+
+  // Fold the last correction knots, the earlier corrections are kept.
+  const Time begTime = correctionTimes[correctionTimes.size() - 3];
+  curve.foldInCorrections(begTime, curve.getMaxTime());
+  std::vector<Time> times;
+  curve.getBaseCurveTimes(&times);
+  ASSERT_EQ(baseTimes, times);
+  curve.getCurveTimes(&times);
+  ASSERT_EQ(correctionTimes, times);
+  ValueType value;
+  for (size_t i = 0; i < baseTimes.size(); ++i) {
+    ASSERT_TRUE(curve.evaluate(value, baseTimes[i]));
+    expectNear(composedValues[i], value, 1e-9, baseTimes[i]);
+  }
+
+#if COMPOSITION_STRATEGY == 1
+  // The correction is identity from the window on, and everywhere after a full fold.
+  SlerpSE3Curve folded;
+  folded.fitCurve(baseTimes, composedValues);
+  ValueType foldedValue;
+  for (Time t = begTime; t < curve.getMaxTime(); t += 0.013) {
+    ASSERT_TRUE(curve.evaluate(value, t));
+    ASSERT_TRUE(folded.evaluate(foldedValue, t));
+    expectNear(foldedValue, value, 1e-9, t);
+  }
+  curve.foldInCorrections();
+  for (Time t = curve.getMinTime(); t < curve.getMaxTime(); t += 0.013) {
+    ASSERT_TRUE(curve.evaluate(value, t));
+    ASSERT_TRUE(folded.evaluate(foldedValue, t));
+    expectNear(foldedValue, value, 1e-9, t);
+  }
+#else
+  curve.foldInCorrections();
+  for (size_t i = 0; i < baseTimes.size(); ++i) {
+    ASSERT_TRUE(curve.evaluate(value, baseTimes[i]));
+    expectNear(composedValues[i], value, 1e-9, baseTimes[i]);
+  }
+#endif
+}
@@ -0,0 +1,176 @@
+/*
+ * SlerpSE3CurveTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "curves/SlerpSE3Curve.hpp"
+#include "curves/cubic_hermite_kernels.hpp"
+
+using namespace curves;
+
+typedef SlerpSE3Curve::ValueType ValueType;
+typedef SlerpSE3Curve::DerivativeType DerivativeType;
+
+namespace {
+
+ValueType makePose(double t) {
+  const Eigen::Quaterniond q(Eigen::AngleAxisd(1.3 * t, Eigen::Vector3d(1.0, -2.0, 0.5).normalized()));
+  return ValueType(ValueType::Position(std::sin(t), 2.0 * std::cos(t), t * t),
+                   ValueType::Rotation(q.w(), q.x(), q.y(), q.z()));
+}
+
+void makeCurve(SlerpSE3Curve* curve, std::vector<Time>* times, std::vector<ValueType>* values) {
+  for (int i = 0; i < 12; ++i) {
+    times->push_back(0.25 * i + 0.05 * (i % 2));
+    values->push_back(makePose(times->back()));
+  }
+  curve->fitCurve(*times, *values);
+}
+
+Eigen::Quaterniond getQuaternion(const ValueType& value) {
+  return value.getRotation().toImplementation();
+}
+
+} // namespace
+
+TEST(SlerpSE3Curve, Interpolation)
+{
+  SlerpSE3Curve curve;
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  makeCurve(&curve, &times, &values);
+
+  ValueType value;
+  for (size_t i = 0; i < times.size(); ++i) {
+    ASSERT_TRUE(curve.evaluate(value, times[i]));
+    EXPECT_TRUE(value.getPosition().toImplementation().isApprox(values[i].getPosition().toImplementation(), 1e-12));
+    EXPECT_NEAR(1.0, std::abs(getQuaternion(value).dot(getQuaternion(values[i]))), 1e-12);
+  }
+
+  // Linear in position, geodesic in rotation.
+  for (size_t i = 0; i + 1 < times.size(); ++i) {
+    const Time time = 0.7 * times[i] + 0.3 * times[i + 1];
+    ASSERT_TRUE(curve.evaluate(value, time));
+    const Eigen::Vector3d position = 0.7 * values[i].getPosition().toImplementation()
+        + 0.3 * values[i + 1].getPosition().toImplementation();
+    const Eigen::Quaterniond rotation = getQuaternion(values[i]).slerp(0.3, getQuaternion(values[i + 1]));
+    EXPECT_TRUE(value.getPosition().toImplementation().isApprox(position, 1e-12));
+    EXPECT_NEAR(1.0, std::abs(getQuaternion(value).dot(rotation)), 1e-12);
+  }
+
+  EXPECT_FALSE(curve.evaluate(value, times.back() + 0.1));
+  EXPECT_FALSE(curve.evaluate(value, times.front() - 0.1));
+}
+
+TEST(SlerpSE3Curve, DerivativeMatchesFiniteDifferences)
+{
+  SlerpSE3Curve curve;
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  makeCurve(&curve, &times, &values);
+
+  const double h = 1e-6;
+  ValueType value0, value1;
+  DerivativeType derivative;
+  for (Time t = times.front(); t + h < times.back(); t += 0.037) {
+    ASSERT_TRUE(curve.evaluate(value0, t));
+    ASSERT_TRUE(curve.evaluate(value1, t + h));
+    ASSERT_TRUE(curve.evaluateDerivative(derivative, t, 1));
+    const Eigen::Vector3d linearVelocity = (value1.getPosition().toImplementation()
+        - value0.getPosition().toImplementation()) / h;
+    // Angular velocity in the world frame.
+    const Eigen::Vector3d angularVelocity = hermite_kernels::quaternionLog<double>(
+        getQuaternion(value1) * getQuaternion(value0).conjugate()) / h;
+    EXPECT_TRUE(derivative.getTranslationalVelocity().toImplementation().isApprox(linearVelocity, 1e-5)) << t;
+    EXPECT_TRUE(derivative.getRotationalVelocity().toImplementation().isApprox(angularVelocity, 1e-5)) << t;
+  }
+
+  ASSERT_TRUE(curve.evaluateDerivative(derivative, times[3], 2));
+  EXPECT_EQ(0.0, derivative.getVector().norm());
+  EXPECT_FALSE(curve.evaluateDerivative(derivative, times.back() + 0.1, 1));
+}
+
+TEST(SlerpSE3Curve, BatchMatchesSingle)
+{
+  SlerpSE3Curve curve;
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  makeCurve(&curve, &times, &values);
+
+  std::vector<Time> sampleTimes(times);
+  for (Time t = times.front(); t < times.back(); t += 0.011) {
+    sampleTimes.push_back(t);
+  }
+  std::sort(sampleTimes.begin(), sampleTimes.end());
+  std::vector<Time> shuffled(sampleTimes.rbegin(), sampleTimes.rend());
+  std::rotate(shuffled.begin(), shuffled.begin() + shuffled.size() / 3, shuffled.end());
+
+  for (int pass = 0; pass < 2; ++pass) {
+    const std::vector<Time>& batchTimes = (pass == 0) ? sampleTimes : shuffled;
+    std::vector<ValueType> batchValues;
+    std::vector<DerivativeType> batchDerivatives;
+    ASSERT_TRUE(curve.evaluate(batchTimes, &batchValues));
+    ASSERT_TRUE(curve.evaluateDerivative(batchTimes, 1, &batchDerivatives));
+    ASSERT_EQ(batchTimes.size(), batchValues.size());
+    ASSERT_EQ(batchTimes.size(), batchDerivatives.size());
+    ValueType value;
+    DerivativeType derivative;
+    for (size_t i = 0; i < batchTimes.size(); ++i) {
+      ASSERT_TRUE(curve.evaluate(value, batchTimes[i]));
+      ASSERT_TRUE(curve.evaluateDerivative(derivative, batchTimes[i], 1));
+      EXPECT_EQ(value.getPosition().toImplementation(), batchValues[i].getPosition().toImplementation());
+      EXPECT_EQ(getQuaternion(value).coeffs(), getQuaternion(batchValues[i]).coeffs());
+      EXPECT_EQ(derivative.getVector(), batchDerivatives[i].getVector());
+    }
+  }
+
+  std::vector<ValueType> batchValues;
+  EXPECT_FALSE(curve.evaluate(std::vector<Time>(1, times.back() + 0.1), &batchValues));
+}
+
+TEST(SlerpSE3Curve, ValueExpression)
+{
+  std::vector<Time> times;
+  std::vector<ValueType> values;
+  for (int i = 0; i < 6; ++i) {
+    times.push_back(0.5 * i);
+    values.push_back(makePose(times.back()));
+  }
+  SlerpSE3Curve curve;
+  std::vector<Key> keys;
+  curve.fitCurve(times, values, &keys);
+  ASSERT_EQ(times.size(), keys.size());
+
+  const Time time = 1.2;
+  const CoefficientExpression<ValueType> expression = curve.getValueExpression(time);
+  ASSERT_EQ(2u, expression.keys().size());
+  EXPECT_EQ(keys[2], expression.keys()[0]);
+  EXPECT_EQ(keys[3], expression.keys()[1]);
+
+  CoefficientExpression<ValueType>::CoefficientMap coefficients;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    coefficients[keys[i]] = values[i];
+  }
+  ValueType value;
+  ASSERT_TRUE(curve.evaluate(value, time));
+  ValueType expressionValue = expression.value(coefficients);
+  EXPECT_TRUE(value.getPosition().toImplementation().isApprox(expressionValue.getPosition().toImplementation(), 1e-12));
+  EXPECT_NEAR(1.0, std::abs(getQuaternion(value).dot(getQuaternion(expressionValue))), 1e-12);
+
+  // The expression follows updated coefficients.
+  values[3] = makePose(4.0);
+  coefficients[keys[3]] = values[3];
+  curve.fitCurve(times, values);
+  ASSERT_TRUE(curve.evaluate(value, time));
+  expressionValue = expression.value(coefficients);
+  EXPECT_TRUE(value.getPosition().toImplementation().isApprox(expressionValue.getPosition().toImplementation(), 1e-12));
+  EXPECT_NEAR(1.0, std::abs(getQuaternion(value).dot(getQuaternion(expressionValue))), 1e-12);
+}
@@ -36,15 +36,26 @@ bool RosJointTrajectoryInterface::fromMessage(const trajectory_msgs::JointTrajec
 
   std::vector<Time> times;
   std::vector<PolynomialSplineQuinticScalarCurve::ValueType> values;
+  std::vector<PolynomialSplineQuinticScalarCurve::DerivativeType> velocities, accelerations;
+  bool hasDerivatives = true;
 
   for (const auto& point : message.points) {
     times.push_back(ros::Duration(point.time_from_start).toSec());
     values.push_back(point.positions[j]);
+    if (point.velocities.size() > j && point.accelerations.size() > j) {
+      velocities.push_back(point.velocities[j]);
+      accelerations.push_back(point.accelerations[j]);
+    } else {
+      hasDerivatives = false;
+    }
   }
 
-  // TODO Make this work also with velocities and accelerations.
-
-  fitCurve(times, values);
+  // Use the velocities and accelerations if all points have them.
+  if (hasDerivatives) {
+    fitCurve(times, values, velocities, accelerations);
+  } else {
+    fitCurve(times, values);
+  }
 
   return true;
 }